@@ -7,117 +7,168 @@
 */
 
 #include "BuildItem.h"
+#include <deque>
 
 using namespace ProBot;
 
-BuildItem::BuildItem(BWAPI::UnitType unit, int multiplicity, bool persist, std::vector<req_value_pair_t> requirements){
-	_unit = unit;
+/**
+	Returns the interned requirement lists, with the empty list first.
+	A deque is used so that references to the lists stay valid as more are added.
+*/
+static std::deque<std::vector<req_value_pair_t>> & getRequirementLists(){
+	// constructed on first use, since build orders are defined as constants that may be initialized first
+	static std::deque<std::vector<req_value_pair_t>> requirementLists(1);
+	return requirementLists;
+}
+
+req_list_id_t Build::internRequirements(const std::vector<req_value_pair_t> & requirements){
+	if (requirements.empty())
+		return NO_REQUIREMENTS;
+	// there are only ever a handful of different lists
+	std::deque<std::vector<req_value_pair_t>> & lists = getRequirementLists();
+	for (size_t id = 0; id < lists.size(); id++){
+		if (lists[id] == requirements)
+			return static_cast<req_list_id_t>(id);
+	}
+	lists.push_back(requirements);
+	return static_cast<req_list_id_t>(lists.size() - 1);
+}
+
+const std::vector<req_value_pair_t> & Build::getRequirementList(req_list_id_t id){
+	return getRequirementLists()[id];
+}
+
+BuildItem::BuildItem(BWAPI::UnitType unit, int multiplicity, bool persist, const std::vector<req_value_pair_t> & requirements){
+	_id = static_cast<unsigned short>(unit.getID());
 	_type = Build::ItemTypes::UNIT;
 	_multiplicity = multiplicity;
+	_upgradeLevel = 0;
 	_persist = persist;
-	_requirements = requirements;
+	_requirements = Build::internRequirements(requirements);
 	_isFlag = false;
+	_ordered = false;
 }
 
-BuildItem::BuildItem(BWAPI::TechType tech, std::vector<req_value_pair_t> requirements){
-	_tech = tech;
+BuildItem::BuildItem(BWAPI::TechType tech, const std::vector<req_value_pair_t> & requirements){
+	_id = static_cast<unsigned short>(tech.getID());
 	_type = Build::ItemTypes::TECH;
-	_requirements = requirements;
+	_multiplicity = 1;
+	_upgradeLevel = 0;
+	_persist = false;
+	_requirements = Build::internRequirements(requirements);
 	_isFlag = false;
+	_ordered = false;
 }
 
-BuildItem::BuildItem(BWAPI::UpgradeType upgrade, int level, std::vector<req_value_pair_t> requirements){
-	_upgrade = upgrade;
+BuildItem::BuildItem(BWAPI::UpgradeType upgrade, int level, const std::vector<req_value_pair_t> & requirements){
+	_id = static_cast<unsigned short>(upgrade.getID());
 	_type = Build::ItemTypes::UPGRADE;
-	_upgradeLevel = level;
-	_requirements = requirements;
+	_multiplicity = 1;
+	_upgradeLevel = static_cast<unsigned char>(level);
+	_persist = false;
+	_requirements = Build::internRequirements(requirements);
 	_isFlag = false;
+	_ordered = false;
 }
 
-BuildItem::BuildItem(Flag flag, std::vector<req_value_pair_t> requirements){
-	_flag = flag;
+BuildItem::BuildItem(Flag flag, const std::vector<req_value_pair_t> & requirements){
+	_id = static_cast<unsigned short>(flag);
+	_type = Build::ItemTypes::NUM_TYPES;
+	_multiplicity = 1;
+	_upgradeLevel = 0;
+	_persist = false;
+	_requirements = Build::internRequirements(requirements);
 	_isFlag = true;
-	_requirements = requirements;
+	_ordered = true;
 }
 
-int BuildItem::getMineralCost(){
+int BuildItem::getMineralCost() const{
 	switch (_type){
 	case Build::ItemTypes::UNIT:
-		return _unit.mineralPrice();
+		return getUnit().mineralPrice();
 	case Build::ItemTypes::TECH:
-		return _tech.mineralPrice();
+		return getTech().mineralPrice();
 	case Build::ItemTypes::UPGRADE:
-		return _upgrade.mineralPrice(_upgradeLevel);
+		return getUpgrade().mineralPrice(_upgradeLevel);
 	default:
 		return Build::INT_ERROR;
 	}
 }
 
-int BuildItem::getGasCost(){
+int BuildItem::getGasCost() const{
 	switch (_type){
 	case Build::ItemTypes::UNIT:
-		return _unit.gasPrice();
+		return getUnit().gasPrice();
 	case Build::ItemTypes::TECH:
-		return _tech.gasPrice();
+		return getTech().gasPrice();
 	case Build::ItemTypes::UPGRADE:
-		return _upgrade.gasPrice(_upgradeLevel);
+		return getUpgrade().gasPrice(_upgradeLevel);
 	default:
 		return Build::INT_ERROR;
 	}
 }
 
-int BuildItem::getType(){
+int BuildItem::getType() const{
 	return _type;
 }
 
-BWAPI::UnitType BuildItem::getUnit(){
-	return _unit;
+BWAPI::UnitType BuildItem::getUnit() const{
+	return (_type == Build::ItemTypes::UNIT) ? BWAPI::UnitType(_id) : BWAPI::UnitTypes::None;
 }
 
-BWAPI::TechType BuildItem::getTech(){
-	return _tech;
+BWAPI::TechType BuildItem::getTech() const{
+	return (_type == Build::ItemTypes::TECH) ? BWAPI::TechType(_id) : BWAPI::TechTypes::None;
 }
 
-BWAPI::UpgradeType BuildItem::getUpgrade(){
-	return _upgrade;
+BWAPI::UpgradeType BuildItem::getUpgrade() const{
+	return (_type == Build::ItemTypes::UPGRADE) ? BWAPI::UpgradeType(_id) : BWAPI::UpgradeTypes::None;
 }
 
 void BuildItem::decreaseMulitplicity(){
 	_multiplicity--;
 }
 
-int BuildItem::getMultiplicity(){
+int BuildItem::getMultiplicity() const{
 	return _multiplicity;
 }
 
-int BuildItem::getLevel(){
+int BuildItem::getLevel() const{
 	return _upgradeLevel;
 }
 
-bool BuildItem::isFlag(){
+bool BuildItem::isFlag() const{
 	return _isFlag;
 }
 
-Flag BuildItem::getFlag(){
-	return _flag;
+Flag BuildItem::getFlag() const{
+	return _isFlag ? static_cast<Flag>(_id) : Flag::NONE;
 }
 
-bool BuildItem::isPersist(){
+bool BuildItem::isPersist() const{
 	return _persist;
 }
 
-std::vector<req_value_pair_t> BuildItem::getRequirements(){
-	return _requirements;
+bool BuildItem::isOrdered() const{
+	return _ordered;
+}
+
+void BuildItem::setOrdered(bool ordered){
+	// flags are always started in order
+	_ordered = ordered || _isFlag;
+}
+
+const std::vector<req_value_pair_t> & BuildItem::getRequirements() const{
+	return Build::getRequirementList(_requirements);
 }
 
-BWAPI::UnitType BuildItem::getParent(){
+BWAPI::UnitType BuildItem::getParent() const{
 	switch (_type){
 	case Build::ItemTypes::UNIT:
-		return _unit.whatBuilds().first;
+		return getUnit().whatBuilds().first;
 	case Build::ItemTypes::TECH:
-		return _tech.whatResearches();
+		return getTech().whatResearches();
 	case Build::ItemTypes::UPGRADE:
-		return _upgrade.whatUpgrades();
+		return getUpgrade().whatUpgrades();
 	default:
 		return BWAPI::UnitTypes::None;
 	}
@@ -15,6 +15,8 @@
 namespace ProBot
 {
 	typedef std::pair<int, int> req_value_pair_t;
+	// index of an interned requirement list (see Build::internRequirements)
+	typedef unsigned short req_list_id_t;
 
 	namespace Build{
 		// enumeration of non-flag BuildItem types
@@ -41,45 +43,69 @@ namespace ProBot
 
 		// error code for enumerations
 		const int INT_ERROR = -1;
+
+		// the interned list with no requirements, used by most build items
+		const req_list_id_t NO_REQUIREMENTS = 0;
+
+		/**
+			Returns the ID of the given requirement list, adding it to the interned lists if it's new.
+			Build items with the same requirements share one list, so that copying a build item never allocates.
+			Lists are never removed, and are only interned on the game thread (or during static initialization).
+		*/
+		req_list_id_t internRequirements(const std::vector<req_value_pair_t> & requirements);
+		/**
+			Returns the interned requirement list with the given ID.
+		*/
+		const std::vector<req_value_pair_t> & getRequirementList(req_list_id_t id);
 	}
 
+	/**
+		A build item, packed into a few bytes: the ID of its unit / tech / upgrade type or flag, tagged with its type.
+	*/
 	class BuildItem{
-		BWAPI::UnitType _unit;
-		BWAPI::TechType _tech;
-		BWAPI::UpgradeType _upgrade;
-		Flag _flag;
-		std::vector<req_value_pair_t> _requirements;
+		// number of units left to make (unit items only)
+		int _multiplicity;
+		// ID of the unit type, tech type, upgrade type or flag, depending on _type and _isFlag
+		unsigned short _id;
+		req_list_id_t _requirements;
+		// one of Build::ItemTypes (NUM_TYPES for flags)
+		unsigned char _type;
+		unsigned char _upgradeLevel;
 		bool _persist;
 		bool _isFlag;
-		int _upgradeLevel;
-		int _type;
-		int _multiplicity;
+		// true if no later item may be started before this one (always true for flags)
+		bool _ordered;
 
 	public:
 		// Constructor for unit build item.
-		BuildItem(BWAPI::UnitType unit, int multiplicity = 1, bool persist = false, std::vector<req_value_pair_t> requirements = {});
+		BuildItem(BWAPI::UnitType unit, int multiplicity = 1, bool persist = false, const std::vector<req_value_pair_t> & requirements = {});
 		// Constructor for tech build item.
-		BuildItem(BWAPI::TechType tech, std::vector<req_value_pair_t> requirements = {});
+		BuildItem(BWAPI::TechType tech, const std::vector<req_value_pair_t> & requirements = {});
 		// Constructor for upgrade build item.
-		BuildItem(BWAPI::UpgradeType upgrade, int level = 1, std::vector<req_value_pair_t> requirements = {});
+		BuildItem(BWAPI::UpgradeType upgrade, int level = 1, const std::vector<req_value_pair_t> & requirements = {});
 		// Constructor for flag build item.
-		BuildItem(Flag flag = Flag::NONE, std::vector<req_value_pair_t> requirements = {});
+		BuildItem(Flag flag = Flag::NONE, const std::vector<req_value_pair_t> & requirements = {});
 		
-		int getMineralCost();
-		int getGasCost();
-		int getType();
-		BWAPI::UnitType getUnit();
-		BWAPI::TechType getTech();
-		BWAPI::UpgradeType getUpgrade();
-		int getMultiplicity();
+		int getMineralCost() const;
+		int getGasCost() const;
+		int getType() const;
+		BWAPI::UnitType getUnit() const;
+		BWAPI::TechType getTech() const;
+		BWAPI::UpgradeType getUpgrade() const;
+		int getMultiplicity() const;
 		// Decrements the multiplicity value for a unit build item by one.
 		void decreaseMulitplicity();
-		int getLevel();
-		bool isFlag();
-		Flag getFlag();
-		bool isPersist();
-		std::vector<req_value_pair_t> getRequirements();
+		int getLevel() const;
+		bool isFlag() const;
+		Flag getFlag() const;
+		bool isPersist() const;
+		bool isOrdered() const;
+		// Marks the item as one that later items in the build order must not be started ahead of.
+		void setOrdered(bool ordered);
+		const std::vector<req_value_pair_t> & getRequirements() const;
 		// Retrieves the trainer/researcher/upgrader of the build item.
-		BWAPI::UnitType getParent();
+		BWAPI::UnitType getParent() const;
 	};
+
+	static_assert(sizeof(BuildItem) <= 16, "build items are copied around build queues, so they must stay small");
 }
\ No newline at end of file
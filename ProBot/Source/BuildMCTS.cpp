@@ -0,0 +1,293 @@
+/**
+	BuildMCTS.cpp
+	Monte Carlo tree search (UCT) over the tech-tree move space, as an alternative to minimax for choosing next tech to rush.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "BuildMCTS.h"
+#include "BuildMinimax.h"
+#include <climits>
+#include <cmath>
+#include <thread>
+
+using namespace ProBot;
+using namespace BuildMCTS;
+using BuildMinimax::SearchContext;
+using BuildMinimax::MAX_DEPTH;
+
+namespace {
+	// seed of the playout random number generator of the first thread (each thread gets a different one)
+	const unsigned int PLAYOUT_SEED = 0x9e3779b9;
+
+	/**
+		Returns the next number of a xorshift generator. Cheap enough to call for every playout move.
+	*/
+	unsigned int nextRandom(unsigned int & state){
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	/**
+		Returns the player to move after the given number of plies from the root.
+	*/
+	int getPlayer(int ply){
+		return (ply % 2 == 0) ? BuildMinimax::SELF : BuildMinimax::ENEMY;
+	}
+
+	void initNode(MCTSNode & node, tech_slot_t move){
+		node._firstChild.store(UNEXPANDED);
+		node._numChildren = 0;
+		node._visits.store(0);
+		node._scoreSum.store(0);
+		node._virtualLoss.store(0);
+		node._move = move;
+	}
+
+	/**
+		Adds a child to the node for each move of the player, taking them from the pool.
+		@return false if another thread is expanding the node, or the pool has no room for the children
+	*/
+	bool expandNode(MCTSTree & tree, MCTSNode & node, SearchContext & search, int ply){
+		int expected = UNEXPANDED;
+		if (!node._firstChild.compare_exchange_strong(expected, EXPANDING))
+			return false;
+
+		int player = getPlayer(ply);
+		tech_slot_t * moves = search._moveBuffer[0];
+		int numMoves = BuildMinimax::generateMoves(search._searchTree[player], search._searchState[player], search._blockedState[player], moves);
+		int first = tree._nextNode.fetch_add(numMoves);
+		if (first + numMoves > tree._poolSize){
+			// the node stays EXPANDING, so no other thread tries again
+			return false;
+		}
+		for (int i = 0; i < numMoves; i++)
+			initNode(tree._nodes[first + i], moves[i]);
+		search._stats._nodesByPly[ply + 1] += numMoves;
+
+		// publishing the first child also publishes the number of children
+		node._numChildren = numMoves;
+		node._firstChild.store(first);
+		return true;
+	}
+
+	/**
+		Returns the index of the child with the highest UCT value for the player choosing between them.
+		Children that haven't been tried yet (by any thread) come first, starting from a random one.
+	*/
+	int selectChild(const MCTSTree & tree, const MCTSNode & node, int player, unsigned int & random){
+		int first = node._firstChild.load();
+		int numChildren = node._numChildren;
+		long long minScore = tree._minScore.load();
+		long long maxScore = tree._maxScore.load();
+		double range = (maxScore > minScore) ? static_cast<double>(maxScore - minScore) : 1.0;
+		long long worstScore = (player == BuildMinimax::SELF) ? minScore : maxScore;
+		int parentVisits = node._visits.load() + node._virtualLoss.load();
+		double logParentVisits = std::log(static_cast<double>((parentVisits > 1) ? parentVisits : 1));
+
+		int offset = nextRandom(random) % numChildren;
+		int bestChild = first + offset;
+		double bestValue = -1.0;
+		for (int i = 0; i < numChildren; i++){
+			int index = first + (offset + i) % numChildren;
+			const MCTSNode & child = tree._nodes[index];
+			int virtualLoss = child._virtualLoss.load();
+			int visits = child._visits.load() + virtualLoss;
+			if (visits == 0)
+				return index;
+			double mean = static_cast<double>(child._scoreSum.load() + virtualLoss * worstScore) / visits;
+			double value = (mean - minScore) / range;
+			if (player == BuildMinimax::ENEMY)
+				value = 1.0 - value;
+			value += EXPLORATION * std::sqrt(logParentVisits / visits);
+			if (value > bestValue){
+				bestValue = value;
+				bestChild = index;
+			}
+		}
+		return bestChild;
+	}
+
+	void updateScoreRange(MCTSTree & tree, int score){
+		int low = tree._minScore.load();
+		while (score < low && !tree._minScore.compare_exchange_weak(low, score)){
+			// low has been reloaded, try again
+		}
+		int high = tree._maxScore.load();
+		while (score > high && !tree._maxScore.compare_exchange_weak(high, score)){
+			// high has been reloaded, try again
+		}
+	}
+
+	/**
+		Runs iterations on one thread until the tree's search is out of iterations or time.
+	*/
+	void runIterations(MCTSTree & tree, SearchContext & search, int maxIterations, int horizon, unsigned int seed){
+		unsigned int random = seed;
+		int path[MAX_DEPTH + 1];
+		tech_mask_t deltas[MAX_DEPTH];
+		int sinceTimeCheck = 0;
+
+		while (!tree._stopping.load()){
+			if (maxIterations > 0 && tree._iterations++ >= maxIterations)
+				break;
+			if (search._searchBudget > 0 && ++sinceTimeCheck >= ITERATIONS_PER_TIME_CHECK){
+				sinceTimeCheck = 0;
+				if (search._searchTimer.getElapsedMicroseconds() >= search._searchBudget){
+					tree._stopping.store(true);
+					break;
+				}
+			}
+
+			// follow the tree down to a leaf, making the moves on the way
+			int ply = 0;
+			path[0] = 0;
+			MCTSNode * node = &tree._nodes[0];
+			while (ply < horizon){
+				if (node->_firstChild.load() < 0){
+					if (node->_visits.load() < EXPAND_VISITS || !expandNode(tree, *node, search, ply))
+						break;
+				}
+				// a player with no moves ends the game, as in minimax
+				if (node->_numChildren == 0)
+					break;
+				int child = selectChild(tree, *node, getPlayer(ply), random);
+				node = &tree._nodes[child];
+				node->_virtualLoss++;
+				deltas[ply] = BuildMinimax::makeSearchMove(search, getPlayer(ply), node->_move);
+				path[++ply] = child;
+				search._stats._nodes++;
+			}
+			int treePly = ply;
+			search._stats._depth = (treePly > search._stats._depth) ? treePly : search._stats._depth;
+
+			// play random moves from the leaf to the horizon
+			while (ply < horizon){
+				int player = getPlayer(ply);
+				tech_slot_t * moves = search._moveBuffer[0];
+				int numMoves = BuildMinimax::generateMoves(search._searchTree[player], search._searchState[player], search._blockedState[player], moves);
+				if (numMoves == 0)
+					break;
+				deltas[ply++] = BuildMinimax::makeSearchMove(search, player, moves[nextRandom(random) % numMoves]);
+				search._stats._nodes++;
+			}
+			int score = BuildMinimax::evaluateGameState(search);
+			search._stats._leaves++;
+			while (ply > treePly){
+				ply--;
+				BuildMinimax::unmakeSearchMove(search, getPlayer(ply), deltas[ply]);
+			}
+
+			// add the score to each node on the path, replacing the virtual losses
+			updateScoreRange(tree, score);
+			for (int i = treePly; i >= 0; i--){
+				MCTSNode & pathNode = tree._nodes[path[i]];
+				pathNode._scoreSum += score;
+				pathNode._visits++;
+				if (i > 0){
+					pathNode._virtualLoss--;
+					BuildMinimax::unmakeSearchMove(search, getPlayer(i - 1), deltas[i - 1]);
+				}
+			}
+		}
+	}
+}
+
+MCTSStats::MCTSStats(){
+	clear();
+}
+
+void MCTSStats::clear(){
+	_iterations = 0;
+	_treeNodes = 0;
+	_poolFull = false;
+	_numRootMoves = 0;
+	for (int i = 0; i < MAX_TECH_NODES; i++){
+		_rootMoves[i] = NULL_SLOT;
+		_rootVisits[i] = 0;
+		_rootMeanScore[i] = 0;
+	}
+}
+
+MCTSTree::MCTSTree(int poolSize)
+	: _poolSize(poolSize), _nextNode(0), _iterations(0), _stopping(false), _minScore(0), _maxScore(0){
+}
+
+tech_slot_t BuildMCTS::mctsSearch(SearchContext & search, MCTSTree & tree, long long budget, int maxIterations,
+	int numThreads, int horizon){
+	horizon = (horizon < MAX_DEPTH) ? horizon : MAX_DEPTH;
+	numThreads = (numThreads > 1) ? numThreads : 1;
+	tree._stats.clear();
+	if (budget <= 0 && maxIterations <= 0){
+		return NULL_SLOT;
+	}
+	if (!tree._nodes){
+		tree._nodes.reset(new MCTSNode[tree._poolSize]);
+	}
+
+	// the root is expanded up front, since the threads only expand leaves that have been played out
+	int rootScore = BuildMinimax::evaluateGameState(search);
+	tree._nextNode.store(1);
+	tree._iterations.store(0);
+	tree._stopping.store(false);
+	tree._minScore.store(rootScore);
+	tree._maxScore.store(rootScore);
+	MCTSNode & root = tree._nodes[0];
+	initNode(root, NULL_SLOT);
+	search._searchBudget = budget;
+	search._stats._nodesByPly[0]++;
+	if (!expandNode(tree, root, search, 0) || root._numChildren == 0){
+		search._searchBudget = 0;
+		return NULL_SLOT;
+	}
+
+	// each helper thread searches its own copy of the state, starting with the same timer
+	std::vector<SearchContext> helperSearches(numThreads - 1, search);
+	search._stats.recordScratch((numThreads - 1) * sizeof(SearchContext));
+	std::vector<std::thread> helpers;
+	for (int thread = 0; thread < numThreads - 1; thread++){
+		helperSearches[thread]._stats.clear();
+		helpers.push_back(std::thread(runIterations, std::ref(tree), std::ref(helperSearches[thread]), maxIterations, horizon,
+			PLAYOUT_SEED + 7919 * (thread + 1)));
+	}
+	runIterations(tree, search, maxIterations, horizon, PLAYOUT_SEED);
+	for (int thread = 0; thread < numThreads - 1; thread++){
+		helpers[thread].join();
+		search._stats.addCounters(helperSearches[thread]._stats);
+		if (helperSearches[thread]._stats._depth > search._stats._depth)
+			search._stats._depth = helperSearches[thread]._stats._depth;
+	}
+	search._searchBudget = 0;
+
+	// the move with the most playouts is the most reliable one, with ties going to the higher average score
+	MCTSStats & stats = tree._stats;
+	stats._iterations = search._stats._leaves;
+	// a failed expansion still moves the next free node past the end of the pool
+	stats._poolFull = tree._nextNode.load() > tree._poolSize;
+	stats._treeNodes = stats._poolFull ? tree._poolSize : tree._nextNode.load();
+	stats._numRootMoves = root._numChildren;
+	int best = 0;
+	for (int i = 0; i < root._numChildren; i++){
+		const MCTSNode & child = tree._nodes[root._firstChild.load() + i];
+		int visits = child._visits.load();
+		stats._rootMoves[i] = child._move;
+		stats._rootVisits[i] = visits;
+		stats._rootMeanScore[i] = (visits > 0) ? static_cast<int>(child._scoreSum.load() / visits) : 0;
+		if (visits > stats._rootVisits[best] || (visits == stats._rootVisits[best] && stats._rootMeanScore[i] > stats._rootMeanScore[best]))
+			best = i;
+	}
+	return stats._rootMoves[best];
+}
+
+BWAPI::UnitType BuildMCTS::mctsNextBuilding(SearchContext & search, MCTSTree & tree, const TechTreeStore & self,
+	const TechTreeStore & enemy, long long budget, int maxIterations, int horizon){
+	BuildMinimax::initSearchState(search, self, enemy);
+	search._searchTimer.start();
+	tech_slot_t result = mctsSearch(search, tree, budget, maxIterations, BuildMinimax::getSearchThreads(), horizon);
+	search._stats._wallTime = search._searchTimer.getElapsedMicroseconds();
+
+	return (result != NULL_SLOT) ? search._searchTree[BuildMinimax::SELF][result]._unitType : BWAPI::UnitTypes::None;
+}
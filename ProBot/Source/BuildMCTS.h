@@ -0,0 +1,121 @@
+/**
+	BuildMCTS.h
+	Monte Carlo tree search (UCT) over the tech-tree move space, as an alternative to minimax for choosing next tech to rush.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include "SearchContext.h"
+
+namespace ProBot{
+	namespace BuildMCTS{
+		// number of nodes in a search tree's pool
+		const int DEFAULT_POOL_SIZE = 1 << 17;
+		// number of plies (moves of either player) from the root after which a playout is scored
+		const int DEFAULT_HORIZON = 8;
+		// number of playouts through a leaf before its children are added, so that the pool isn't spent on moves tried once
+		const int EXPAND_VISITS = 2;
+		// weight of the exploration term of the UCT formula
+		const double EXPLORATION = 1.4;
+		// number of iterations a thread runs between checks of the timer
+		const int ITERATIONS_PER_TIME_CHECK = 16;
+		// value of a node's first child before it has been expanded, and while a thread is expanding it
+		// (a node that didn't fit its children into the pool stays EXPANDING, and is scored by playouts only)
+		const int UNEXPANDED = -1;
+		const int EXPANDING = -2;
+
+		/**
+			A node of the search tree. The children of a node are contiguous in the pool.
+			Counters are atomic so that any number of threads can search the same tree.
+		*/
+		struct MCTSNode {
+			// index of the first child in the pool, or UNEXPANDED / EXPANDING
+			std::atomic<int> _firstChild;
+			// only written before _firstChild is set to a child index
+			int _numChildren;
+			// number of playouts through the node, and the sum of their scores (from SELF's point of view)
+			std::atomic<int> _visits;
+			std::atomic<long long> _scoreSum;
+			// number of threads currently searching below the node, each counted as a playout with the worst score
+			// for the player choosing the node, so that threads spread out over the tree
+			std::atomic<int> _virtualLoss;
+			// the move that leads to the node (unused for the root)
+			tech_slot_t _move;
+		};
+
+		/**
+			Visit statistics of the latest search of a tree.
+		*/
+		struct MCTSStats {
+			// number of playouts, and number of nodes added to the tree (including the root)
+			unsigned int _iterations;
+			unsigned int _treeNodes;
+			// true if the tree stopped growing because the pool was full
+			bool _poolFull;
+			// the moves of SELF from the root, and the number of playouts and average score of each
+			int _numRootMoves;
+			tech_slot_t _rootMoves[MAX_TECH_NODES];
+			int _rootVisits[MAX_TECH_NODES];
+			int _rootMeanScore[MAX_TECH_NODES];
+
+			MCTSStats();
+
+			/**
+				Resets every counter to zero.
+			*/
+			void clear();
+		};
+
+		/**
+			A search tree and its preallocated node pool. Nodes are only taken from the pool during a search,
+			so searching never allocates; the pool itself is allocated the first time the tree is searched.
+		*/
+		struct MCTSTree {
+			std::unique_ptr<MCTSNode[]> _nodes;
+			int _poolSize;
+			// index of the next free node in the pool (may go past the end once the pool is full)
+			std::atomic<int> _nextNode;
+			// number of iterations started by every thread of the current search
+			std::atomic<int> _iterations;
+			// set by the first thread to run out of time, so that the others stop too
+			std::atomic<bool> _stopping;
+			// lowest and highest playout scores so far, which map scores onto [0, 1] for the UCT formula
+			std::atomic<int> _minScore;
+			std::atomic<int> _maxScore;
+			// statistics of the latest search
+			MCTSStats _stats;
+
+			explicit MCTSTree(int poolSize = DEFAULT_POOL_SIZE);
+		};
+
+		/**
+			Searches the position set up in the context by BuildMinimax::initSearchState, with SELF to move.
+			Each iteration follows the UCT formula down the tree, adds the children of the leaf it reaches,
+			plays random moves for both players up to the horizon and scores the result with evaluateGameState
+			(the same as evaluateTree of the final state). Threads share the tree, and each searches its own copy of the context.
+
+			@param search - the search context, set up by initSearchState
+			@param tree - the tree to search with (cleared first)
+			@param budget - the time allowed for the search, in microseconds, measured by the context's timer (0 for no limit)
+			@param maxIterations - the number of playouts to run (0 for no limit); at least one limit must be set
+			@param numThreads - the number of threads to search with (including the calling thread)
+			@param horizon - the number of plies after which playouts are scored (at most MAX_DEPTH)
+			@return the root move with the most playouts, or NULL_SLOT if SELF has no moves
+		*/
+		tech_slot_t mctsSearch(BuildMinimax::SearchContext & search, MCTSTree & tree, long long budget, int maxIterations,
+			int numThreads, int horizon = DEFAULT_HORIZON);
+		/**
+			Finds the next building to invest in with a Monte Carlo tree search of copies of the given trees,
+			using the number of threads set by BuildMinimax::setSearchThreads.
+			The context's statistics count playouts as leaves, and every state visited as a node.
+			@return the chosen move as a UnitType.
+		*/
+		BWAPI::UnitType mctsNextBuilding(BuildMinimax::SearchContext & search, MCTSTree & tree, const TechTreeStore & self,
+			const TechTreeStore & enemy, long long budget, int maxIterations = 0, int horizon = DEFAULT_HORIZON);
+	}
+}
@@ -7,135 +7,616 @@
 */
 
 #include "BuildMinimax.h"
+#include "BuildMCTS.h"
+#include "OpeningBook.h"
+#include "BuildSearchWorker.h"
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <thread>
 
 using namespace ProBot;
 
-tree_score_pair_t BuildMinimax::minimaxAlphaBeta(int depth, int player, int alpha, int beta) {
-	// generate a list of units that can be researched from current player tree
-	std::vector<BWAPI::UnitType> nextMoves = generateMoves(_gameTreeState[player]);
+// shared by the contexts of the game thread and the search worker, so that states searched for a previous target tech can be reused
+static TranspositionTable transpositionTable;
+
+// the target technology to research, as determined by minimax (stored as a unit type ID so that it can be atomic)
+static std::atomic<int> targetTechId(BWAPI::UnitTypes::Enum::None);
+
+// runs the searches requested by updateTargetTech once started
+static BuildSearchWorker searchWorker;
+
+// the current tech tree of each player, stored as flat node arrays
+static TechTreeStore gameTrees[2];
+
+// set when either tree changes, and cleared when a search of the new trees is started
+static bool gameTreesChanged = false;
+
+// the context used by searches run on the game thread (the worker has its own)
+static BuildMinimax::SearchContext gameSearch(transpositionTable);
+
+// the tree used by Monte Carlo searches run on the game thread (its node pool is only allocated if one is run)
+static BuildMCTS::MCTSTree gameMCTS;
+
+// statistics of every search run for the game so far (written by the game thread or the worker)
+static std::mutex searchLogMutex;
+static std::vector<BuildMinimax::SearchStats> searchLog;
+
+// number of threads used by minimaxNextBuildingTimed (set on the game thread, read by the worker)
+static std::atomic<int> searchThreads(BuildMinimax::DEFAULT_SEARCH_THREADS);
+
+// the algorithm used to search for the target tech (set on the game thread, read by the worker)
+static std::atomic<int> searchBackend(BuildMinimax::MINIMAX_BACKEND);
+
+// the root moves of a search split between threads, and the scores found for them so far
+struct RootSplit {
+	tech_slot_t _moves[MAX_TECH_NODES];
+	int _numMoves;
+	int _depth;
+	// the next move to hand out, and the highest exact score found by any thread
+	std::atomic<int> _nextMove;
+	std::atomic<int> _bestScore;
+	int _scores[MAX_TECH_NODES];
+	// false if the search only showed that the move scores below _bestScore
+	bool _exact[MAX_TECH_NODES];
+};
+
+/**
+	Searches root moves of a split until there are none left, taking the next unsearched move each time.
+*/
+static void searchRootMoves(RootSplit & split, BuildMinimax::SearchContext & search){
+	for (int i = split._nextMove++; i < split._numMoves; i = split._nextMove++){
+		// a score equal to the best so far must still be found exactly, since an earlier move wins a tie
+		int scoreToBeat = split._bestScore.load();
+		int alpha = (scoreToBeat > INT_MIN) ? scoreToBeat - 1 : INT_MIN;
+		tech_mask_t delta = BuildMinimax::makeSearchMove(search, BuildMinimax::SELF, split._moves[i]);
+		int score = BuildMinimax::minimaxAlphaBeta(search, split._depth - 1, BuildMinimax::ENEMY, alpha, INT_MAX).second;
+		BuildMinimax::unmakeSearchMove(search, BuildMinimax::SELF, delta);
+		if (search._searchAborted){
+			return;
+		}
+		split._scores[i] = score;
+		split._exact[i] = score > alpha;
+		if (!split._exact[i])
+			continue;
+		int best = split._bestScore.load();
+		while (score > best && !split._bestScore.compare_exchange_weak(best, score)){
+			// best has been reloaded, try again
+		}
+	}
+}
+
+move_score_pair_t BuildMinimax::minimaxAlphaBeta(SearchContext & search, int depth, int player, int alpha, int beta) {
+	// generate a list of nodes that can be obtained from current player tree
+	tech_slot_t * nextMoves = search._moveBuffer[depth];
+	int numMoves = generateMoves(search._searchTree[player], search._searchState[player], search._blockedState[player], nextMoves);
 
 	// SELF is maximizing; ENEMY is minimizing
 	int score;
-	TechTree bestTree = NULL_TREE;
+	tech_slot_t bestMove = NULL_SLOT;
 
-	if (nextMoves.size() <= 0 || depth <= 0) {	// nothing left to research or maximum depth reached
-		score = evaluateGameState();
-		return std::make_pair(bestTree, score);
+	// moves made outside of a search (by tests) can go deeper than the statistics are kept for
+	int ply = (search._ply < MAX_DEPTH) ? search._ply : MAX_DEPTH;
+	search._stats._nodes++;
+	search._stats._nodesByPly[ply]++;
+	if (ply == 0) {
+		search._stats.recordScratch((depth + 1) * sizeof(search._moveBuffer[0]));
+	}
+
+	// stop searching once the time budget runs out
+	if (search._searchBudget > 0 && search._stats._nodes % NODES_PER_TIME_CHECK == 0
+		&& search._searchTimer.getElapsedMicroseconds() >= search._searchBudget) {
+		search._searchAborted = true;
+	}
+	if (search._searchAborted) {
+		return std::make_pair(bestMove, 0);
+	}
+
+	if (numMoves <= 0 || depth <= 0) {	// nothing left to research or maximum depth reached
+		search._stats._leaves++;
+		score = evaluateGameState(search);
+		return std::make_pair(bestMove, score);
 	}
 	else {
-		for (BWAPI::UnitType move : nextMoves) { // otherwise evaluate each move
+		// check whether this state has already been searched through a different order of moves
+		// (only results of the same depth are used, so that the result doesn't depend on what is in the table)
+		zobrist_key_t key = search._searchHash ^ Zobrist::getPlayerKey(player);
+		TTResult entry;
+		tech_slot_t hashMove = NULL_SLOT;
+		if (search._transpositionTable->probe(key, entry)) {
+			if (entry._depth == depth && (entry._bound == TT_EXACT
+				|| (entry._bound == TT_LOWER && entry._score >= beta)
+				|| (entry._bound == TT_UPPER && entry._score <= alpha))) {
+				return std::make_pair(entry._bestMove, entry._score);
+			}
+			// otherwise search the best move of the stored (usually shallower) search first
+			hashMove = entry._bestMove;
+		}
+		orderMoves(search, depth, player, hashMove, nextMoves, numMoves);
+
+		int alphaOriginal = alpha;
+		int betaOriginal = beta;
+
+		for (int i = 0; i < numMoves; i++) { // otherwise evaluate each move
 			// apply the move to the current player's gamestate
-			setBuildingNodeObtained(move, _gameTreeState[player]);
+			tech_mask_t delta = makeSearchMove(search, player, nextMoves[i]);
 
 			if (player == SELF) {
 				// evaluate ENEMY's turn
-				score = minimaxAlphaBeta(depth - 1, ENEMY, alpha, beta).second;
+				score = minimaxAlphaBeta(search, depth - 1, ENEMY, alpha, beta).second;
 				if (score > alpha) {
 					alpha = score;
-					bestTree = _gameTreeState[player];
+					bestMove = nextMoves[i];
 				}
 			}
 			else {
 				// evaluate SELF's turn
-				score = minimaxAlphaBeta(depth - 1, SELF, alpha, beta).second;
+				score = minimaxAlphaBeta(search, depth - 1, SELF, alpha, beta).second;
 				if (score < beta) {
 					beta = score;
-					bestTree = _gameTreeState[player];
+					bestMove = nextMoves[i];
 				}
 			}
 			// undo the move for the current player's gamestate
-			setBuildingNodeObtained(move, _gameTreeState[player], false);
+			unmakeSearchMove(search, player, delta);
+
+			// the scores of an unfinished search can't be trusted
+			if (search._searchAborted) {
+				return std::make_pair(NULL_SLOT, 0);
+			}
 
 			// cut-off
-			if (alpha >= beta) break;
+			if (alpha >= beta) {
+				search._stats._cutoffsByPly[ply]++;
+				recordCutoff(search, depth, player, nextMoves[i]);
+				break;
+			}
+		}
+
+		// a cut-off only bounds the score from one side, and so does failing to improve on the original window
+		score = (player == SELF) ? alpha : beta;
+		TT_BOUND bound = TT_EXACT;
+		if (player == SELF) {
+			if (score >= betaOriginal) bound = TT_LOWER;
+			else if (score <= alphaOriginal) bound = TT_UPPER;
+		}
+		else {
+			if (score <= alphaOriginal) bound = TT_UPPER;
+			else if (score >= betaOriginal) bound = TT_LOWER;
 		}
-		// return best tree and its corresponding score
-		return std::make_pair(bestTree, (player == SELF) ? alpha : beta);
+		search._transpositionTable->store(key, score, depth, bound, bestMove);
+
+		// return best move and its corresponding score
+		return std::make_pair(bestMove, score);
 	}
 }
 
- tree_score_pair_t BuildMinimax::minimax(int depth, int player) {
+ move_score_pair_t BuildMinimax::minimax(SearchContext & search, int depth, int player) {
 	
-	 // generate a list of units that can be researched from current player tree
-	std::vector<BWAPI::UnitType> nextMoves = generateMoves(_gameTreeState[player]);
+	 // generate a list of nodes that can be obtained from current player tree
+	tech_slot_t * nextMoves = search._moveBuffer[depth];
+	int numMoves = generateMoves(search._searchTree[player], search._searchState[player], search._blockedState[player], nextMoves);
 	
 	// SELF is maximizing; ENEMY is minimizing
 	int bestScore = (player == SELF) ? INT_MIN : INT_MAX;
 	int currentScore;
-	TechTree bestTree = NULL_TREE;
+	tech_slot_t bestMove = NULL_SLOT;
 
-	if (nextMoves.size() <= 0 || depth <= 0) {	// nothing left to research or maximum depth reached
-		bestScore = evaluateGameState();
+	if (numMoves <= 0 || depth <= 0) {	// nothing left to research or maximum depth reached
+		bestScore = evaluateGameState(search);
 	}
 	else {
-		for (BWAPI::UnitType move : nextMoves) { // otherwise evaluate each move
+		for (int i = 0; i < numMoves; i++) { // otherwise evaluate each move
 			// apply the move to the current player's gamestate
-			setBuildingNodeObtained(move, _gameTreeState[player]);
+			tech_mask_t delta = makeSearchMove(search, player, nextMoves[i]);
 
 			if (player == SELF) {
 				// evaluate ENEMY's turn
-				currentScore = minimax(depth - 1, ENEMY).second;
+				currentScore = minimax(search, depth - 1, ENEMY).second;
 
 				if (currentScore > bestScore) { // maximizing step
 					bestScore = currentScore;
-					bestTree = _gameTreeState[player];
+					bestMove = nextMoves[i];
 				}
 			}
 			else {
 				// evaluate SELF's turn
-				currentScore = minimax(depth - 1, SELF).second;
+				currentScore = minimax(search, depth - 1, SELF).second;
 				if (currentScore < bestScore) { // minimizing step
 					bestScore = currentScore;
-					bestTree = _gameTreeState[player];
+					bestMove = nextMoves[i];
 				}
 			}
 
 			// undo the move for the current player's gamestate
-			setBuildingNodeObtained(move, _gameTreeState[player], false);
+			unmakeSearchMove(search, player, delta);
 		}
 	}
-	// return best tree and its corresponding score
-	return std::make_pair(bestTree, bestScore);
+	// return best move and its corresponding score
+	return std::make_pair(bestMove, bestScore);
 }
 
- BWAPI::UnitType BuildMinimax::minimaxNextBuilding(int depth){
-	 TechTree result = minimaxAlphaBeta(depth, SELF, INT_MIN, INT_MAX).first; // get the minimax tree
-	 //TechTree result = minimax(depth, SELF).first;
-	 return getFirstDifference(result, _gameTreeState[SELF]); // get the unit that was set to obtained
+ move_score_pair_t BuildMinimax::minimaxAlphaBetaParallel(SearchContext & search, int depth, int numThreads) {
+	 // shared by every thread of the split
+	 RootSplit split;
+	 split._numMoves = generateMoves(search._searchTree[SELF], search._searchState[SELF], search._blockedState[SELF], split._moves);
+	 split._depth = depth;
+
+	 // nothing to split
+	 if (numThreads <= 1 || split._numMoves <= 1 || depth <= 1){
+		 return minimaxAlphaBeta(search, depth, SELF, INT_MIN, INT_MAX);
+	 }
+
+	 // order the root moves exactly as the serial search would, since ties go to the first move searched
+	 zobrist_key_t key = search._searchHash ^ Zobrist::getPlayerKey(SELF);
+	 TTResult entry;
+	 tech_slot_t hashMove = NULL_SLOT;
+	 if (search._transpositionTable->probe(key, entry)) {
+		 if (entry._depth == depth && entry._bound == TT_EXACT) {
+			 return std::make_pair(entry._bestMove, entry._score);
+		 }
+		 hashMove = entry._bestMove;
+	 }
+	 orderMoves(search, depth, SELF, hashMove, split._moves, split._numMoves);
+
+	 // search the first move alone (it is usually the best), so that the other threads have a score to beat
+	 tech_mask_t delta = makeSearchMove(search, SELF, split._moves[0]);
+	 split._scores[0] = minimaxAlphaBeta(search, depth - 1, ENEMY, INT_MIN, INT_MAX).second;
+	 split._exact[0] = true;
+	 unmakeSearchMove(search, SELF, delta);
+	 if (search._searchAborted){
+		 return std::make_pair(NULL_SLOT, 0);
+	 }
+	 split._nextMove = 1;
+	 split._bestScore = split._scores[0];
+
+	 // each helper thread searches its own copy of the state, starting with the same killers, history and timer
+	 std::vector<SearchContext> helperSearches(numThreads - 1, search);
+	 search._stats.recordScratch((depth + 1) * sizeof(search._moveBuffer[0]) + (numThreads - 1) * sizeof(SearchContext));
+	 std::vector<std::thread> helpers;
+	 for (int thread = 0; thread < numThreads - 1; thread++){
+		 helperSearches[thread]._stats.clear();
+		 helpers.push_back(std::thread(searchRootMoves, std::ref(split), std::ref(helperSearches[thread])));
+	 }
+	 searchRootMoves(split, search);
+	 for (int thread = 0; thread < numThreads - 1; thread++){
+		 helpers[thread].join();
+		 search._stats.addCounters(helperSearches[thread]._stats);
+		 search._searchAborted = search._searchAborted || helperSearches[thread]._searchAborted;
+	 }
+	 if (search._searchAborted){
+		 return std::make_pair(NULL_SLOT, 0);
+	 }
+
+	 // the best move is the first one (in search order) with the highest exact score, as in the serial search
+	 int best = 0;
+	 for (int i = 1; i < split._numMoves; i++){
+		 if (split._exact[i] && split._scores[i] > split._scores[best])
+			 best = i;
+	 }
+	 search._transpositionTable->store(key, split._scores[best], depth, TT_EXACT, split._moves[best]);
+	 return std::make_pair(split._moves[best], split._scores[best]);
  }
 
-std::vector<BWAPI::UnitType> BuildMinimax::generateMoves(TechTree tree) {
-	std::vector<BWAPI::UnitType> nextMoves;
+ bool BuildMinimax::lookupBookMove(SearchContext & search, const TechTreeStore & self, const TechTreeStore & enemy, int minDepth,
+	 BWAPI::UnitType & move){
+	 search._searchTimer.start();
+	 int depth;
+	 tech_slot_t slot = OpeningBook::lookupMove(self, enemy, minDepth, depth);
+	 if (slot == NULL_SLOT){
+		 return false;
+	 }
+	 search._stats.clear();
+	 search._stats._bookHit = true;
+	 search._stats._depth = depth;
+	 search._stats._wallTime = search._searchTimer.getElapsedMicroseconds();
+	 move = self[slot]._unitType;
+	 return true;
+ }
+
+ BWAPI::UnitType BuildMinimax::minimaxNextBuilding(SearchContext & search, int depth){
+	 // the context only has room for MAX_DEPTH plies
+	 depth = (depth < MAX_DEPTH) ? depth : MAX_DEPTH;
+	 BWAPI::UnitType bookMove;
+	 if (lookupBookMove(search, gameTrees[SELF], gameTrees[ENEMY], depth, bookMove)){
+		 return bookMove;
+	 }
+	 initSearchState(search, gameTrees[SELF], gameTrees[ENEMY]);
+	 search._searchTimer.start();
+	 tech_slot_t result = minimaxAlphaBeta(search, depth, SELF, INT_MIN, INT_MAX).first; // get the principal move
+	 //tech_slot_t result = minimax(search, depth, SELF).first;
+	 search._stats._depth = depth;
+	 search._stats._wallTime = search._searchTimer.getElapsedMicroseconds();
+	 return (result != NULL_SLOT) ? search._searchTree[SELF][result]._unitType : BWAPI::UnitTypes::None;
+ }
+
+ BWAPI::UnitType BuildMinimax::minimaxNextBuildingTimed(SearchContext & search, const TechTreeStore & self, const TechTreeStore & enemy,
+	 long long budget, int maxDepth){
+	 maxDepth = (maxDepth < MAX_DEPTH) ? maxDepth : MAX_DEPTH;
+	 // a book move only replaces the search if it was searched at least as deep as the search would get
+	 int bookDepth = (maxDepth < MIN_TIMED_BOOK_DEPTH) ? maxDepth : MIN_TIMED_BOOK_DEPTH;
+	 BWAPI::UnitType bookMove;
+	 if (lookupBookMove(search, self, enemy, bookDepth, bookMove)){
+		 return bookMove;
+	 }
+	 initSearchState(search, self, enemy);
+	 search._searchTimer.start();
+	 tech_slot_t result = NULL_SLOT;
+	 int numThreads = getSearchThreads();
+
+	 for (int depth = 1; depth <= maxDepth; depth++){
+		 // the first iteration is always completed, so that there is a move to return
+		 search._searchBudget = (depth > 1) ? budget : 0;
+		 tech_slot_t move = (numThreads > 1 && depth >= MIN_PARALLEL_DEPTH)
+			 ? minimaxAlphaBetaParallel(search, depth, numThreads).first
+			 : minimaxAlphaBeta(search, depth, SELF, INT_MIN, INT_MAX).first;
+		 if (search._searchAborted){
+			 break;
+		 }
+		 result = move;
+		 search._stats._depth = depth;
+		 // don't start an iteration that has no time left
+		 if (search._searchTimer.getElapsedMicroseconds() >= budget){
+			 break;
+		 }
+	 }
+	 search._searchBudget = 0;
+	 search._searchAborted = false;
+	 search._stats._wallTime = search._searchTimer.getElapsedMicroseconds();
+
+	 return (result != NULL_SLOT) ? search._searchTree[SELF][result]._unitType : BWAPI::UnitTypes::None;
+ }
+
+ void BuildMinimax::setSearchThreads(int numThreads){
+	 searchThreads.store((numThreads > 1) ? numThreads : 1);
+ }
+
+ int BuildMinimax::getSearchThreads(){
+	 return searchThreads.load();
+ }
+
+ BWAPI::UnitType BuildMinimax::searchNextBuilding(SearchContext & search, BuildMCTS::MCTSTree & mcts, const TechTreeStore & self,
+	 const TechTreeStore & enemy, long long budget){
+	 if (getSearchBackend() == MCTS_BACKEND){
+		 return BuildMCTS::mctsNextBuilding(search, mcts, self, enemy, budget);
+	 }
+	 return minimaxNextBuildingTimed(search, self, enemy, budget);
+ }
+
+ void BuildMinimax::setSearchBackend(SEARCH_BACKEND backend){
+	 searchBackend.store(backend);
+ }
 
-	for (TechTree & obtainableNode : findNextObtainableNodes(tree)){
-			nextMoves.push_back(obtainableNode._unitType);
+ BuildMinimax::SEARCH_BACKEND BuildMinimax::getSearchBackend(){
+	 return static_cast<SEARCH_BACKEND>(searchBackend.load());
+ }
+
+void BuildMinimax::initSearchState(SearchContext & search, const TechTreeStore & self, const TechTreeStore & enemy){
+	CombatUtil::initStaticTables();
+	// stored states and moves refer to node slots of the old trees
+	if (!search._searchTree[SELF].hasSameLayout(self) || !search._searchTree[ENEMY].hasSameLayout(enemy)){
+		clearSearchHistory(search);
+	}
+	search._searchTree[SELF] = self;
+	search._searchTree[ENEMY] = enemy;
+
+	for (int player = SELF; player < PLAYER_ID_SIZE; player++){
+		const TechTreeStore & tree = search._searchTree[player];
+		search._searchState[player] = tree.getObtainedMask();
+		search._blockedState[player] = tree.getRemovedMask();
+
+		for (tech_slot_t slot = 0; slot < tree.size(); slot++){
+			// score a move by the units it unlocks
+			search._moveOrderScore[player][slot] = 0;
+			tech_mask_t unlocked = tree.getMoveMask(slot);
+			for (tech_slot_t unit = slot; unit < tree.size(); unit++){
+				if ((unlocked & slotBit(unit)) && !tree[unit]._unitType.isBuilding())
+					search._moveOrderScore[player][slot] += CombatUtil::lookupStaticUnitScore(tree[unit]._unitType);
+			}
+			// older cut-offs count for less than recent ones
+			search._historyScore[player][slot] /= 2;
+		}
+		for (int depth = 0; depth <= MAX_DEPTH; depth++){
+			for (int i = 0; i < NUM_KILLER_MOVES; i++)
+				search._killerMoves[player][depth][i] = NULL_SLOT;
+		}
+	}
+	search._searchHash = Zobrist::hashMask(SELF, search._searchState[SELF]) ^ Zobrist::hashMask(ENEMY, search._searchState[ENEMY]);
+	search._stats.clear();
+	search._ply = 0;
+
+	// cache the unit scores of each node, and the advantages of each pair of nodes
+	for (int player = SELF; player < PLAYER_ID_SIZE; player++){
+		const TechTreeStore & tree = search._searchTree[player];
+		for (tech_slot_t slot = 0; slot < tree.size(); slot++)
+			search._slotUnitScore[player][slot] = CombatUtil::lookupStaticUnitScore(tree[slot]._unitType);
+	}
+	for (tech_slot_t first = 0; first < search._searchTree[SELF].size(); first++){
+		for (tech_slot_t second = 0; second < search._searchTree[ENEMY].size(); second++){
+			search._slotAdvantage[first][second] = CombatUtil::lookupStaticAdvantage(
+				search._searchTree[SELF][first]._unitType, search._searchTree[ENEMY][second]._unitType);
+		}
+	}
+
+	// add SELF's units while ENEMY has none, so that each pair is only counted once when ENEMY's units are added
+	search._evalUnitCount[SELF] = search._evalUnitCount[ENEMY] = 0;
+	search._evalUnitScore[SELF] = search._evalUnitScore[ENEMY] = 0;
+	search._evalAdvantage = 0;
+	tech_mask_t enemyState = search._searchState[ENEMY];
+	search._searchState[ENEMY] = 0;
+	updateEvaluation(search, SELF, search._searchState[SELF], 1);
+	search._searchState[ENEMY] = enemyState;
+	updateEvaluation(search, ENEMY, search._searchState[ENEMY], 1);
+}
+
+std::vector<BWAPI::UnitType> BuildMinimax::generateMoves(const TechTreeStore & tree) {
+	tech_slot_t moves[MAX_TECH_NODES];
+	int numMoves = generateMoves(tree, tree.getObtainedMask(), tree.getRemovedMask(), moves);
+
+	std::vector<BWAPI::UnitType> nextMoves;
+	for (int i = 0; i < numMoves; i++){
+		nextMoves.push_back(tree[moves[i]]._unitType);
 	}
 
 	return nextMoves;
 }
 
-int BuildMinimax::evaluateGameState(){
+int BuildMinimax::generateMoves(const TechTreeStore & tree, tech_mask_t obtained, tech_mask_t blocked, tech_slot_t * moves){
+	int numMoves = 0;
+	tech_mask_t movesMask = 0;
+	for (tech_slot_t slot = 0; slot < tree.size(); slot++){
+		tech_mask_t bit = slotBit(slot);
+		if ((obtained | blocked) & bit)
+			continue;
+		// obtained nodes always have obtained parents, so only the immediate parent needs to be checked
+		tech_slot_t parent = tree[slot]._parent;
+		if (parent != NULL_SLOT && !(obtained & slotBit(parent)))
+			continue;
+		// a unit type can only be obtained once, and copies of the same move only need to be searched once
+		if (tree.getSameTypeMask(slot) & (obtained | movesMask))
+			continue;
+		movesMask |= bit;
+		moves[numMoves++] = slot;
+	}
+	return numMoves;
+}
+
+void BuildMinimax::orderMoves(const SearchContext & search, int depth, int player, tech_slot_t hashMove, tech_slot_t * moves, int numMoves){
+	// higher priority moves are always searched first, with ties broken by history and then static score
+	int priority[MAX_TECH_NODES];
+	for (int i = 0; i < numMoves; i++){
+		priority[i] = 0;
+		if (moves[i] == hashMove){
+			priority[i] = NUM_KILLER_MOVES + 1;
+		}
+		else if (search._moveOrdering && depth <= MAX_DEPTH){
+			for (int k = 0; k < NUM_KILLER_MOVES; k++){
+				if (moves[i] == search._killerMoves[player][depth][k]){
+					priority[i] = NUM_KILLER_MOVES - k;
+					break;
+				}
+			}
+		}
+	}
+
+	// insertion sort, since there are only ever a handful of moves (and it keeps equal moves in tree order)
+	for (int i = 1; i < numMoves; i++){
+		tech_slot_t move = moves[i];
+		int movePriority = priority[i];
+		int j = i - 1;
+		for (; j >= 0; j--){
+			bool before;
+			if (movePriority != priority[j])
+				before = movePriority > priority[j];
+			else if (!search._moveOrdering)
+				before = false;
+			else if (search._historyScore[player][move] != search._historyScore[player][moves[j]])
+				before = search._historyScore[player][move] > search._historyScore[player][moves[j]];
+			else
+				before = search._moveOrderScore[player][move] > search._moveOrderScore[player][moves[j]];
+			if (!before)
+				break;
+			moves[j + 1] = moves[j];
+			priority[j + 1] = priority[j];
+		}
+		moves[j + 1] = move;
+		priority[j + 1] = movePriority;
+	}
+}
+
+void BuildMinimax::recordCutoff(SearchContext & search, int depth, int player, tech_slot_t move){
+	search._historyScore[player][move] += depth * depth;
+	if (depth > MAX_DEPTH || search._killerMoves[player][depth][0] == move)
+		return;
+	for (int k = NUM_KILLER_MOVES - 1; k > 0; k--)
+		search._killerMoves[player][depth][k] = search._killerMoves[player][depth][k - 1];
+	search._killerMoves[player][depth][0] = move;
+}
+
+tech_mask_t BuildMinimax::makeMove(const TechTreeStore & tree, tech_mask_t & obtained, tech_slot_t move){
+	// only flip bits that aren't already set, so that flipping them back restores the exact previous state
+	tech_mask_t delta = tree.getMoveMask(move) & ~obtained;
+	obtained ^= delta;
+	return delta;
+}
+
+void BuildMinimax::unmakeMove(tech_mask_t & obtained, tech_mask_t delta){
+	obtained ^= delta;
+}
+
+tech_mask_t BuildMinimax::makeSearchMove(SearchContext & search, int player, tech_slot_t move){
+	tech_mask_t delta = makeMove(search._searchTree[player], search._searchState[player], move);
+	search._searchHash ^= Zobrist::hashMask(player, delta);
+	updateEvaluation(search, player, delta, 1);
+	search._ply++;
+	return delta;
+}
+
+void BuildMinimax::unmakeSearchMove(SearchContext & search, int player, tech_mask_t delta){
+	unmakeMove(search._searchState[player], delta);
+	search._searchHash ^= Zobrist::hashMask(player, delta);
+	updateEvaluation(search, player, delta, -1);
+	search._ply--;
+}
+
+void BuildMinimax::updateEvaluation(SearchContext & search, int player, tech_mask_t nodes, int sign){
+	int other = (player == SELF) ? ENEMY : SELF;
+	tech_mask_t units = nodes & search._searchTree[player].getUnitLeafMask();
+	tech_mask_t otherUnits = search._searchState[other] & search._searchTree[other].getUnitLeafMask();
+
+	for (tech_slot_t unit = 0; units != 0; unit++, units >>= 1){
+		if (!(units & 1))
+			continue;
+		search._evalUnitCount[player] += sign;
+		search._evalUnitScore[player] += sign * search._slotUnitScore[player][unit];
+
+		// add the unit's row (or column) of the advantage matrix against the other player's units
+		tech_mask_t others = otherUnits;
+		for (tech_slot_t otherUnit = 0; others != 0; otherUnit++, others >>= 1){
+			if (others & 1)
+				search._evalAdvantage += sign * ((player == SELF) ? search._slotAdvantage[unit][otherUnit] : search._slotAdvantage[otherUnit][unit]);
+		}
+	}
+}
+
+int BuildMinimax::evaluateGameState(const SearchContext & search){
 	int eval = 0;
 
-	eval += evaluateTree(_gameTreeState[SELF], _gameTreeState[ENEMY]);
-	//eval -= evaluateTree(_gameTreeState[ENEMY], _gameTreeState[SELF]);
+	// the pairwise sum of evaluateTree, regrouped into per-player totals:
+	// each SELF unit gets a base score, its own score once per ENEMY unit, and loses each ENEMY unit's score
+	eval += 1000 * search._evalUnitCount[SELF];
+	eval += search._evalUnitScore[SELF] * search._evalUnitCount[ENEMY];
+	eval -= search._evalUnitScore[ENEMY] * search._evalUnitCount[SELF];
+	eval += search._evalAdvantage;
 
 	return eval;
 }
 
-int BuildMinimax::evaluateTree(TechTree first, TechTree second){
+int BuildMinimax::evaluateTree(const TechTreeStore & first, const TechTreeStore & second){
+	CombatUtil::initStaticTables();
+	return evaluateTree(first, first.getObtainedMask(), second, second.getObtainedMask());
+}
+
+int BuildMinimax::evaluateTree(const TechTreeStore & first, tech_mask_t firstObtained, const TechTreeStore & second, tech_mask_t secondObtained){
 	int eval = 0;
 
-	for (TechTree & firstNode : findNonBuildingLeafNodes(first)){
+	tech_mask_t firstNodes = firstObtained & first.getUnitLeafMask();
+	tech_mask_t secondNodes = secondObtained & second.getUnitLeafMask();
+
+	for (tech_slot_t firstNode = 0; firstNode < first.size(); firstNode++){
+		if (!(firstNodes & slotBit(firstNode)))
+			continue;
 		// give a base score for each unit, so that it's more advantageous to have access to
 		// a greater diversity of units
 		eval += 1000;
-		for (TechTree & secondNode : findNonBuildingLeafNodes(second)){
+		for (tech_slot_t secondNode = 0; secondNode < second.size(); secondNode++){
+			if (!(secondNodes & slotBit(secondNode)))
+				continue;
 			int currentEval = 0;
 			// consider static unit scores and then check if one unit has an advantage over the other
-			currentEval += CombatUtil::getStaticUnitScore(firstNode._unitType);
-			currentEval -= CombatUtil::getStaticUnitScore(secondNode._unitType);
-			currentEval += CombatUtil::evaluateStaticAdvantage(firstNode._unitType, secondNode._unitType);
+			currentEval += CombatUtil::lookupStaticUnitScore(first[firstNode]._unitType);
+			currentEval -= CombatUtil::lookupStaticUnitScore(second[secondNode]._unitType);
+			currentEval += CombatUtil::lookupStaticAdvantage(first[firstNode]._unitType, second[secondNode]._unitType);
 			eval += currentEval;
 		}
 	}
@@ -146,41 +627,143 @@ void BuildMinimax::initTree(int player){
 	// get base tree based on the race of player
 	BWAPI::Race race = (player == ENEMY) ?
 		BWAPI::Broodwar->enemy()->getRace() : BWAPI::Broodwar->self()->getRace();
-	_gameTreeState[player] = getBaseTree(race);
+	setGameTree(player, getBaseTreeStore(race));
+}
+
+void BuildMinimax::setGameTree(int player, const TechTreeStore & tree){
+	gameTrees[player] = tree;
+	gameTreesChanged = true;
+}
+
+void BuildMinimax::clearSearchHistory(SearchContext & search){
+	search._transpositionTable->clear();
+	for (int player = SELF; player < PLAYER_ID_SIZE; player++){
+		for (tech_slot_t slot = 0; slot < MAX_TECH_NODES; slot++)
+			search._historyScore[player][slot] = 0;
+	}
 }
 
-void BuildMinimax::updateTechTree(tech_count_map_t techUnits, int player){
+void BuildMinimax::addTechType(BWAPI::UnitType techUnitType, int player){
 	// if the tree hasn't been initialized yet, do it
-	if (_gameTreeState[player] == NULL_TREE){
+	if (gameTrees[player].isEmpty()){
 		initTree(player);
 	}
-	
-	for (auto & techCountPair : techUnits){
-		// for each tech unit, set its prereqs as obtained (in case some of them aren't visible to us)
-		setPrereqsObtained(BWAPI::UnitType(techCountPair.first), _gameTreeState[player]);
-		// set the units that can be produced from the building as obtained / obtainable
-		setBuildingNodeObtained(BWAPI::UnitType(techCountPair.first), _gameTreeState[player]);
+
+	// set its prereqs as obtained (in case some of them aren't visible to us)
+	gameTrees[player].setPrereqsObtained(techUnitType);
+	// set the units that can be produced from the building as obtained / obtainable
+	gameTrees[player].setBuildingNodeObtained(techUnitType);
+
+	// whenever either tree is updated, run analysis again (once per update, however many types were added)
+	gameTreesChanged = true;
+}
+
+void BuildMinimax::updateTargetTech(int frame){
+	gameTreesChanged = false;
+	if (searchWorker.isRunning()){
+		// the worker searches a copy of the trees, so they can keep changing while it runs
+		searchWorker.post(gameTrees[SELF], gameTrees[ENEMY], frame);
+	}
+	else {
+		publishTargetTech(searchNextBuilding(gameSearch, gameMCTS, gameTrees[SELF], gameTrees[ENEMY], DEFAULT_SEARCH_BUDGET));
+		gameSearch._stats._frame = frame;
+		recordSearchStats(gameSearch._stats);
+	}
+}
+
+bool BuildMinimax::updateTargetTechIfChanged(int frame){
+	if (!gameTreesChanged){
+		return false;
 	}
+	updateTargetTech(frame);
+	return true;
+}
+
+bool BuildMinimax::getGameTreesChanged(){
+	return gameTreesChanged;
+}
+
+void BuildMinimax::publishTargetTech(BWAPI::UnitType unitType){
+	targetTechId.store(unitType.getID());
+}
+
+void BuildMinimax::startSearchWorker(){
+	searchWorker.start();
+}
 
-	updateTargetTech(); // whenever either tree is updated, run analysis again
+void BuildMinimax::stopSearchWorker(){
+	searchWorker.stop();
 }
 
-void BuildMinimax::updateTargetTech(){
-	_targetTech = minimaxNextBuilding(DEFAULT_DEPTH);
+const BuildSearchWorker & BuildMinimax::getSearchWorker(){
+	return searchWorker;
 }
 
 bool BuildMinimax::prereqObtained(BWAPI::UnitType unitType){
-	return getImmediateParent(unitType, _gameTreeState[SELF])->_obtained;
+	return gameTrees[SELF].isParentObtained(unitType);
 }
 
 BWAPI::UnitType BuildMinimax::getParentType(BWAPI::UnitType unitType){
-	return getImmediateParent(unitType, _gameTreeState[SELF])->_unitType;
+	tech_slot_t parent = gameTrees[SELF].getImmediateParent(unitType);
+	return (parent != NULL_SLOT) ? gameTrees[SELF][parent]._unitType : BWAPI::UnitTypes::None;
 }
 
 BWAPI::UnitType BuildMinimax::getTargetTech(){
-	return _targetTech;
+	return BWAPI::UnitType(targetTechId.load());
 }
 
-TechTree BuildMinimax::getGameTree(int player){
-	return _gameTreeState[player];
-}
\ No newline at end of file
+const TechTreeStore & BuildMinimax::getGameTree(int player){
+	return gameTrees[player];
+}
+
+TranspositionTable & BuildMinimax::getTranspositionTable(){
+	return transpositionTable;
+}
+
+void BuildMinimax::recordSearchStats(const SearchStats & stats){
+	std::lock_guard<std::mutex> lock(searchLogMutex);
+	searchLog.push_back(stats);
+}
+
+BuildMinimax::SearchStats BuildMinimax::getLastSearchStats(){
+	std::lock_guard<std::mutex> lock(searchLogMutex);
+	return searchLog.empty() ? SearchStats() : searchLog.back();
+}
+
+std::vector<BuildMinimax::SearchStats> BuildMinimax::getSearchLog(){
+	std::lock_guard<std::mutex> lock(searchLogMutex);
+	return searchLog;
+}
+
+void BuildMinimax::clearSearchLog(){
+	std::lock_guard<std::mutex> lock(searchLogMutex);
+	searchLog.clear();
+}
+
+bool BuildMinimax::exportSearchStats(const std::string & path){
+	std::vector<SearchStats> log = getSearchLog();
+
+	long long totalWallTime = 0;
+	long long maxWallTime = 0;
+	unsigned long long totalNodes = 0;
+	for (auto & stats : log){
+		totalWallTime += stats._wallTime;
+		maxWallTime = (stats._wallTime > maxWallTime) ? stats._wallTime : maxWallTime;
+		totalNodes += stats._nodes;
+	}
+
+	std::ofstream file(path.c_str());
+	if (!file.is_open()){
+		return false;
+	}
+	file << "{\"searches\":" << log.size()
+		<< ",\"totalWallTimeUs\":" << totalWallTime
+		<< ",\"maxWallTimeUs\":" << maxWallTime
+		<< ",\"totalNodes\":" << totalNodes
+		<< ",\"log\":[";
+	for (size_t i = 0; i < log.size(); i++){
+		file << (i > 0 ? ",\n" : "\n") << log[i].toJson();
+	}
+	file << "]}\n";
+	return file.good();
+}
@@ -10,16 +10,38 @@
 
 #include "Debug.h"
 #include "TechTree.h"
+#include "TechTreeStore.h"
+#include "TranspositionTable.h"
+#include "SearchContext.h"
 
 namespace ProBot{
-	typedef std::pair<TechTree, int> tree_score_pair_t;
+	class BuildSearchWorker;
+	namespace BuildMCTS{
+		struct MCTSTree;
+	}
+
+	typedef std::pair<tech_slot_t, int> move_score_pair_t;
 	typedef int count_t;
 	typedef int unit_type_id_t;
 	typedef std::unordered_map<unit_type_id_t, count_t> tech_count_map_t;
 
 	namespace BuildMinimax{
-		// default search depth for minimax algorithm
-		const int DEFAULT_DEPTH = 2;
+		// time allowed for a time-budgeted search, in microseconds
+		const long long DEFAULT_SEARCH_BUDGET = 5000;
+		// shallowest book move that is used in place of a time-budgeted search (about the depth it completes in DEFAULT_SEARCH_BUDGET)
+		const int MIN_TIMED_BOOK_DEPTH = 6;
+		// number of nodes searched between checks of the timer
+		const unsigned int NODES_PER_TIME_CHECK = 64;
+		// number of threads used by a search unless set otherwise
+		const int DEFAULT_SEARCH_THREADS = 1;
+		// shallowest search that is split between threads (shallower ones finish before the threads would start)
+		const int MIN_PARALLEL_DEPTH = 3;
+
+		// the algorithms that can choose the target tech
+		enum SEARCH_BACKEND {
+			MINIMAX_BACKEND,
+			MCTS_BACKEND
+		};
 
 		// enumeration of players (assumes 1v1 match)
 		enum PLAYER_ID {
@@ -28,73 +50,231 @@ namespace ProBot{
 			PLAYER_ID_SIZE
 		};
 		
-		// the target technology to research, as determined by minimax
-		static BWAPI::UnitType _targetTech = BWAPI::UnitTypes::None;
-
-		// 
-		static TechTree _gameTreeState[2] = {NULL_TREE, NULL_TREE};
-
 		/**
-			Finds optimal techtree for given player by searching the game-tree to a given depth.
+			Finds optimal move for given player by searching the game-tree to a given depth.
 
-			@param depth - the remaining depth in which the game-tree will be searched
+			@param search - the search context, set up by initSearchState
+			@param depth - the remaining depth in which the game-tree will be searched (at most MAX_DEPTH)
 			@param player - the player for the current "turn"
-			@return a tree-int pair representing the optimal tech tree and its corresponding score
+			@return a move-int pair representing the optimal move (node slot) and its corresponding score
 		*/
-		tree_score_pair_t minimax(int depth, int player);
+		move_score_pair_t minimax(SearchContext & search, int depth, int player);
 		
 		/**
-			Finds optimal techtree for given player by searching the game-tree to a given depth.
+			Finds optimal move for given player by searching the game-tree to a given depth.
 			Alpha-beta pruning implementation.
 
-			@param depth - the remaining depth in which the game-tree will be searched
+			@param search - the search context, set up by initSearchState
+			@param depth - the remaining depth in which the game-tree will be searched (at most MAX_DEPTH)
 			@param player - the player for the current "turn"
 			@param alpha - the max value found so far for the maximizing node
 			@param beta - the min value found so far for the minimizing node
-			@return a tree-int pair representing the optimal tech tree and its corresponding score
+			@return a move-int pair representing the optimal move (node slot) and its corresponding score
+		*/
+		move_score_pair_t minimaxAlphaBeta(SearchContext & search, int depth, int player, int alpha, int beta);
+		/**
+			Finds optimal move for SELF with the root moves split between several threads.
+			The first move (in search order) is searched alone to get a score to beat, and the remaining moves are
+			then handed out to the threads one at a time. Each thread searches with a copy of the search context,
+			and all of them share its transposition table.
+			Returns the same move and score as minimaxAlphaBeta with a full window at the same depth.
+
+			@param search - the search context, set up by initSearchState
+			@param depth - the depth in which the game-tree will be searched (at most MAX_DEPTH)
+			@param numThreads - the number of threads to search with (including the calling thread)
+			@return a move-int pair representing the optimal move (node slot) and its corresponding score
 		*/
-		tree_score_pair_t minimaxAlphaBeta(int depth, int player, int alpha, int beta);
+		move_score_pair_t minimaxAlphaBetaParallel(SearchContext & search, int depth, int numThreads);
 		
 		/**
-			Finds the next building to invest in.
-			@param depth - the depth to which the game-tree will be searched.
+			Looks the trees up in the compiled opening books (searched to at least the given depth).
+			On a hit, the context's statistics are reset and marked as a book hit.
+			@return true if the move was found, false otherwise
+		*/
+		bool lookupBookMove(SearchContext & search, const TechTreeStore & self, const TechTreeStore & enemy, int minDepth,
+			BWAPI::UnitType & move);
+		/**
+			Finds the next building to invest in, checking the opening books first and searching copies of the current game trees on a miss.
+			@param search - the context to search with
+			@param depth - the depth to which the game-tree will be searched (at most MAX_DEPTH).
 			@return the result of the minimax as a UnitType.
 		*/
-		BWAPI::UnitType minimaxNextBuilding(int depth);
+		BWAPI::UnitType minimaxNextBuilding(SearchContext & search, int depth);
+		/**
+			Finds the next building to invest in, searching one ply deeper at a time until the time budget runs out.
+			A move found in the opening books is returned without searching, if it was searched to at least
+			MIN_TIMED_BOOK_DEPTH (or maxDepth, if that's shallower).
+			Moves are ordered by the best moves of the previous iteration, which are kept in the transposition table.
+			Iterations of at least MIN_PARALLEL_DEPTH are split between the number of threads set by setSearchThreads.
+			@param search - the context to search with
+			@param self, enemy - the trees to search copies of
+			@param budget - the time allowed for the search, in microseconds
+			@param maxDepth - the deepest iteration to search (at most MAX_DEPTH)
+			@return the result of the deepest completed iteration as a UnitType.
+		*/
+		BWAPI::UnitType minimaxNextBuildingTimed(SearchContext & search, const TechTreeStore & self, const TechTreeStore & enemy,
+			long long budget, int maxDepth = MAX_DEPTH);
+		/**
+			Sets the number of threads used by minimaxNextBuildingTimed (1 searches on the calling thread only).
+		*/
+		void setSearchThreads(int numThreads);
+		int getSearchThreads();
+		/**
+			Finds the next building to invest in with the backend set by setSearchBackend:
+			minimaxNextBuildingTimed, or BuildMCTS::mctsNextBuilding with the given tree.
+		*/
+		BWAPI::UnitType searchNextBuilding(SearchContext & search, BuildMCTS::MCTSTree & mcts, const TechTreeStore & self,
+			const TechTreeStore & enemy, long long budget);
+		/**
+			Sets the algorithm used by searches for the target tech (minimax unless set otherwise).
+		*/
+		void setSearchBackend(SEARCH_BACKEND backend);
+		SEARCH_BACKEND getSearchBackend();
+		/**
+			Sorts moves so that the ones most likely to cause a cut-off are searched first:
+			the stored best move, then killer moves, then by history and static score.
+		*/
+		void orderMoves(const SearchContext & search, int depth, int player, tech_slot_t hashMove, tech_slot_t * moves, int numMoves);
+		/**
+			Remembers a move that caused a cut-off, so that it is searched earlier in sibling and later searches.
+		*/
+		void recordCutoff(SearchContext & search, int depth, int player, tech_slot_t move);
+		/**
+			Copies the given trees into a search context.
+			Must be called before minimax or minimaxAlphaBeta.
+			If the layout of either tree has changed since the context's last search, any stored search data is cleared.
+		*/
+		void initSearchState(SearchContext & search, const TechTreeStore & self, const TechTreeStore & enemy);
+		/**
+			Clears a context's transposition table and move history, which refer to node slots of the searched trees.
+		*/
+		void clearSearchHistory(SearchContext & search);
 		/**
 			@param tree - the current tech tree
 			@return list of nodes that can be obtained from current tech tree
 		*/
-		std::vector<BWAPI::UnitType> generateMoves(TechTree tree);
+		std::vector<BWAPI::UnitType> generateMoves(const TechTreeStore & tree);
+		/**
+			Finds the nodes that can be obtained from a packed tree state.
+			A node can be obtained if its parent is obtained and no node of the same unit type is obtained.
+			Only the first such node of each unit type is returned.
+
+			@param tree - the tree that the masks refer to
+			@param obtained - the obtained nodes of the tree
+			@param blocked - nodes that can't be obtained
+			@param moves - output array with room for MAX_TECH_NODES slots
+			@return the number of moves written to the array
+		*/
+		int generateMoves(const TechTreeStore & tree, tech_mask_t obtained, tech_mask_t blocked, tech_slot_t * moves);
+		/**
+			Obtains a node in a packed tree state.
+			@return the bits that were changed, to be passed to unmakeMove
+		*/
+		tech_mask_t makeMove(const TechTreeStore & tree, tech_mask_t & obtained, tech_slot_t move);
+		/**
+			Restores a packed tree state to what it was before the corresponding makeMove.
+		*/
+		void unmakeMove(tech_mask_t & obtained, tech_mask_t delta);
+		/**
+			Obtains a node in a player's search state, updating the hash and the running evaluation.
+			@return the bits that were changed, to be passed to unmakeSearchMove
+		*/
+		tech_mask_t makeSearchMove(SearchContext & search, int player, tech_slot_t move);
+		/**
+			Undoes a makeSearchMove, restoring the search state, hash and running evaluation.
+		*/
+		void unmakeSearchMove(SearchContext & search, int player, tech_mask_t delta);
+		/**
+			Adds (sign = 1) or removes (sign = -1) the units of the given nodes to the running evaluation.
+			Each unit contributes its own score and its advantage against each unit of the other player.
+		*/
+		void updateEvaluation(SearchContext & search, int player, tech_mask_t nodes, int sign);
 		
 		// @TODO: ideally the advantage of one player over the other shouldn't be parallel, so that
 		// the game state evaluation could be the advantage of self - advantage of enemy
 		/**
 			Estimates a score for the current state of the game.
+			Equal to evaluateTree of the current search state, but computed from running totals in constant time.
 		*/
-		int evaluateGameState();
+		int evaluateGameState(const SearchContext & search);
 		/**
 			Estimates the advantage one tech tree has over the other.
 		*/
-		int evaluateTree(TechTree, TechTree);
+		int evaluateTree(const TechTreeStore &, const TechTreeStore &);
 		/**
-			Updates a tech tree by setting corresponding unit nodes as obtained for a given player.
+			Estimates the advantage one packed tree state has over the other.
 		*/
-		void updateTechTree(tech_count_map_t, int player);
+		int evaluateTree(const TechTreeStore & first, tech_mask_t firstObtained, const TechTreeStore & second, tech_mask_t secondObtained);
+		/**
+			Sets a newly seen tech unit type (and its prereqs) as obtained in a player's tree, and marks the trees as changed.
+			The target tech isn't updated until updateTargetTechIfChanged is called, so that several units seen
+			at once only cost one search.
+		*/
+		void addTechType(BWAPI::UnitType, int player);
 		/**
 			Based on race, sets the player's base tech tree to one of the three race trees.
 		*/
 		void initTree(int player);
 		/**
-			Sets the target tech to the result of a minimax call.
+			Replaces a player's tech tree, and marks the trees as changed.
+		*/
+		void setGameTree(int player, const TechTreeStore & tree);
+		/**
+			Sets the target tech to the result of a search with the selected backend (see searchNextBuilding).
+			If the search worker is running, the search is posted to it instead and the result is published later.
+			@param frame - the current frame, recorded in the search's statistics
+		*/
+		void updateTargetTech(int frame);
+		/**
+			Calls updateTargetTech if either tree has changed since the last call.
+			@return true if a search was started, false otherwise
+		*/
+		bool updateTargetTechIfChanged(int frame);
+		/**
+			Returns true if either tree has changed since the target tech was last updated.
 		*/
-		void updateTargetTech();
+		bool getGameTreesChanged();
+		/**
+			Sets the target tech returned by getTargetTech. Safe to call from any thread.
+		*/
+		void publishTargetTech(BWAPI::UnitType);
+		/**
+			Starts / stops the background thread that runs searches for updateTargetTech.
+		*/
+		void startSearchWorker();
+		void stopSearchWorker();
+		const BuildSearchWorker & getSearchWorker();
 		/**
 			Returns true if the parent node of the given unit is obtained.
 		*/
 		bool prereqObtained(BWAPI::UnitType);
 		BWAPI::UnitType getParentType(BWAPI::UnitType);
+		/**
+			Returns the latest published target tech. Never blocks, and is safe to call from any thread.
+		*/
 		BWAPI::UnitType getTargetTech();
-		TechTree getGameTree(int player);
+		const TechTreeStore & getGameTree(int player);
+		/**
+			Returns the table of searched states, which is kept between calls to updateTargetTech.
+		*/
+		TranspositionTable & getTranspositionTable();
+		/**
+			Adds the statistics of a search run for the game to the game's search log. Safe to call from any thread.
+		*/
+		void recordSearchStats(const SearchStats & stats);
+		/**
+			Returns the statistics of the latest search in the game's search log (all zero if there are none yet).
+		*/
+		SearchStats getLastSearchStats();
+		/**
+			Returns a copy of the game's search log, in the order the searches finished.
+		*/
+		std::vector<SearchStats> getSearchLog();
+		void clearSearchLog();
+		/**
+			Writes the game's search log, and totals over all of its searches, to a JSON file.
+			@return true if the file was written, false otherwise
+		*/
+		bool exportSearchStats(const std::string & path);
 	}
 }
@@ -0,0 +1,483 @@
+/**
+	BuildOrderScript.cpp
+	Build orders written in a text file, compiled into a packed binary cache that's mapped into memory when loaded.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "BuildOrderScript.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <windows.h>
+
+using namespace ProBot;
+using namespace BuildOrderScript;
+
+namespace {
+	// names of the flags in the text format, in the order of the Flag enumeration
+	const char * const FLAG_NAMES[] = {
+		"NONE",
+		"ALL_IN",
+		"INVADE",
+		"CLEAR_AREA",
+		"RETREAT",
+		"DEFEND_BASE",
+		"SCOUT_ENEMY",
+		"SCOUT_RESOURCES"
+	};
+	static_assert(sizeof(FLAG_NAMES) / sizeof(FLAG_NAMES[0]) == static_cast<int>(Flag::NUM_FLAGS), "every flag needs a name");
+
+	// names of the requirements in the text format, in the order of Build::ItemRequirements
+	const char * const REQUIREMENT_NAMES[] = {
+		"minerals",
+		"gas",
+		"supply",
+		"time"
+	};
+	static_assert(sizeof(REQUIREMENT_NAMES) / sizeof(REQUIREMENT_NAMES[0]) == Build::ItemRequirements::NUM_REQUIREMENTS, "every requirement needs a name");
+
+	const std::string MY_UNIT_PREFIX = "have:";
+	const std::string ENEMY_UNIT_PREFIX = "enemy:";
+	const std::string REQUIREMENT_SEPARATOR = ">=";
+
+	// a build item's type (one of Build::ItemTypes, or NUM_TYPES for flags) and ID
+	typedef std::pair<int, int> item_name_t;
+
+	/**
+		Returns the type and ID of every name that can start a line of a script.
+	*/
+	std::map<std::string, item_name_t> getItemNames(){
+		std::map<std::string, item_name_t> names;
+		for (int flag = 0; flag < static_cast<int>(Flag::NUM_FLAGS); flag++)
+			names[FLAG_NAMES[flag]] = item_name_t(Build::ItemTypes::NUM_TYPES, flag);
+		for (BWAPI::UnitType unitType : BWAPI::UnitTypes::allUnitTypes()){
+			if (unitType != BWAPI::UnitTypes::None && unitType != BWAPI::UnitTypes::Unknown)
+				names.insert(std::make_pair(unitType.getName(), item_name_t(Build::ItemTypes::UNIT, unitType.getID())));
+		}
+		for (BWAPI::TechType techType : BWAPI::TechTypes::allTechTypes()){
+			if (techType != BWAPI::TechTypes::None && techType != BWAPI::TechTypes::Unknown)
+				names.insert(std::make_pair(techType.getName(), item_name_t(Build::ItemTypes::TECH, techType.getID())));
+		}
+		for (BWAPI::UpgradeType upgradeType : BWAPI::UpgradeTypes::allUpgradeTypes()){
+			if (upgradeType != BWAPI::UpgradeTypes::None && upgradeType != BWAPI::UpgradeTypes::Unknown)
+				names.insert(std::make_pair(upgradeType.getName(), item_name_t(Build::ItemTypes::UPGRADE, upgradeType.getID())));
+		}
+		return names;
+	}
+
+	/**
+		Parses a whole string as a non-negative integer.
+	*/
+	bool parseCount(const std::string & text, int & value){
+		if (text.empty() || text.size() > 9 || text.find_first_not_of("0123456789") != std::string::npos)
+			return false;
+		value = std::atoi(text.c_str());
+		return true;
+	}
+
+	bool startsWith(const std::string & text, const std::string & prefix){
+		return text.compare(0, prefix.size(), prefix) == 0;
+	}
+
+	/**
+		Parses a requirement of the form key>=value.
+	*/
+	bool parseRequirement(const std::string & token, const std::map<std::string, item_name_t> & names, PackedRequirement & requirement){
+		size_t separator = token.find(REQUIREMENT_SEPARATOR);
+		if (separator == std::string::npos || !parseCount(token.substr(separator + REQUIREMENT_SEPARATOR.size()), requirement._value))
+			return false;
+		std::string key = token.substr(0, separator);
+		for (int i = 0; i < Build::ItemRequirements::NUM_REQUIREMENTS; i++){
+			if (key == REQUIREMENT_NAMES[i]){
+				requirement._key = i;
+				return true;
+			}
+		}
+		int offset = 0;
+		if (startsWith(key, MY_UNIT_PREFIX)){
+			offset = Build::MY_UNIT_COUNT_ID;
+			key = key.substr(MY_UNIT_PREFIX.size());
+		}
+		else if (startsWith(key, ENEMY_UNIT_PREFIX)){
+			offset = Build::ENEMY_UNIT_COUNT_ID;
+			key = key.substr(ENEMY_UNIT_PREFIX.size());
+		}
+		else
+			return false;
+		std::map<std::string, item_name_t>::const_iterator name = names.find(key);
+		if (name == names.end() || name->second.first != Build::ItemTypes::UNIT)
+			return false;
+		requirement._key = offset + name->second.second;
+		return true;
+	}
+
+	/**
+		Appends the bytes of the given records to the cache.
+	*/
+	template <typename T>
+	void appendRecords(std::vector<char> & cache, const std::vector<T> & records){
+		if (records.empty())
+			return;
+		const char * bytes = reinterpret_cast<const char *>(&records[0]);
+		cache.insert(cache.end(), bytes, bytes + records.size() * sizeof(T));
+	}
+
+	// the records of a cache follow its header
+	const PackedOrder * getOrders(const char * data){
+		return reinterpret_cast<const PackedOrder *>(data + sizeof(CacheHeader));
+	}
+	const PackedItem * getItems(const char * data){
+		const CacheHeader & header = *reinterpret_cast<const CacheHeader *>(data);
+		return reinterpret_cast<const PackedItem *>(getOrders(data) + header._numOrders);
+	}
+	const PackedRequirement * getRequirements(const char * data){
+		const CacheHeader & header = *reinterpret_cast<const CacheHeader *>(data);
+		return reinterpret_cast<const PackedRequirement *>(getItems(data) + header._numItems);
+	}
+	const char * getNames(const char * data){
+		const CacheHeader & header = *reinterpret_cast<const CacheHeader *>(data);
+		return reinterpret_cast<const char *>(getRequirements(data) + header._numRequirements);
+	}
+}
+
+unsigned long long BuildOrderScript::hashContent(const std::string & content){
+	unsigned long long hash = 14695981039346656037ULL;
+	for (size_t i = 0; i < content.size(); i++){
+		hash ^= static_cast<unsigned char>(content[i]);
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+bool BuildOrderScript::compileScript(const std::string & content, std::vector<char> & cache, std::string & error){
+	std::map<std::string, item_name_t> names = getItemNames();
+	std::vector<PackedOrder> orders;
+	std::vector<PackedItem> items;
+	std::vector<PackedRequirement> requirements;
+	std::string orderNames;
+
+	std::istringstream lines(content);
+	std::string line;
+	for (int lineNumber = 1; std::getline(lines, line); lineNumber++){
+		std::string where = "line " + std::to_string(lineNumber) + ": ";
+		line = line.substr(0, line.find('#'));
+		std::istringstream tokens(line);
+		std::string token;
+		if (!(tokens >> token))
+			continue;
+
+		// a name in brackets starts a new build order
+		if (token[0] == '['){
+			std::string extra;
+			if (token.size() < 3 || token[token.size() - 1] != ']' || (tokens >> extra)){
+				error = where + "expected a build order name in brackets";
+				return false;
+			}
+			std::string name = token.substr(1, token.size() - 2);
+			for (const PackedOrder & order : orders){
+				if (name == &orderNames[order._nameOffset]){
+					error = where + "build order " + name + " is defined twice";
+					return false;
+				}
+			}
+			PackedOrder order;
+			order._nameOffset = static_cast<int>(orderNames.size());
+			order._firstItem = static_cast<int>(items.size());
+			order._numItems = 0;
+			orders.push_back(order);
+			orderNames += name;
+			orderNames += '\0';
+			continue;
+		}
+		if (orders.empty()){
+			error = where + "build item before the first build order name";
+			return false;
+		}
+
+		std::map<std::string, item_name_t>::const_iterator name = names.find(token);
+		if (name == names.end()){
+			error = where + "unknown unit, tech, upgrade or flag " + token;
+			return false;
+		}
+		PackedItem item;
+		item._type = name->second.first;
+		item._id = name->second.second;
+		item._multiplicity = 1;
+		item._level = (item._type == Build::ItemTypes::UPGRADE) ? 1 : 0;
+		item._options = 0;
+		item._firstRequirement = static_cast<int>(requirements.size());
+		item._numRequirements = 0;
+		while (tokens >> token){
+			PackedRequirement requirement;
+			if (token == "persist" && item._type == Build::ItemTypes::UNIT)
+				item._options |= PERSIST_OPTION;
+			else if (token == "ordered")
+				item._options |= ORDERED_OPTION;
+			else if (token[0] == 'x' && item._type == Build::ItemTypes::UNIT && parseCount(token.substr(1), item._multiplicity)
+				&& item._multiplicity > 0)
+				continue;
+			else if (startsWith(token, "lvl") && item._type == Build::ItemTypes::UPGRADE && parseCount(token.substr(3), item._level)
+				&& item._level > 0)
+				continue;
+			else if (parseRequirement(token, names, requirement)){
+				requirements.push_back(requirement);
+				item._numRequirements++;
+			}
+			else {
+				error = where + "invalid option " + token;
+				return false;
+			}
+		}
+		items.push_back(item);
+		orders.back()._numItems++;
+	}
+
+	// keep the records that follow the names four byte aligned, in case the layout is extended
+	while (orderNames.size() % 4 != 0)
+		orderNames += '\0';
+
+	CacheHeader header;
+	header._magic = CACHE_MAGIC;
+	header._version = CACHE_VERSION;
+	header._contentHash = hashContent(content);
+	header._numOrders = static_cast<int>(orders.size());
+	header._numItems = static_cast<int>(items.size());
+	header._numRequirements = static_cast<int>(requirements.size());
+	header._namesSize = static_cast<int>(orderNames.size());
+	const char * headerBytes = reinterpret_cast<const char *>(&header);
+	cache.assign(headerBytes, headerBytes + sizeof(header));
+	appendRecords(cache, orders);
+	appendRecords(cache, items);
+	appendRecords(cache, requirements);
+	cache.insert(cache.end(), orderNames.begin(), orderNames.end());
+	return true;
+}
+
+std::string BuildOrderScript::formatBuildOrder(const std::string & name, const std::vector<BuildItem> & buildOrder){
+	std::ostringstream text;
+	text << "[" << name << "]\n";
+	for (const BuildItem & item : buildOrder){
+		if (item.isFlag()){
+			text << FLAG_NAMES[static_cast<int>(item.getFlag())];
+		}
+		else {
+			switch (item.getType()){
+			case Build::ItemTypes::UNIT:
+				text << item.getUnit().getName();
+				if (item.getMultiplicity() != 1)
+					text << " x" << item.getMultiplicity();
+				if (item.isPersist())
+					text << " persist";
+				break;
+			case Build::ItemTypes::TECH:
+				text << item.getTech().getName();
+				break;
+			case Build::ItemTypes::UPGRADE:
+				text << item.getUpgrade().getName() << " lvl" << item.getLevel();
+				break;
+			}
+			if (item.isOrdered())
+				text << " ordered";
+		}
+		for (const req_value_pair_t & requirement : item.getRequirements()){
+			text << " ";
+			if (requirement.first >= Build::ENEMY_UNIT_COUNT_ID)
+				text << ENEMY_UNIT_PREFIX << BWAPI::UnitType(requirement.first - Build::ENEMY_UNIT_COUNT_ID).getName();
+			else if (requirement.first >= Build::MY_UNIT_COUNT_ID)
+				text << MY_UNIT_PREFIX << BWAPI::UnitType(requirement.first - Build::MY_UNIT_COUNT_ID).getName();
+			else
+				text << REQUIREMENT_NAMES[requirement.first];
+			text << REQUIREMENT_SEPARATOR << requirement.second;
+		}
+		text << "\n";
+	}
+	return text.str();
+}
+
+BuildItem LoadedBuildOrder::getItem(int index) const{
+	const PackedItem & packed = _items[index];
+	std::vector<req_value_pair_t> requirements;
+	for (int i = 0; i < packed._numRequirements; i++){
+		const PackedRequirement & requirement = _requirements[packed._firstRequirement + i];
+		requirements.push_back(std::make_pair(requirement._key, requirement._value));
+	}
+	BuildItem item;
+	switch (packed._type){
+	case Build::ItemTypes::UNIT:
+		item = BuildItem{ BWAPI::UnitType(packed._id), packed._multiplicity, (packed._options & PERSIST_OPTION) != 0, requirements };
+		break;
+	case Build::ItemTypes::TECH:
+		item = BuildItem{ BWAPI::TechType(packed._id), requirements };
+		break;
+	case Build::ItemTypes::UPGRADE:
+		item = BuildItem{ BWAPI::UpgradeType(packed._id), packed._level, requirements };
+		break;
+	default:
+		item = BuildItem{ static_cast<Flag>(packed._id), requirements };
+		break;
+	}
+	item.setOrdered((packed._options & ORDERED_OPTION) != 0);
+	return item;
+}
+
+std::vector<BuildItem> LoadedBuildOrder::toVector() const{
+	std::vector<BuildItem> items;
+	items.reserve(_size);
+	for (int i = 0; i < _size; i++)
+		items.push_back(getItem(i));
+	return items;
+}
+
+BuildOrderLibrary::BuildOrderLibrary()
+	: _data(NULL), _size(0), _file(NULL), _mapping(NULL){
+}
+
+BuildOrderLibrary::~BuildOrderLibrary(){
+	clear();
+}
+
+void BuildOrderLibrary::clear(){
+	if (_mapping){
+		UnmapViewOfFile(_data);
+		CloseHandle(_mapping);
+	}
+	if (_file)
+		CloseHandle(_file);
+	_file = NULL;
+	_mapping = NULL;
+	_data = NULL;
+	_size = 0;
+	_buffer.clear();
+}
+
+bool BuildOrderLibrary::setData(const char * data, size_t size){
+	_data = data;
+	_size = size;
+	if (size < sizeof(CacheHeader))
+		return false;
+	const CacheHeader & header = getHeader();
+	if (header._magic != CACHE_MAGIC || header._version != CACHE_VERSION || header._numOrders < 0 || header._numItems < 0
+		|| header._numRequirements < 0 || header._namesSize < 0)
+		return false;
+	size_t expected = sizeof(CacheHeader) + header._numOrders * sizeof(PackedOrder) + header._numItems * sizeof(PackedItem)
+		+ header._numRequirements * sizeof(PackedRequirement) + header._namesSize;
+	if (size != expected || (header._namesSize > 0 && getNames(data)[header._namesSize - 1] != '\0'))
+		return false;
+
+	// check every index, so that a damaged cache can't be read out of bounds
+	for (int i = 0; i < header._numOrders; i++){
+		const PackedOrder & order = getOrders(data)[i];
+		if (order._nameOffset < 0 || order._nameOffset >= header._namesSize || order._firstItem < 0 || order._numItems < 0
+			|| order._firstItem + order._numItems > header._numItems)
+			return false;
+	}
+	for (int i = 0; i < header._numItems; i++){
+		const PackedItem & item = getItems(data)[i];
+		if (item._type < 0 || item._type > Build::ItemTypes::NUM_TYPES || item._firstRequirement < 0 || item._numRequirements < 0
+			|| item._firstRequirement + item._numRequirements > header._numRequirements)
+			return false;
+	}
+	return true;
+}
+
+bool BuildOrderLibrary::mapFile(const std::string & path){
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	_file = file;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size) || size.QuadPart < static_cast<long long>(sizeof(CacheHeader))){
+		clear();
+		return false;
+	}
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!mapping){
+		clear();
+		return false;
+	}
+	const char * view = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (!view){
+		CloseHandle(mapping);
+		clear();
+		return false;
+	}
+	_mapping = mapping;
+	if (!setData(view, static_cast<size_t>(size.QuadPart))){
+		clear();
+		return false;
+	}
+	return true;
+}
+
+bool BuildOrderLibrary::load(const std::string & path, std::string & error){
+	clear();
+	std::ifstream script(path.c_str(), std::ios::binary);
+	if (!script.is_open()){
+		error = "can't open " + path;
+		return false;
+	}
+	std::string content((std::istreambuf_iterator<char>(script)), std::istreambuf_iterator<char>());
+	unsigned long long hash = hashContent(content);
+
+	// use the cache if it was compiled from this content
+	std::string cachePath = path + CACHE_SUFFIX;
+	if (mapFile(cachePath) && getHeader()._contentHash == hash)
+		return true;
+	clear();
+
+	std::vector<char> cache;
+	if (!compileScript(content, cache, error))
+		return false;
+	std::ofstream cacheFile(cachePath.c_str(), std::ios::binary | std::ios::trunc);
+	if (cacheFile.is_open()){
+		cacheFile.write(&cache[0], cache.size());
+		cacheFile.close();
+		if (mapFile(cachePath) && getHeader()._contentHash == hash)
+			return true;
+		clear();
+	}
+	// the cache can't be written (such as from a read-only folder), so read from the compiled copy instead
+	_buffer.swap(cache);
+	return setData(&_buffer[0], _buffer.size());
+}
+
+const CacheHeader & BuildOrderLibrary::getHeader() const{
+	return *reinterpret_cast<const CacheHeader *>(_data);
+}
+
+int BuildOrderLibrary::size() const{
+	return _data ? getHeader()._numOrders : 0;
+}
+
+LoadedBuildOrder BuildOrderLibrary::getBuildOrder(int index) const{
+	const PackedOrder & order = getOrders(_data)[index];
+	LoadedBuildOrder buildOrder;
+	buildOrder._name = getNames(_data) + order._nameOffset;
+	buildOrder._items = getItems(_data) + order._firstItem;
+	buildOrder._size = order._numItems;
+	buildOrder._requirements = getRequirements(_data);
+	return buildOrder;
+}
+
+bool BuildOrderLibrary::findBuildOrder(const std::string & name, LoadedBuildOrder & buildOrder) const{
+	for (int i = 0; i < size(); i++){
+		LoadedBuildOrder candidate = getBuildOrder(i);
+		if (name == candidate._name){
+			buildOrder = candidate;
+			return true;
+		}
+	}
+	return false;
+}
+
+unsigned long long BuildOrderLibrary::getContentHash() const{
+	return _data ? getHeader()._contentHash : 0;
+}
+
+bool BuildOrderLibrary::isMapped() const{
+	return _mapping != NULL;
+}
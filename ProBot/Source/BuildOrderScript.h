@@ -0,0 +1,168 @@
+/**
+	BuildOrderScript.h
+	Build orders written in a text file, compiled into a packed binary cache that's mapped into memory when loaded.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+#include <BWAPI.h>
+#include <string>
+#include <vector>
+#include "BuildItem.h"
+
+namespace ProBot{
+	/**
+		The text format has one build item per line, under the name of its build order in brackets. '#' starts a comment.
+
+			[DT_RUSH]
+			Protoss_Probe x4
+			Protoss_Pylon
+			SCOUT_ENEMY
+			Protoss_Dark_Templar x2 persist
+			Singularity_Charge lvl1
+			Protoss_Gateway ordered supply>=20 time>=2000 minerals>=400 gas>=100 have:Protoss_Gateway>=1 enemy:Zerg_Spire>=1
+
+		The first word is a unit, tech or upgrade type name (as returned by getName) or a flag name.
+		The rest are optional: xN (number of units), lvlN (upgrade level), persist, ordered (see BuildItem::setOrdered),
+		and requirements (supply is in BWAPI's doubled units and time is a frame count).
+	*/
+	namespace BuildOrderScript{
+		// file that the bot loads its build orders from, and the build order it plays from the file
+		const std::string DEFAULT_SCRIPT_PATH = "bwapi-data/read/build_orders.txt";
+		const std::string DEFAULT_BUILD_ORDER = "BASIC_DRAGOON";
+		// suffix of the binary cache kept next to a script
+		const std::string CACHE_SUFFIX = ".cache";
+		// "PBBO", the first four bytes of a cache
+		const unsigned int CACHE_MAGIC = 0x4F424250;
+		// changed whenever the layout of the packed records changes, so that old caches are recompiled
+		const unsigned int CACHE_VERSION = 1;
+
+		// bits of PackedItem::_options
+		const int PERSIST_OPTION = 1;
+		const int ORDERED_OPTION = 2;
+
+		/**
+			Start of a cache: the hash of the script it was compiled from and the number of each record that follows.
+			The records are stored in order (build orders, items, requirements, then names), all four byte aligned.
+		*/
+		struct CacheHeader {
+			unsigned int _magic;
+			unsigned int _version;
+			unsigned long long _contentHash;
+			int _numOrders;
+			int _numItems;
+			int _numRequirements;
+			int _namesSize;
+		};
+
+		struct PackedOrder {
+			// offset of the null terminated name in the names
+			int _nameOffset;
+			int _firstItem;
+			int _numItems;
+		};
+
+		struct PackedItem {
+			// ID of the unit type, tech type, upgrade type or flag
+			int _id;
+			// one of Build::ItemTypes, or NUM_TYPES for flags
+			int _type;
+			int _multiplicity;
+			int _level;
+			int _options;
+			int _firstRequirement;
+			int _numRequirements;
+		};
+
+		struct PackedRequirement {
+			// Build::ItemRequirements value, or a unit type ID offset by Build::MY_UNIT_COUNT_ID / ENEMY_UNIT_COUNT_ID
+			int _key;
+			int _value;
+		};
+
+		/**
+			A build order in a loaded library. Its records belong to the library, so it's only valid until the library is reloaded.
+		*/
+		struct LoadedBuildOrder {
+			const char * _name;
+			const PackedItem * _items;
+			int _size;
+			// every requirement of the library, which the items index into
+			const PackedRequirement * _requirements;
+
+			/**
+				Returns the build item at the given position, interning its requirements.
+			*/
+			BuildItem getItem(int index) const;
+			std::vector<BuildItem> toVector() const;
+		};
+
+		/**
+			The build orders of one script, read from its cache.
+		*/
+		class BuildOrderLibrary {
+			// the cache is either mapped from its file (see isMapped) or copied into _buffer
+			const char * _data;
+			size_t _size;
+			std::vector<char> _buffer;
+			void * _file;
+			void * _mapping;
+
+			/**
+				Points the library at the given cache, if its records fit in its size.
+			*/
+			bool setData(const char * data, size_t size);
+			bool mapFile(const std::string & path);
+			const CacheHeader & getHeader() const;
+
+			// the library owns its mapping, so it can't be copied
+			BuildOrderLibrary(const BuildOrderLibrary &);
+			BuildOrderLibrary & operator=(const BuildOrderLibrary &);
+
+		public:
+			BuildOrderLibrary();
+			~BuildOrderLibrary();
+			/**
+				Loads the build orders of the given script, replacing any already loaded. Uses the cache next to the script
+				if it was compiled from the same content, and otherwise compiles the script and rewrites the cache.
+				Called between games to pick up changes to the script without rebuilding the dll.
+				@param path - path of the script
+				@param error - set to a description of the problem if the script can't be loaded
+				@return true if the build orders were loaded, false otherwise (the library is then empty)
+			*/
+			bool load(const std::string & path, std::string & error);
+			void clear();
+
+			int size() const;
+			LoadedBuildOrder getBuildOrder(int index) const;
+			/**
+				Finds the build order with the given name.
+				@return true if it was found, false otherwise
+			*/
+			bool findBuildOrder(const std::string & name, LoadedBuildOrder & buildOrder) const;
+			unsigned long long getContentHash() const;
+			/**
+				Returns true if the build orders are read straight from the mapped cache file.
+			*/
+			bool isMapped() const;
+		};
+
+		/**
+			Returns the 64-bit FNV-1a hash of a script's content, which its cache is keyed by.
+		*/
+		unsigned long long hashContent(const std::string & content);
+		/**
+			Compiles a script into the binary cache image.
+			@param error - set to the line and description of the first problem found
+			@return true if the script was compiled, false otherwise
+		*/
+		bool compileScript(const std::string & content, std::vector<char> & cache, std::string & error);
+		/**
+			Writes a build order in the text format, for example to move one of the BuildOrders constants into a script.
+		*/
+		std::string formatBuildOrder(const std::string & name, const std::vector<BuildItem> & buildOrder);
+	}
+}
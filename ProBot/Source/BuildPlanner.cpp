@@ -0,0 +1,289 @@
+/**
+	BuildPlanner.cpp
+	Depth-first branch and bound search for the quickest build order that reaches a set of goal units.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "BuildPlanner.h"
+#include "Timer.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+using namespace ProBot;
+using namespace BuildPlanner;
+using namespace BuildSimulator;
+
+namespace {
+	// number of expanded states between checks of the time budget
+	const int NODES_PER_TIME_CHECK = 64;
+	// spare supply (doubled) above which another pylon isn't worth considering
+	const int PYLON_SUPPLY_SLACK = 16;
+
+	/**
+		A candidate item at one level of the search, along with the values used to order the candidates.
+	*/
+	struct PlanCandidate {
+		int _simType;
+		int _lowerBound;
+		bool _isTech;
+		int _startFrame;
+	};
+
+	/**
+		The state of a planning search, shared by every level of the recursion.
+	*/
+	struct PlannerSearch {
+		BuildGoal _goal;
+		// maximum number of each type that the planner may start
+		int _maxCount[NUM_SIM_TYPES];
+		// types that may appear in the plan, and the ones that lead towards the goal (as opposed to economy)
+		sim_mask_t _candidates;
+		sim_mask_t _techTypes;
+		int _plan[MAX_PLAN_LENGTH];
+		int _bestPlan[MAX_PLAN_LENGTH];
+		int _bestLength;
+		int _bestMakespan;
+		int _nodes;
+		int _nextTimeCheck;
+		Timer _timer;
+		long long _budget;
+		bool _aborted;
+	};
+
+	/**
+		Adds the type, its producer and its prereqs (recursively) to the mask.
+	*/
+	void addRequiredTypes(sim_mask_t & mask, int simType){
+		if (mask & (1u << simType))
+			return;
+		mask |= 1u << simType;
+		const SimTypeData & data = getTypeData(simType);
+		addRequiredTypes(mask, data._producer);
+		for (int prereq = 0; prereq < NUM_SIM_TYPES; prereq++){
+			if (data._prereqs & (1u << prereq))
+				addRequiredTypes(mask, prereq);
+		}
+	}
+
+	/**
+		Returns the shortest time to complete the type from scratch, counting any of its producer / prereqs that aren't started yet.
+	*/
+	int getChainTime(const SimState & state, int simType){
+		const SimTypeData & data = getTypeData(simType);
+		int longestPrereq = 0;
+		if (state._started[data._producer] == 0)
+			longestPrereq = getChainTime(state, data._producer);
+		for (int prereq = 0; prereq < NUM_SIM_TYPES; prereq++){
+			if ((data._prereqs & (1u << prereq)) && state._started[prereq] == 0)
+				longestPrereq = std::max(longestPrereq, getChainTime(state, prereq));
+		}
+		return longestPrereq + data._buildTime;
+	}
+
+	/**
+		Returns the frame on which the last goal unit finishes, or NEVER if not enough goal units have been started.
+	*/
+	int getGoalMakespan(const SimState & state, const BuildGoal & goal){
+		for (int simType = 0; simType < NUM_SIM_TYPES; simType++){
+			if (state._started[simType] < goal._count[simType])
+				return NEVER;
+		}
+		int makespan = state._frame;
+		for (int i = 0; i < state._numEvents; i++){
+			if (goal._count[state._events[i]._type] > 0)
+				makespan = std::max(makespan, state._events[i]._finishFrame);
+		}
+		return makespan;
+	}
+
+	/**
+		Returns a lower bound on the frame on which the goal can be reached from the state.
+	*/
+	int getLowerBound(const SimState & state, const BuildGoal & goal){
+		int bound = state._frame;
+		for (int simType = 0; simType < NUM_SIM_TYPES; simType++){
+			if (state._started[simType] < goal._count[simType])
+				bound = std::max(bound, state._frame + getChainTime(state, simType));
+		}
+		// goal units already in production can't finish any sooner
+		for (int i = 0; i < state._numEvents; i++){
+			if (goal._count[state._events[i]._type] > 0)
+				bound = std::max(bound, state._events[i]._finishFrame);
+		}
+		return bound;
+	}
+
+	/**
+		Returns true if the planner should consider starting the type from the state.
+	*/
+	bool isCandidate(const PlannerSearch & search, const SimState & state, int simType){
+		if (!(search._candidates & (1u << simType)) || state._started[simType] >= search._maxCount[simType])
+			return false;
+		if (getUnitType(simType) == BWAPI::UnitTypes::Protoss_Pylon){
+			// only build a pylon when the supply is running out, or when there is none to power buildings
+			int supplyTotal = state._supplyTotal;
+			for (int i = 0; i < state._numEvents; i++)
+				supplyTotal += getTypeData(state._events[i]._type)._supplyProvided;
+			return supplyTotal - state._supplyUsed < PYLON_SUPPLY_SLACK || state._started[simType] == 0;
+		}
+		return true;
+	}
+
+	/**
+		Orders candidates by lower bound, then those leading to the goal, then by how soon they can start.
+	*/
+	bool isBetterCandidate(const PlanCandidate & first, const PlanCandidate & second){
+		if (first._lowerBound != second._lowerBound)
+			return first._lowerBound < second._lowerBound;
+		if (first._isTech != second._isTech)
+			return first._isTech;
+		return first._startFrame < second._startFrame;
+	}
+
+	void searchPlan(PlannerSearch & search, const SimState & state, int depth){
+		int makespan = getGoalMakespan(state, search._goal);
+		if (makespan != NEVER){
+			if (makespan < search._bestMakespan){
+				search._bestMakespan = makespan;
+				search._bestLength = depth;
+				memcpy(search._bestPlan, search._plan, depth * sizeof(int));
+			}
+			return;
+		}
+		if (depth >= MAX_PLAN_LENGTH)
+			return;
+
+		// simulate each candidate once to order them, and then again when searching it
+		PlanCandidate candidates[NUM_SIM_TYPES];
+		int numCandidates = 0;
+		for (int simType = 0; simType < NUM_SIM_TYPES; simType++){
+			if (!isCandidate(search, state, simType))
+				continue;
+			SimState child = state;
+			search._nodes++;
+			if (!startItem(child, simType))
+				continue;
+			PlanCandidate & candidate = candidates[numCandidates++];
+			candidate._simType = simType;
+			candidate._lowerBound = getLowerBound(child, search._goal);
+			candidate._isTech = (search._techTypes & (1u << simType)) != 0;
+			candidate._startFrame = child._frame;
+		}
+		std::sort(candidates, candidates + numCandidates, isBetterCandidate);
+
+		for (int i = 0; i < numCandidates; i++){
+			if (search._nodes >= search._nextTimeCheck){
+				search._nextTimeCheck = search._nodes + NODES_PER_TIME_CHECK;
+				search._aborted = search._timer.getElapsedMicroseconds() > search._budget;
+			}
+			if (search._aborted)
+				return;
+			// candidates are sorted by their bound, so none of the rest can do better either
+			if (candidates[i]._lowerBound >= search._bestMakespan)
+				return;
+			SimState child = state;
+			startItem(child, candidates[i]._simType);
+			search._plan[depth] = candidates[i]._simType;
+			searchPlan(search, child, depth + 1);
+		}
+	}
+}
+
+BuildGoal::BuildGoal(){
+	memset(_count, 0, sizeof(_count));
+}
+
+bool BuildGoal::add(BWAPI::UnitType unitType, int count){
+	int simType = BuildSimulator::getSimType(unitType);
+	if (simType == NULL_SIM_TYPE)
+		return false;
+	_count[simType] = static_cast<unsigned char>(std::min(_count[simType] + count, static_cast<int>(UCHAR_MAX)));
+	return true;
+}
+
+bool BuildGoal::isEmpty() const{
+	for (int simType = 0; simType < NUM_SIM_TYPES; simType++){
+		if (_count[simType] > 0)
+			return false;
+	}
+	return true;
+}
+
+BuildPlan BuildPlanner::planBuildOrder(const SimState & start, const BuildGoal & goal, long long budget){
+	PlannerSearch search;
+	search._goal = goal;
+	search._bestLength = 0;
+	search._bestMakespan = INT_MAX;
+	search._nodes = 0;
+	search._nextTimeCheck = NODES_PER_TIME_CHECK;
+	search._budget = budget;
+	search._aborted = false;
+	search._timer.start();
+
+	// the goal units and everything needed to make them
+	sim_mask_t required = 0;
+	for (int simType = 0; simType < NUM_SIM_TYPES; simType++){
+		if (goal._count[simType] > 0)
+			addRequiredTypes(required, simType);
+	}
+	int probe = BuildSimulator::getSimType(BWAPI::UnitTypes::Protoss_Probe);
+	int pylon = BuildSimulator::getSimType(BWAPI::UnitTypes::Protoss_Pylon);
+	int assimilator = BuildSimulator::getSimType(BWAPI::UnitTypes::Protoss_Assimilator);
+	search._techTypes = required & ~(1u << probe);
+	search._candidates = required | 1u << probe | 1u << pylon;
+
+	for (int simType = 0; simType < NUM_SIM_TYPES; simType++){
+		// prereqs are only needed once, goal units as many times as asked for
+		search._maxCount[simType] = std::max(static_cast<int>(start._started[simType]), static_cast<int>(goal._count[simType]));
+		if (required & (1u << simType))
+			search._maxCount[simType] = std::max(search._maxCount[simType], 1);
+		if (getTypeData(simType)._gasPrice > 0 && (required & (1u << simType)))
+			search._candidates |= 1u << assimilator;
+	}
+	// allow a few more producers, so that goal units can be made in parallel
+	for (int simType = 0; simType < NUM_SIM_TYPES; simType++){
+		int producer = getTypeData(simType)._producer;
+		int unitsNeeded = goal._count[simType] - start._started[simType];
+		if (unitsNeeded > 1 && producer != probe)
+			search._maxCount[producer] = std::max(search._maxCount[producer], std::min(unitsNeeded, MAX_PLANNED_PRODUCERS));
+	}
+	search._maxCount[assimilator] = std::max(static_cast<int>(start._started[assimilator]), 1);
+	search._maxCount[probe] = start._started[probe] + MAX_EXTRA_WORKERS;
+	search._maxCount[pylon] = UCHAR_MAX;
+
+	searchPlan(search, start, 0);
+
+	BuildPlan plan;
+	plan._makespan = (search._bestMakespan == INT_MAX) ? NEVER : search._bestMakespan;
+	plan._nodes = search._nodes;
+	plan._complete = !search._aborted;
+	for (int i = 0; i < search._bestLength; i++){
+		// merge consecutive units of the same type, the same way the hand-written build orders are written
+		int multiplicity = 1;
+		while (i + 1 < search._bestLength && search._bestPlan[i + 1] == search._bestPlan[i]){
+			multiplicity++;
+			i++;
+		}
+		plan._buildOrder.push_back(BuildItem{ getUnitType(search._bestPlan[i]), multiplicity });
+	}
+	return plan;
+}
+
+int BuildPlanner::simulateBuildOrder(const SimState & start, const BuildGoal & goal, const std::vector<BuildItem> & buildOrder){
+	SimState state = start;
+	for (const BuildItem & item : buildOrder){
+		if (item.isFlag() || item.getType() != Build::ItemTypes::UNIT)
+			continue;
+		int simType = BuildSimulator::getSimType(item.getUnit());
+		if (simType == NULL_SIM_TYPE)
+			continue;
+		for (int i = 0; i < item.getMultiplicity(); i++){
+			if (!startItem(state, simType))
+				return NEVER;
+		}
+	}
+	return getGoalMakespan(state, goal);
+}
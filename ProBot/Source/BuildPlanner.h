@@ -0,0 +1,70 @@
+/**
+	BuildPlanner.h
+	Depth-first branch and bound search for the quickest build order that reaches a set of goal units.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+#include <BWAPI.h>
+#include "BuildItem.h"
+#include "BuildSimulator.h"
+
+namespace ProBot{
+	namespace BuildPlanner{
+		// maximum number of items in a planned build order
+		const int MAX_PLAN_LENGTH = 48;
+		// default amount of time given to a planning search, in microseconds
+		const long long DEFAULT_PLAN_BUDGET = 1000;
+		// maximum number of probes the planner adds on top of the ones already started
+		const int MAX_EXTRA_WORKERS = 12;
+		// maximum number of producers of one type the planner builds to make the goal units in parallel
+		const int MAX_PLANNED_PRODUCERS = 3;
+
+		/**
+			The number of units of each simulator type that must be owned (including the ones owned already) at the end of the build order.
+		*/
+		struct BuildGoal {
+			unsigned char _count[BuildSimulator::NUM_SIM_TYPES];
+
+			BuildGoal();
+			/**
+				Requires at least the given number of the unit type (on top of any already required).
+				@return false if the unit type isn't known to the simulator
+			*/
+			bool add(BWAPI::UnitType unitType, int count = 1);
+			bool isEmpty() const;
+		};
+
+		/**
+			The result of a planning search.
+		*/
+		struct BuildPlan {
+			// the build order, with consecutive units of the same type merged into one item
+			std::vector<BuildItem> _buildOrder;
+			// frame on which the last goal unit finishes, or BuildSimulator::NEVER if no plan was found
+			int _makespan;
+			// number of simulated states expanded
+			int _nodes;
+			// true if the search finished within its budget, so no faster plan exists among the builds it considers
+			// (each type capped by the goal, MAX_EXTRA_WORKERS and MAX_PLANNED_PRODUCERS, and pylons only within
+			// PYLON_SUPPLY_SLACK of the supply cap); a faster one may still exist under the simulator outside those limits
+			bool _complete;
+		};
+
+		/**
+			Finds the build order from the given state that finishes the goal units soonest.
+			The search stops after the given budget and returns the best build order found so far.
+			@param start - the state to plan from
+			@param goal - the units that must be completed at the end of the build order
+			@param budget - the time budget, in microseconds
+		*/
+		BuildPlan planBuildOrder(const BuildSimulator::SimState & start, const BuildGoal & goal, long long budget = DEFAULT_PLAN_BUDGET);
+		/**
+			Returns the frame on which the goal is reached by starting the given build order, or BuildSimulator::NEVER if it can't be.
+		*/
+		int simulateBuildOrder(const BuildSimulator::SimState & start, const BuildGoal & goal, const std::vector<BuildItem> & buildOrder);
+	}
+}
@@ -0,0 +1,117 @@
+/**
+	BuildQueue.cpp
+	A player's build order, stored as a ring buffer of build items.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "BuildQueue.h"
+
+using namespace ProBot;
+
+// capacity of a queue's first buffer (enough for most hand-written build orders)
+static const int INITIAL_CAPACITY = 64;
+
+BuildQueue::BuildQueue()
+	: _head(0), _size(0){
+}
+
+BuildQueue::BuildQueue(const std::vector<BuildItem> & buildOrder)
+	: _head(0), _size(0){
+	*this = buildOrder;
+}
+
+BuildQueue & BuildQueue::operator=(const std::vector<BuildItem> & buildOrder){
+	int capacity = INITIAL_CAPACITY;
+	while (capacity < static_cast<int>(buildOrder.size()))
+		capacity *= 2;
+	if (static_cast<int>(_items.size()) < capacity)
+		_items.resize(capacity);
+	for (size_t i = 0; i < buildOrder.size(); i++)
+		_items[i] = buildOrder[i];
+	_head = 0;
+	_size = static_cast<int>(buildOrder.size());
+	return *this;
+}
+
+void BuildQueue::grow(){
+	int capacity = _items.empty() ? INITIAL_CAPACITY : 2 * static_cast<int>(_items.size());
+	std::vector<BuildItem> items(capacity);
+	for (int i = 0; i < _size; i++)
+		items[i] = at(i);
+	_items.swap(items);
+	_head = 0;
+}
+
+int BuildQueue::getSlot(int index) const{
+	return (_head + index) & (static_cast<int>(_items.size()) - 1);
+}
+
+int BuildQueue::size() const{
+	return _size;
+}
+
+bool BuildQueue::isEmpty() const{
+	return _size == 0;
+}
+
+BuildItem & BuildQueue::at(int index){
+	return _items[getSlot(index)];
+}
+
+const BuildItem & BuildQueue::at(int index) const{
+	return _items[getSlot(index)];
+}
+
+BuildItem & BuildQueue::front(){
+	return _items[_head];
+}
+
+const BuildItem & BuildQueue::front() const{
+	return _items[_head];
+}
+
+void BuildQueue::pushFront(const BuildItem & item){
+	if (_size == static_cast<int>(_items.size()))
+		grow();
+	_head = (_head - 1) & (static_cast<int>(_items.size()) - 1);
+	_items[_head] = item;
+	_size++;
+}
+
+void BuildQueue::pushBack(const BuildItem & item){
+	if (_size == static_cast<int>(_items.size()))
+		grow();
+	_items[getSlot(_size)] = item;
+	_size++;
+}
+
+void BuildQueue::popFront(){
+	if (_size == 0)
+		return;
+	_head = getSlot(1);
+	_size--;
+}
+
+void BuildQueue::erase(int index){
+	if (index < 0 || index >= _size)
+		return;
+	// shift the items in front of it back by one, over the removed item
+	for (int i = index; i > 0; i--)
+		at(i) = at(i - 1);
+	popFront();
+}
+
+void BuildQueue::clear(){
+	_head = 0;
+	_size = 0;
+}
+
+std::vector<BuildItem> BuildQueue::toVector() const{
+	std::vector<BuildItem> items;
+	items.reserve(_size);
+	for (int i = 0; i < _size; i++)
+		items.push_back(at(i));
+	return items;
+}
@@ -0,0 +1,69 @@
+/**
+	BuildQueue.h
+	A player's build order, stored as a ring buffer of build items.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+#include <vector>
+#include "BuildItem.h"
+
+namespace ProBot{
+	/**
+		A double-ended queue of build items in one contiguous ring buffer, so that the next item can be removed and
+		items (such as pylons and rebuilt buildings) can be put in front of it in constant time.
+		Item references stay valid until an item is added to a full queue.
+	*/
+	class BuildQueue {
+		// ring buffer with a power of two capacity, so that indices wrap with a mask
+		std::vector<BuildItem> _items;
+		int _head;
+		int _size;
+
+		/**
+			Doubles the capacity of the buffer, moving the items to the start of the new one.
+		*/
+		void grow();
+		int getSlot(int index) const;
+
+	public:
+		BuildQueue();
+		/**
+			Constructs a queue holding the given build order, such as one of the BuildOrders constants.
+		*/
+		BuildQueue(const std::vector<BuildItem> & buildOrder);
+		/**
+			Replaces the items of the queue with the given build order.
+		*/
+		BuildQueue & operator=(const std::vector<BuildItem> & buildOrder);
+
+		int size() const;
+		bool isEmpty() const;
+		/**
+			Returns the item at the given position from the front of the queue.
+		*/
+		BuildItem & at(int index);
+		const BuildItem & at(int index) const;
+		BuildItem & front();
+		const BuildItem & front() const;
+
+		void pushFront(const BuildItem & item);
+		void pushBack(const BuildItem & item);
+		/**
+			Removes the front item. Does nothing if the queue is empty.
+		*/
+		void popFront();
+		/**
+			Removes the item at the given position from the front of the queue, in time proportional to its position.
+		*/
+		void erase(int index);
+		void clear();
+		/**
+			Returns a copy of the items, from front to back.
+		*/
+		std::vector<BuildItem> toVector() const;
+	};
+}
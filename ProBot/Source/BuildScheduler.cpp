@@ -0,0 +1,106 @@
+/**
+	BuildScheduler.cpp
+	Chooses which items near the front of the build order to start, so that idle producers aren't kept waiting by a blocked item.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "BuildScheduler.h"
+#include "BuildSimulator.h"
+#include <algorithm>
+
+using namespace ProBot;
+using namespace BuildScheduler;
+
+namespace {
+	/**
+		Returns the number of frames until the given cost can be paid from the amount on hand, or BuildSimulator::NEVER.
+		@param rate - income in thousandths per frame
+	*/
+	int getFramesUntil(int cost, int amount, int rate){
+		if (cost <= amount)
+			return 0;
+		if (rate <= 0)
+			return BuildSimulator::NEVER;
+		long long shortfall = static_cast<long long>(cost - amount) * BuildSimulator::RESOURCE_SCALE;
+		return static_cast<int>((shortfall + rate - 1) / rate);
+	}
+
+	/**
+		Returns the amount on hand that must be kept for a cost paid the given number of frames from now.
+	*/
+	int getReserve(int cost, int amount, int rate, int frames){
+		long long income = static_cast<long long>(rate) * frames / BuildSimulator::RESOURCE_SCALE;
+		long long reserve = cost - income;
+		if (reserve <= 0)
+			return 0;
+		return static_cast<int>(std::min<long long>(reserve, amount));
+	}
+
+	/**
+		Returns true if one more copy of the candidate can be started from the given resources.
+	*/
+	bool canStart(const Candidate & candidate, int minerals, int gas, int supply, const std::map<int, int> & idleProducers){
+		if (!candidate._ready || candidate._mineralCost > minerals || candidate._gasCost > gas || candidate._supplyCost > supply)
+			return false;
+		if (candidate._producer == NO_PRODUCER)
+			return true;
+		std::map<int, int>::const_iterator producers = idleProducers.find(candidate._producer);
+		return producers != idleProducers.end() && producers->second > 0;
+	}
+}
+
+int BuildScheduler::getAffordableFrame(int mineralCost, int gasCost, const Resources & resources){
+	int mineralFrame = getFramesUntil(mineralCost, resources._minerals, resources._mineralRate);
+	int gasFrame = getFramesUntil(gasCost, resources._gas, resources._gasRate);
+	if (mineralFrame == BuildSimulator::NEVER || gasFrame == BuildSimulator::NEVER)
+		return BuildSimulator::NEVER;
+	return std::max(mineralFrame, gasFrame);
+}
+
+std::vector<int> BuildScheduler::scheduleItems(const std::vector<Candidate> & candidates, const Resources & resources, std::map<int, int> & idleProducers){
+	std::vector<int> counts(candidates.size(), 0);
+	int minerals = resources._minerals;
+	int gas = resources._gas;
+	int supply = resources._supply;
+	// resources kept for the first candidate that couldn't be fully started
+	bool blocked = false;
+	int reservedMinerals = 0;
+	int reservedGas = 0;
+
+	for (size_t i = 0; i < candidates.size(); i++){
+		const Candidate & candidate = candidates[i];
+		// an ordered candidate waits for everything before it
+		if (candidate._ordered && blocked)
+			break;
+		while (counts[i] < candidate._count
+			&& canStart(candidate, minerals - reservedMinerals, gas - reservedGas, supply, idleProducers)){
+			minerals -= candidate._mineralCost;
+			gas -= candidate._gasCost;
+			supply -= candidate._supplyCost;
+			if (candidate._producer != NO_PRODUCER)
+				idleProducers[candidate._producer]--;
+			counts[i]++;
+		}
+		if (counts[i] >= candidate._count)
+			continue;
+		// nothing may pass an ordered candidate
+		if (candidate._ordered)
+			break;
+		if (!blocked){
+			// keep what the blocked candidate will still need from the resources on hand when it becomes affordable,
+			// so that the candidates after it can't delay it
+			Resources left = resources;
+			left._minerals = minerals;
+			left._gas = gas;
+			int frames = getAffordableFrame(candidate._mineralCost, candidate._gasCost, left);
+			if (frames == BuildSimulator::NEVER || frames > MAX_RESERVE_FRAMES)
+				frames = MAX_RESERVE_FRAMES;
+			reservedMinerals = getReserve(candidate._mineralCost, minerals, resources._mineralRate, frames);
+			reservedGas = getReserve(candidate._gasCost, gas, resources._gasRate, frames);
+			blocked = true;
+		}
+	}
+	return counts;
+}
@@ -0,0 +1,73 @@
+/**
+	BuildScheduler.h
+	Chooses which items near the front of the build order to start, so that idle producers aren't kept waiting by a blocked item.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+namespace ProBot{
+	namespace BuildScheduler{
+		// number of items, from the front of the build order, that are considered for starting each frame
+		const int LOOKAHEAD = 8;
+		// furthest ahead (in frames) that resources are reserved for a blocked item: one minute of game time
+		const int MAX_RESERVE_FRAMES = 1440;
+		// producer ID of items that don't need a producer (flags)
+		const int NO_PRODUCER = -1;
+
+		/**
+			A build order item as seen by the scheduler.
+		*/
+		struct Candidate {
+			int _mineralCost;
+			int _gasCost;
+			// supply used by each copy (doubled, the same as in BWAPI)
+			int _supplyCost;
+			// unit type ID of the producer (worker, trainer, researcher or upgrader), or NO_PRODUCER
+			int _producer;
+			// number of copies left to start
+			int _count;
+			// true if the item's requirements are met, so that it can be started once it's affordable
+			bool _ready;
+			// true if no later item may be started before this one
+			bool _ordered;
+		};
+
+		/**
+			The resources that the scheduled items are paid from.
+		*/
+		struct Resources {
+			// resources on hand, less the ones already promised to buildings that workers are on their way to build
+			int _minerals;
+			int _gas;
+			// supply not yet used (doubled)
+			int _supply;
+			// thousandths of a mineral / gas gathered each frame (see BuildSimulator::RESOURCE_SCALE)
+			int _mineralRate;
+			int _gasRate;
+		};
+
+		/**
+			Returns the number of frames until the given costs can be paid at the current income,
+			or BuildSimulator::NEVER if a resource that's short has no income.
+		*/
+		int getAffordableFrame(int mineralCost, int gasCost, const Resources & resources);
+
+		/**
+			Decides how many copies of each candidate, in build order, to start this frame.
+			The first candidate that can't be fully started keeps (from the resources on hand) what it still needs
+			on the frame it would become affordable, so later candidates only use resources that don't delay it.
+			Nothing is started past an ordered candidate until it and everything before it has been started.
+			@param candidates - the items at the front of the build order
+			@param resources - the resources available this frame
+			@param idleProducers - number of idle producers of each unit type ID; one is taken for each copy started
+			@return the number of copies to start of each candidate
+		*/
+		std::vector<int> scheduleItems(const std::vector<Candidate> & candidates, const Resources & resources, std::map<int, int> & idleProducers);
+	}
+}
@@ -0,0 +1,89 @@
+/**
+	BuildSearchWorker.cpp
+	Background thread that runs tech searches requested from the game thread.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "BuildSearchWorker.h"
+#include "BuildMinimax.h"
+
+using namespace ProBot;
+
+BuildSearchWorker::BuildSearchWorker(long long budget)
+	: _hasRequest(false), _requestFrame(-1), _stopping(false), _budget(budget), _search(BuildMinimax::getTranspositionTable()),
+	_requestsPosted(0), _searchesRun(0){
+}
+
+BuildSearchWorker::~BuildSearchWorker(){
+	stop();
+}
+
+void BuildSearchWorker::start(){
+	if (_thread.joinable())
+		return;
+	_stopping = false;
+	_thread = std::thread(&BuildSearchWorker::run, this);
+}
+
+void BuildSearchWorker::stop(){
+	if (!_thread.joinable())
+		return;
+	{
+		std::lock_guard<std::mutex> lock(_mailboxMutex);
+		_stopping = true;
+		_hasRequest = false;
+	}
+	_mailboxCondition.notify_one();
+	_thread.join();
+}
+
+bool BuildSearchWorker::isRunning() const{
+	return _thread.joinable();
+}
+
+void BuildSearchWorker::post(const TechTreeStore & self, const TechTreeStore & enemy, int frame){
+	{
+		std::lock_guard<std::mutex> lock(_mailboxMutex);
+		// overwrite any request that hasn't been picked up yet
+		_requestTrees[BuildMinimax::SELF] = self;
+		_requestTrees[BuildMinimax::ENEMY] = enemy;
+		_requestFrame = frame;
+		_hasRequest = true;
+	}
+	_requestsPosted++;
+	_mailboxCondition.notify_one();
+}
+
+void BuildSearchWorker::run(){
+	TechTreeStore trees[2];
+	int frame;
+	while (true){
+		{
+			std::unique_lock<std::mutex> lock(_mailboxMutex);
+			while (!_hasRequest && !_stopping)
+				_mailboxCondition.wait(lock);
+			if (_stopping)
+				return;
+			// take the request, leaving the mailbox free for the next one while we search
+			trees[BuildMinimax::SELF] = _requestTrees[BuildMinimax::SELF];
+			trees[BuildMinimax::ENEMY] = _requestTrees[BuildMinimax::ENEMY];
+			frame = _requestFrame;
+			_hasRequest = false;
+		}
+		BuildMinimax::publishTargetTech(BuildMinimax::searchNextBuilding(_search, _mcts,
+			trees[BuildMinimax::SELF], trees[BuildMinimax::ENEMY], _budget));
+		_search._stats._frame = frame;
+		BuildMinimax::recordSearchStats(_search._stats);
+		_searchesRun++;
+	}
+}
+
+unsigned int BuildSearchWorker::getRequestsPosted() const{
+	return _requestsPosted.load();
+}
+
+unsigned int BuildSearchWorker::getSearchesRun() const{
+	return _searchesRun.load();
+}
@@ -0,0 +1,79 @@
+/**
+	BuildSearchWorker.h
+	Background thread that runs tech searches requested from the game thread.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "TechTreeStore.h"
+#include "SearchContext.h"
+#include "BuildMCTS.h"
+
+namespace ProBot{
+	// time allowed for each search run by the worker, in microseconds
+	// (the worker doesn't hold up a frame, so it can search for longer than a synchronous search)
+	const long long WORKER_SEARCH_BUDGET = 50000;
+
+	/**
+		Runs tech searches on a dedicated thread.
+		Requests are posted to a single-slot mailbox: a request that arrives before the previous one has been
+		picked up replaces it, so a burst of requests costs one search. Results are published through
+		BuildMinimax::publishTargetTech, and the statistics of each search are added to the game's search log.
+	*/
+	class BuildSearchWorker {
+		std::thread _thread;
+		std::mutex _mailboxMutex;
+		std::condition_variable _mailboxCondition;
+
+		// the latest request that hasn't been picked up by the worker yet
+		bool _hasRequest;
+		TechTreeStore _requestTrees[2];
+		int _requestFrame;
+
+		bool _stopping;
+		long long _budget;
+
+		// only used by the worker thread, so that its searches never touch the game thread's context
+		BuildMinimax::SearchContext _search;
+		BuildMCTS::MCTSTree _mcts;
+
+		std::atomic<unsigned int> _requestsPosted;
+		std::atomic<unsigned int> _searchesRun;
+
+		/**
+			The worker thread's loop: waits for a request, searches it and publishes the result.
+		*/
+		void run();
+
+	public:
+		BuildSearchWorker(long long budget = WORKER_SEARCH_BUDGET);
+		~BuildSearchWorker();
+
+		/**
+			Starts the worker thread if it isn't running.
+		*/
+		void start();
+		/**
+			Stops the worker thread, waiting for the current search to finish. Pending requests are dropped.
+		*/
+		void stop();
+		bool isRunning() const;
+		/**
+			Replaces the pending request with a search of copies of the given trees. Never waits for a search.
+			@param frame - the frame the search is requested on, recorded in the search's statistics
+		*/
+		void post(const TechTreeStore & self, const TechTreeStore & enemy, int frame = -1);
+		/**
+			Returns the number of requests posted, and the number of searches actually run for them.
+		*/
+		unsigned int getRequestsPosted() const;
+		unsigned int getSearchesRun() const;
+	};
+}
@@ -0,0 +1,321 @@
+/**
+	BuildSimulator.cpp
+	Fast forward simulation of Protoss macro: worker income, supply, build times and producer occupancy.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "BuildSimulator.h"
+#include <climits>
+#include <cstring>
+
+using namespace ProBot;
+using namespace BuildSimulator;
+using namespace BWAPI::UnitTypes;
+
+namespace {
+	// indices of the simulator types in the data table
+	enum SimTypes {
+		PROBE, ZEALOT, DRAGOON, HIGH_TEMPLAR, DARK_TEMPLAR, REAVER, OBSERVER, SHUTTLE, SCOUT, CORSAIR, CARRIER, ARBITER,
+		NEXUS, PYLON, ASSIMILATOR, GATEWAY, FORGE, PHOTON_CANNON, CYBERNETICS_CORE, SHIELD_BATTERY, ROBOTICS_FACILITY,
+		STARGATE, CITADEL_OF_ADUN, ROBOTICS_SUPPORT_BAY, FLEET_BEACON, TEMPLAR_ARCHIVES, OBSERVATORY, ARBITER_TRIBUNAL
+	};
+
+	// maximum supply of a player (doubled, the same as in BWAPI)
+	const int MAX_SUPPLY = 400;
+
+	// every building other than the Nexus, Pylon and Assimilator needs a completed Pylon to power it
+	const SimTypeData SIM_TYPE_DATA[NUM_SIM_TYPES] = {
+		{ Enum::Protoss_Probe, 50, 0, 300, 2, 0, NEXUS, 0 },
+		{ Enum::Protoss_Zealot, 100, 0, 600, 4, 0, GATEWAY, 0 },
+		{ Enum::Protoss_Dragoon, 125, 50, 750, 4, 0, GATEWAY, 1u << CYBERNETICS_CORE },
+		{ Enum::Protoss_High_Templar, 50, 150, 750, 4, 0, GATEWAY, 1u << TEMPLAR_ARCHIVES },
+		{ Enum::Protoss_Dark_Templar, 125, 100, 750, 4, 0, GATEWAY, 1u << TEMPLAR_ARCHIVES },
+		{ Enum::Protoss_Reaver, 200, 100, 1050, 8, 0, ROBOTICS_FACILITY, 1u << ROBOTICS_SUPPORT_BAY },
+		{ Enum::Protoss_Observer, 25, 75, 600, 2, 0, ROBOTICS_FACILITY, 1u << OBSERVATORY },
+		{ Enum::Protoss_Shuttle, 200, 0, 900, 4, 0, ROBOTICS_FACILITY, 0 },
+		{ Enum::Protoss_Scout, 275, 125, 1200, 6, 0, STARGATE, 0 },
+		{ Enum::Protoss_Corsair, 150, 100, 600, 4, 0, STARGATE, 0 },
+		{ Enum::Protoss_Carrier, 350, 250, 2100, 12, 0, STARGATE, 1u << FLEET_BEACON },
+		{ Enum::Protoss_Arbiter, 100, 350, 2400, 8, 0, STARGATE, 1u << ARBITER_TRIBUNAL },
+		{ Enum::Protoss_Nexus, 400, 0, 1800, 0, 18, PROBE, 0 },
+		{ Enum::Protoss_Pylon, 100, 0, 450, 0, 16, PROBE, 0 },
+		{ Enum::Protoss_Assimilator, 100, 0, 600, 0, 0, PROBE, 0 },
+		{ Enum::Protoss_Gateway, 150, 0, 900, 0, 0, PROBE, 1u << PYLON },
+		{ Enum::Protoss_Forge, 150, 0, 600, 0, 0, PROBE, 1u << PYLON },
+		{ Enum::Protoss_Photon_Cannon, 150, 0, 750, 0, 0, PROBE, 1u << PYLON | 1u << FORGE },
+		{ Enum::Protoss_Cybernetics_Core, 200, 0, 900, 0, 0, PROBE, 1u << PYLON | 1u << GATEWAY },
+		{ Enum::Protoss_Shield_Battery, 100, 0, 450, 0, 0, PROBE, 1u << PYLON | 1u << GATEWAY },
+		{ Enum::Protoss_Robotics_Facility, 200, 200, 1200, 0, 0, PROBE, 1u << PYLON | 1u << CYBERNETICS_CORE },
+		{ Enum::Protoss_Stargate, 150, 150, 1050, 0, 0, PROBE, 1u << PYLON | 1u << CYBERNETICS_CORE },
+		{ Enum::Protoss_Citadel_of_Adun, 150, 100, 900, 0, 0, PROBE, 1u << PYLON | 1u << CYBERNETICS_CORE },
+		{ Enum::Protoss_Robotics_Support_Bay, 150, 100, 450, 0, 0, PROBE, 1u << PYLON | 1u << ROBOTICS_FACILITY },
+		{ Enum::Protoss_Fleet_Beacon, 300, 200, 900, 0, 0, PROBE, 1u << PYLON | 1u << STARGATE },
+		{ Enum::Protoss_Templar_Archives, 150, 200, 900, 0, 0, PROBE, 1u << PYLON | 1u << CITADEL_OF_ADUN },
+		{ Enum::Protoss_Observatory, 50, 100, 450, 0, 0, PROBE, 1u << PYLON | 1u << ROBOTICS_FACILITY },
+		{ Enum::Protoss_Arbiter_Tribunal, 200, 150, 900, 0, 0, PROBE, 1u << PYLON | 1u << STARGATE | 1u << TEMPLAR_ARCHIVES }
+	};
+
+	/**
+		Returns true if units of the given type are tied up while producing (buildings are warped in, so probes are not).
+	*/
+	bool isOccupiedWhileProducing(int producer){
+		return producer != PROBE;
+	}
+
+	/**
+		Returns the bits of the types with at least one unit in the given count array.
+	*/
+	sim_mask_t getOwnedMask(const unsigned char counts[NUM_SIM_TYPES]){
+		sim_mask_t mask = 0;
+		for (int simType = 0; simType < NUM_SIM_TYPES; simType++){
+			if (counts[simType] > 0)
+				mask |= 1u << simType;
+		}
+		return mask;
+	}
+
+	/**
+		Returns the frame of the next item to finish, or NEVER if nothing is in production.
+	*/
+	int getNextEventFrame(const SimState & state){
+		int next = NEVER;
+		for (int i = 0; i < state._numEvents; i++){
+			if (next == NEVER || state._events[i]._finishFrame < next)
+				next = state._events[i]._finishFrame;
+		}
+		return next;
+	}
+
+	/**
+		Adds the income from the current frame up to the given frame, without completing anything.
+	*/
+	void gatherUntil(SimState & state, int frame){
+		int frames = frame - state._frame;
+		if (frames <= 0)
+			return;
+		state._minerals += getMineralIncome(state) * frames;
+		state._gas += getGasIncome(state) * frames;
+		state._frame = frame;
+	}
+
+	/**
+		Returns true if nothing other than resources (or waiting on items already in production) stands in the way of the type.
+	*/
+	bool isReachable(const SimState & state, int simType){
+		const SimTypeData & data = SIM_TYPE_DATA[simType];
+		if (state._started[data._producer] == 0)
+			return false;
+		if ((getOwnedMask(state._started) & data._prereqs) != data._prereqs)
+			return false;
+		if (data._gasPrice * RESOURCE_SCALE > state._gas && state._started[ASSIMILATOR] == 0)
+			return false;
+		// count the supply of the items still in production
+		int supplyTotal = state._supplyTotal;
+		for (int i = 0; i < state._numEvents; i++)
+			supplyTotal += SIM_TYPE_DATA[state._events[i]._type]._supplyProvided;
+		return state._supplyUsed + data._supplyRequired <= std::min(supplyTotal, MAX_SUPPLY);
+	}
+
+	/**
+		Returns true if the type can be started on the current frame, ignoring its price.
+	*/
+	bool isUnblocked(const SimState & state, int simType){
+		const SimTypeData & data = SIM_TYPE_DATA[simType];
+		if (state._numEvents >= MAX_SIM_EVENTS || state._started[simType] == UCHAR_MAX)
+			return false;
+		if (state._completed[data._producer] <= (isOccupiedWhileProducing(data._producer) ? state._busy[data._producer] : 0))
+			return false;
+		if ((getOwnedMask(state._completed) & data._prereqs) != data._prereqs)
+			return false;
+		return state._supplyUsed + data._supplyRequired <= state._supplyTotal;
+	}
+
+	/**
+		Returns the number of frames until the price of the type can be paid, or NEVER if the income will never cover it.
+	*/
+	int getFramesToAfford(const SimState & state, int simType){
+		const SimTypeData & data = SIM_TYPE_DATA[simType];
+		int frames = 0;
+		int mineralsNeeded = data._mineralPrice * RESOURCE_SCALE - state._minerals;
+		if (mineralsNeeded > 0){
+			int income = getMineralIncome(state);
+			if (income <= 0)
+				return NEVER;
+			frames = std::max(frames, (mineralsNeeded + income - 1) / income);
+		}
+		int gasNeeded = data._gasPrice * RESOURCE_SCALE - state._gas;
+		if (gasNeeded > 0){
+			int income = getGasIncome(state);
+			if (income <= 0)
+				return NEVER;
+			frames = std::max(frames, (gasNeeded + income - 1) / income);
+		}
+		return frames;
+	}
+
+	/**
+		Simulates the state forwards until the type can be started.
+		@return false if the type can never be started from the state
+	*/
+	bool waitUntilStartable(SimState & state, int simType){
+		if (!isReachable(state, simType))
+			return false;
+		while (!canStartNow(state, simType)){
+			int nextEvent = getNextEventFrame(state);
+			int target = nextEvent;
+			// if only the price is missing, skip straight to when it's affordable (unless something finishes first)
+			if (isUnblocked(state, simType)){
+				int framesToAfford = getFramesToAfford(state, simType);
+				if (framesToAfford != NEVER && (nextEvent == NEVER || state._frame + framesToAfford < nextEvent))
+					target = state._frame + framesToAfford;
+			}
+			if (target == NEVER || target > MAX_SIM_FRAME)
+				return false;
+			advanceTo(state, target);
+		}
+		return true;
+	}
+}
+
+int BuildSimulator::getSimType(BWAPI::UnitType unitType){
+	for (int simType = 0; simType < NUM_SIM_TYPES; simType++){
+		if (SIM_TYPE_DATA[simType]._unitType == unitType.getID())
+			return simType;
+	}
+	return NULL_SIM_TYPE;
+}
+
+const SimTypeData & BuildSimulator::getTypeData(int simType){
+	return SIM_TYPE_DATA[simType];
+}
+
+BWAPI::UnitType BuildSimulator::getUnitType(int simType){
+	return BWAPI::UnitType(SIM_TYPE_DATA[simType]._unitType);
+}
+
+void BuildSimulator::initStartingState(SimState & state){
+	memset(&state, 0, sizeof(SimState));
+	state._minerals = 50 * RESOURCE_SCALE;
+	addCompleted(state, NEXUS);
+	addCompleted(state, PROBE, 4);
+}
+
+void BuildSimulator::initGameState(SimState & state, BWAPI::Player player){
+	memset(&state, 0, sizeof(SimState));
+	state._frame = BWAPI::Broodwar->getFrameCount();
+	state._minerals = player->minerals() * RESOURCE_SCALE;
+	state._gas = player->gas() * RESOURCE_SCALE;
+	// the player's supply already counts units in production, but not pylons under construction
+	state._supplyUsed = static_cast<short>(player->supplyUsed());
+	state._supplyTotal = static_cast<short>(player->supplyTotal());
+
+	for (auto & unit : player->getUnits()){
+		int simType = getSimType(unit->getType());
+		if (simType == NULL_SIM_TYPE)
+			continue;
+		if (unit->isCompleted()){
+			state._completed[simType]++;
+			state._started[simType]++;
+			// the unit at the front of the training queue is the one in production
+			std::list<BWAPI::UnitType> queue = unit->getTrainingQueue();
+			int trainedType = queue.empty() ? NULL_SIM_TYPE : getSimType(queue.front());
+			if (trainedType != NULL_SIM_TYPE && state._numEvents < MAX_SIM_EVENTS){
+				SimEvent & event = state._events[state._numEvents++];
+				event._finishFrame = state._frame + unit->getRemainingTrainTime();
+				event._type = static_cast<unsigned char>(trainedType);
+				state._started[trainedType]++;
+				state._busy[simType]++;
+			}
+		}
+		else if (unit->getType().isBuilding() && state._numEvents < MAX_SIM_EVENTS){
+			// units being trained are counted through their producer, so only buildings are added here
+			SimEvent & event = state._events[state._numEvents++];
+			event._finishFrame = state._frame + unit->getRemainingBuildTime();
+			event._type = static_cast<unsigned char>(simType);
+			state._started[simType]++;
+		}
+	}
+}
+
+void BuildSimulator::addCompleted(SimState & state, int simType, int count){
+	const SimTypeData & data = SIM_TYPE_DATA[simType];
+	state._completed[simType] = static_cast<unsigned char>(state._completed[simType] + count);
+	state._started[simType] = static_cast<unsigned char>(state._started[simType] + count);
+	state._supplyUsed = static_cast<short>(state._supplyUsed + data._supplyRequired * count);
+	state._supplyTotal = static_cast<short>(std::min(state._supplyTotal + data._supplyProvided * count, MAX_SUPPLY));
+}
+
+int BuildSimulator::getMineralIncome(const SimState & state){
+	int gasWorkers = std::min(state._completed[ASSIMILATOR] * GAS_WORKERS_PER_ASSIMILATOR, static_cast<int>(state._completed[PROBE]));
+	int mineralWorkers = std::min(state._completed[PROBE] - gasWorkers, state._completed[NEXUS] * MINERAL_WORKERS_PER_BASE);
+	return mineralWorkers * MINERALS_PER_WORKER_FRAME;
+}
+
+int BuildSimulator::getGasIncome(const SimState & state){
+	int gasWorkers = std::min(state._completed[ASSIMILATOR] * GAS_WORKERS_PER_ASSIMILATOR, static_cast<int>(state._completed[PROBE]));
+	return gasWorkers * GAS_PER_WORKER_FRAME;
+}
+
+void BuildSimulator::advanceTo(SimState & state, int frame){
+	// complete the items in the order that they finish, since each one can change the income
+	while (state._numEvents > 0){
+		int next = 0;
+		for (int i = 1; i < state._numEvents; i++){
+			if (state._events[i]._finishFrame < state._events[next]._finishFrame)
+				next = i;
+		}
+		SimEvent event = state._events[next];
+		if (event._finishFrame > frame)
+			break;
+		gatherUntil(state, event._finishFrame);
+		state._events[next] = state._events[--state._numEvents];
+
+		const SimTypeData & data = SIM_TYPE_DATA[event._type];
+		state._completed[event._type]++;
+		state._supplyTotal = static_cast<short>(std::min(state._supplyTotal + data._supplyProvided, MAX_SUPPLY));
+		if (isOccupiedWhileProducing(data._producer))
+			state._busy[data._producer]--;
+	}
+	gatherUntil(state, frame);
+}
+
+bool BuildSimulator::canStartNow(const SimState & state, int simType){
+	const SimTypeData & data = SIM_TYPE_DATA[simType];
+	return isUnblocked(state, simType)
+		&& state._minerals >= data._mineralPrice * RESOURCE_SCALE
+		&& state._gas >= data._gasPrice * RESOURCE_SCALE;
+}
+
+int BuildSimulator::getEarliestStart(const SimState & state, int simType){
+	SimState copy = state;
+	if (!waitUntilStartable(copy, simType))
+		return NEVER;
+	return copy._frame;
+}
+
+bool BuildSimulator::startItem(SimState & state, int simType){
+	if (!waitUntilStartable(state, simType))
+		return false;
+	const SimTypeData & data = SIM_TYPE_DATA[simType];
+	state._minerals -= data._mineralPrice * RESOURCE_SCALE;
+	state._gas -= data._gasPrice * RESOURCE_SCALE;
+	state._supplyUsed = static_cast<short>(state._supplyUsed + data._supplyRequired);
+	state._started[simType]++;
+	if (isOccupiedWhileProducing(data._producer))
+		state._busy[data._producer]++;
+
+	SimEvent & event = state._events[state._numEvents++];
+	event._finishFrame = state._frame + data._buildTime;
+	event._type = static_cast<unsigned char>(simType);
+	return true;
+}
+
+int BuildSimulator::finishAll(SimState & state){
+	int last = state._frame;
+	for (int i = 0; i < state._numEvents; i++)
+		last = std::max(last, state._events[i]._finishFrame);
+	advanceTo(state, last);
+	return last;
+}
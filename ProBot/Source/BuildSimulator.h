@@ -0,0 +1,135 @@
+/**
+	BuildSimulator.h
+	Fast forward simulation of Protoss macro: worker income, supply, build times and producer occupancy.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+#include <BWAPI.h>
+
+namespace ProBot{
+	namespace BuildSimulator{
+		// number of Protoss unit types known to the simulator
+		const int NUM_SIM_TYPES = 28;
+		// value used for unit types that aren't known to the simulator
+		const int NULL_SIM_TYPE = -1;
+		// maximum number of items that can be in production at once
+		const int MAX_SIM_EVENTS = 24;
+		// frame returned when an item can never be started from the current state
+		const int NEVER = -1;
+		// resources are kept in thousandths, so that income per frame doesn't need floating point
+		const int RESOURCE_SCALE = 1000;
+		// thousandths of a mineral / gas gathered by one worker each frame
+		const int MINERALS_PER_WORKER_FRAME = 45;
+		const int GAS_PER_WORKER_FRAME = 70;
+		// maximum number of workers gathering from one base / one assimilator
+		const int MINERAL_WORKERS_PER_BASE = 24;
+		const int GAS_WORKERS_PER_ASSIMILATOR = 3;
+		// frame count at which the simulation gives up waiting (one hour of game time)
+		const int MAX_SIM_FRAME = 86400;
+
+		// set of simulator types, one bit per type
+		typedef unsigned int sim_mask_t;
+
+		/**
+			Constant data of a unit type used by the simulator.
+			Supply values are doubled, the same as in BWAPI.
+		*/
+		struct SimTypeData {
+			BWAPI::UnitTypes::Enum::Enum _unitType;
+			int _mineralPrice;
+			int _gasPrice;
+			int _buildTime;
+			int _supplyRequired;
+			int _supplyProvided;
+			// simulator type of the unit that trains / warps in this type
+			int _producer;
+			// simulator types that must be completed before this type can be started
+			sim_mask_t _prereqs;
+		};
+
+		/**
+			An item in production and the frame that it finishes on.
+		*/
+		struct SimEvent {
+			int _finishFrame;
+			unsigned char _type;
+		};
+
+		/**
+			The state of a simulated player. Plain data, so that it can be copied freely during a search.
+		*/
+		struct SimState {
+			int _frame;
+			// in thousandths (see RESOURCE_SCALE)
+			int _minerals;
+			int _gas;
+			short _supplyUsed;
+			short _supplyTotal;
+			// number of completed units, and number of units started (completed or in production) of each type
+			unsigned char _completed[NUM_SIM_TYPES];
+			unsigned char _started[NUM_SIM_TYPES];
+			// number of units of each type that are busy producing something
+			unsigned char _busy[NUM_SIM_TYPES];
+			unsigned char _numEvents;
+			SimEvent _events[MAX_SIM_EVENTS];
+		};
+
+		/**
+			Returns the simulator type of the given unit type, or NULL_SIM_TYPE if it isn't simulated.
+		*/
+		int getSimType(BWAPI::UnitType unitType);
+		/**
+			Returns the constant data of the given simulator type.
+		*/
+		const SimTypeData & getTypeData(int simType);
+		/**
+			Returns the unit type of the given simulator type.
+		*/
+		BWAPI::UnitType getUnitType(int simType);
+
+		/**
+			Sets the state to the start of a game: a Nexus, four Probes and 50 minerals.
+		*/
+		void initStartingState(SimState & state);
+		/**
+			Sets the state from the current game, for the given player.
+		*/
+		void initGameState(SimState & state, BWAPI::Player player);
+		/**
+			Adds completed units of the given simulator type to the state (along with the supply they provide and use).
+		*/
+		void addCompleted(SimState & state, int simType, int count = 1);
+
+		/**
+			Returns the income of the state, in thousandths of a resource per frame.
+		*/
+		int getMineralIncome(const SimState & state);
+		int getGasIncome(const SimState & state);
+		/**
+			Simulates the state forwards to the given frame, completing any items that finish on the way.
+		*/
+		void advanceTo(SimState & state, int frame);
+		/**
+			Returns true if the given simulator type can be started on the current frame.
+		*/
+		bool canStartNow(const SimState & state, int simType);
+		/**
+			Returns the earliest frame on which the given simulator type can be started, or NEVER.
+		*/
+		int getEarliestStart(const SimState & state, int simType);
+		/**
+			Waits until the given simulator type can be started and then starts it.
+			@return true if the item was started, false if it can never be started from this state
+		*/
+		bool startItem(SimState & state, int simType);
+		/**
+			Simulates the state forwards until every item in production is finished.
+			@return the frame on which the last item finished
+		*/
+		int finishAll(SimState & state);
+	}
+}
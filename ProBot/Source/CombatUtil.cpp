@@ -8,9 +8,22 @@
 
 #include "CombatUtil.h"
 #include "Debug.h"
+#include <mutex>
 
 using namespace ProBot;
 
+// number of unit type IDs known to BWAPI
+static const int NUM_STATIC_TYPES = BWAPI::UnitTypes::Enum::MAX;
+
+// static scores and pairwise static advantages of every unit type, indexed by unit type ID
+// (filled once, even when searches on several threads ask for them at the same time)
+static std::once_flag staticTablesInitialized;
+static int staticUnitScores[NUM_STATIC_TYPES];
+static int staticAdvantages[NUM_STATIC_TYPES][NUM_STATIC_TYPES];
+
+// the frame at which each unit (by ID) can attack again, kept here rather than in the header so there is only one copy
+static std::unordered_map<int, int> unitAttackCooldowns;
+
 int CombatUtil::evaluateDynamicAdvantage(BWAPI::Unit attacker, BWAPI::Unit target){
 	// give lowest possible score if invalid attacker or target
 	if (!attacker || !target)
@@ -222,13 +235,35 @@ int CombatUtil::getStaticUnitScore(BWAPI::UnitType unitType){
 	score += static_cast<int>(unitType.topSpeed() * 10.0);
 	return score;
 }
+namespace {
+	void fillStaticTables(){
+		for (int first = 0; first < NUM_STATIC_TYPES; first++){
+			staticUnitScores[first] = CombatUtil::getStaticUnitScore(BWAPI::UnitType(first));
+			for (int second = 0; second < NUM_STATIC_TYPES; second++)
+				staticAdvantages[first][second] = CombatUtil::evaluateStaticAdvantage(BWAPI::UnitType(first), BWAPI::UnitType(second));
+		}
+	}
+}
+
+void CombatUtil::initStaticTables(){
+	std::call_once(staticTablesInitialized, fillStaticTables);
+}
+
+int CombatUtil::lookupStaticUnitScore(BWAPI::UnitType unitType){
+	return staticUnitScores[unitType.getID()];
+}
+
+int CombatUtil::lookupStaticAdvantage(BWAPI::UnitType myUnitType, BWAPI::UnitType targetType){
+	return staticAdvantages[myUnitType.getID()][targetType.getID()];
+}
+
 int CombatUtil::getUnitScore(BWAPI::Unit unit){
 	// @TODO
 	return 0;
 }
 
 std::unordered_map<int, int> & CombatUtil::getUnitCooldowns(){
-	return _unitAttackCooldown;
+	return unitAttackCooldowns;
 }
 
 bool CombatUtil::isInRange(BWAPI::Unit attacker, BWAPI::Unit target){
@@ -64,7 +64,6 @@ namespace ProBot{
 		// units that should not be considered for target selection
 		const std::vector<BWAPI::UnitType> IGNORED_TARGETS = { Zerg_Egg, Zerg_Larva };
 
-		static std::unordered_map<int, int> _unitAttackCooldown;
 		/**
 			Returns the weapon used by the attacker for a given target (air or ground).
 		*/
@@ -134,6 +133,21 @@ namespace ProBot{
 			Returns an estimate of a unit's base value given its current properties.
 		*/
 		int getUnitScore(BWAPI::Unit);
+		/**
+			Fills in the tables of static unit scores and static advantages for every pair of unit types.
+			Only does work the first time it is called; it's safe to call from several threads at once.
+		*/
+		void initStaticTables();
+		/**
+			Returns getStaticUnitScore of the unit type from the precomputed table.
+			ASSUMPTION: initStaticTables has been called.
+		*/
+		int lookupStaticUnitScore(BWAPI::UnitType);
+		/**
+			Returns evaluateStaticAdvantage of the unit type pair from the precomputed table.
+			ASSUMPTION: initStaticTables has been called.
+		*/
+		int lookupStaticAdvantage(BWAPI::UnitType, BWAPI::UnitType);
 		/**
 			Returns true if the target has no weapon against the attacker.
 		*/
@@ -169,6 +183,9 @@ namespace ProBot{
 			Returns a list of possible enemy attackers for a given unit
 		*/
 		BWAPI::Unitset getAttackersInRange(BWAPI::Unit target);
+		/**
+			Returns the frame at which each unit (by ID) can attack again.
+		*/
 		std::unordered_map<int, int> & getUnitCooldowns();
 		bool isInRange(BWAPI::Unit, BWAPI::Unit);
 		BWAPI::Position getSafestPositionNearby(BWAPI::Unit, int);
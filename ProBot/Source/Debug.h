@@ -19,6 +19,8 @@ namespace ProBot{
 		const int TEXT_HEIGHT = 15;
 		const int BOX_SIZE_SMALL = 25;
 		const int BOX_SIZE_LARGE = 50;
+		// draw the tech search, income and worker diagnostics under the build order
+		const bool DRAW_MACRO_STATS = false;
 
 		const BWAPI::Color RED = BWAPI::Color::Color(255, 0, 0);
 		const BWAPI::Color GREEN = BWAPI::Color::Color(0, 255, 0);
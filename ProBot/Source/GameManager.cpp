@@ -26,6 +26,8 @@ void GameManager::update()
 	if (Broodwar->getFrameCount() % FRAMES_BEFORE_UPDATE == 0)
 	{
 		_macroManager.getKnowledgeBank()->updateEnemyUnits();
+		// search once for all of the tech seen since the last update
+		BuildMinimax::updateTargetTechIfChanged(Broodwar->getFrameCount());
 		_macroManager.update();
 		_macroManager.getMicroManager()->update();
 
@@ -57,6 +59,10 @@ void GameManager::draw(){
 	_macroManager.getMicroManager()->draw();
 }
 
+MacroManager * GameManager::getMacroManager(){
+	return &_macroManager;
+}
+
 void GameManager::onUnitUnderAttack(BWAPI::Unit unit){
 	// @TODO
 }
@@ -75,7 +81,11 @@ void GameManager::onNukeDetect(BWAPI::Position target){
 }
 
 void GameManager::onUnitCreate(BWAPI::Unit unit){
+	// every player's buildings take up space that ours can't be placed on
+	if (IsBuilding(unit))
+		_macroManager.getPlacementGrid()->addBuilding(unit->getID(), unit->getType(), unit->getTilePosition());
 	if (IsOwned(unit)){
+		_macroManager.wake();
 		_macroManager.getUnitStorage()->handleUnitCreate(unit);
 		if (IsBuilding(unit))
 			_macroManager.onBuildingCreated(unit);
@@ -83,6 +93,15 @@ void GameManager::onUnitCreate(BWAPI::Unit unit){
 }
 
 void GameManager::onUnitDestroy(BWAPI::Unit unit){
+	// either player's losses can change the unit counts that build items require
+	_macroManager.wake();
+	_macroManager.onUnitDestroyed(unit);
+	// only units that were added to the grids are removed from them
+	// (a refinery shares its ID with its geyser, which is never removed)
+	_macroManager.getPlacementGrid()->removeBuilding(unit->getID());
+	_macroManager.getPlacementGrid()->removePylon(unit->getID());
+	if (IsMineralField(unit))
+		_macroManager.getPlacementGrid()->removeResource(unit->getID());
 	if (IsOwned(unit)){
 		_macroManager.getUnitStorage()->handleUnitDestroy(unit);
 		_macroManager.getKnowledgeBank()->handleMyUnitKilled(unit);
@@ -95,19 +114,40 @@ void GameManager::onUnitDestroy(BWAPI::Unit unit){
 }
 
 void GameManager::onUnitMorph(BWAPI::Unit unit){
+	// refineries morph from geysers and back, and drones morph into buildings
+	// (buildings morphing into others, like hatcheries into lairs, keep their footprint)
+	if (IsRefinery(unit) || (IsBuilding(unit) && unit->getType().whatBuilds().first == Zerg_Drone))
+		_macroManager.getPlacementGrid()->addBuilding(unit->getID(), unit->getType(), unit->getTilePosition());
+	else if (unit->getType() == Resource_Vespene_Geyser){
+		_macroManager.getPlacementGrid()->removeBuilding(unit->getID());
+		_macroManager.onUnitDestroyed(unit);
+	}
+	if (IsOwned(unit)){
+		_macroManager.wake();
+		_macroManager.getUnitStorage()->handleUnitMorph(unit);
+	}
 	if (IsOwned(unit) && IsBuilding(unit) && IsRefinery(unit))
 		_macroManager.onBuildingCreated(unit);
 }
 
 void GameManager::onUnitComplete(BWAPI::Unit unit){
 	if (IsOwned(unit)){
+		// a completed unit may free a producer, or provide supply or a required unit
+		_macroManager.wake();
 		_macroManager.getUnitStorage()->handleUnitComplete(unit);
 		_macroManager.getKnowledgeBank()->handleMyUnitFirstSighting(unit);
+		_macroManager.onUnitCompleted(unit);
+		if (unit->getType() == Protoss_Pylon)
+			_macroManager.getPlacementGrid()->addPylon(unit->getID(), unit->getTilePosition());
 	}
 }
 
 void GameManager::onUnitEvade(BWAPI::Unit unit){}
-void GameManager::onUnitDiscover(BWAPI::Unit unit){}
+void GameManager::onUnitDiscover(BWAPI::Unit unit){
+	// enemy buildings placed out of sight take up space from when they're first seen
+	if (IsBuilding(unit))
+		_macroManager.getPlacementGrid()->addBuilding(unit->getID(), unit->getType(), unit->getTilePosition());
+}
 void GameManager::onUnitShow(BWAPI::Unit unit){}
 void GameManager::onUnitHide(BWAPI::Unit unit){}
 void GameManager::onUnitRenegade(BWAPI::Unit unit){}
\ No newline at end of file
@@ -35,6 +35,7 @@ namespace ProBot
 			Draws information for each manager onto the game screen.
 		*/
 		void draw();
+		MacroManager * getMacroManager();
 		/**
 			Event handler for unit under attack.
 		*/
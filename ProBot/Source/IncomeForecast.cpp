@@ -0,0 +1,72 @@
+/**
+	IncomeForecast.cpp
+	Income model for each resource, fit from the number of gathering workers and the amounts actually gathered.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "IncomeForecast.h"
+#include "BuildScheduler.h"
+#include "BuildSimulator.h"
+
+using namespace ProBot;
+
+IncomeForecast::IncomeForecast()
+	: _lastFrame(-1){
+	for (int resource = 0; resource < NUM_RESOURCES; resource++){
+		_lastGathered[resource] = 0;
+		_workers[resource] = 0;
+		_sampleGathered[resource] = 0;
+		_sampleWorkerFrames[resource] = 0;
+	}
+	_ratePerWorker[MINERALS] = BuildSimulator::MINERALS_PER_WORKER_FRAME;
+	_ratePerWorker[GAS] = BuildSimulator::GAS_PER_WORKER_FRAME;
+}
+
+void IncomeForecast::observe(int frame, int gatheredMinerals, int gatheredGas, int mineralWorkers, int gasWorkers){
+	int gathered[NUM_RESOURCES] = { gatheredMinerals, gatheredGas };
+	int workers[NUM_RESOURCES] = { mineralWorkers, gasWorkers };
+	if (_lastFrame >= 0 && frame > _lastFrame){
+		int elapsed = frame - _lastFrame;
+		for (int resource = 0; resource < NUM_RESOURCES; resource++){
+			// the workers counted last time are the ones that gathered since then
+			_sampleGathered[resource] += gathered[resource] - _lastGathered[resource];
+			_sampleWorkerFrames[resource] += static_cast<long long>(_workers[resource]) * elapsed;
+			if (_sampleWorkerFrames[resource] >= INCOME_SAMPLE_WORKER_FRAMES){
+				int sample = static_cast<int>(static_cast<long long>(_sampleGathered[resource]) * BuildSimulator::RESOURCE_SCALE
+					/ _sampleWorkerFrames[resource]);
+				_ratePerWorker[resource] += (sample - _ratePerWorker[resource]) / INCOME_FIT_WEIGHT;
+				_sampleGathered[resource] = 0;
+				_sampleWorkerFrames[resource] = 0;
+			}
+		}
+	}
+	for (int resource = 0; resource < NUM_RESOURCES; resource++){
+		_lastGathered[resource] = gathered[resource];
+		_workers[resource] = workers[resource];
+	}
+	_lastFrame = frame;
+}
+
+int IncomeForecast::getRate(int resource) const{
+	return _workers[resource] * _ratePerWorker[resource];
+}
+
+int IncomeForecast::getRatePerWorker(int resource) const{
+	return _ratePerWorker[resource];
+}
+
+int IncomeForecast::getWorkers(int resource) const{
+	return _workers[resource];
+}
+
+int IncomeForecast::getFramesToAfford(int minerals, int gas, int mineralCost, int gasCost) const{
+	BuildScheduler::Resources resources;
+	resources._minerals = minerals;
+	resources._gas = gas;
+	resources._supply = 0;
+	resources._mineralRate = getRate(MINERALS);
+	resources._gasRate = getRate(GAS);
+	return BuildScheduler::getAffordableFrame(mineralCost, gasCost, resources);
+}
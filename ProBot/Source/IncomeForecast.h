@@ -0,0 +1,64 @@
+/**
+	IncomeForecast.h
+	Income model for each resource, fit from the number of gathering workers and the amounts actually gathered.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+namespace ProBot{
+	// number of worker-frames gathered over before the income per worker is refit (about 12 workers for 8 seconds)
+	const int INCOME_SAMPLE_WORKER_FRAMES = 2000;
+	// each new sample moves the fitted income per worker this fraction (one in n) of the way towards it
+	const int INCOME_FIT_WEIGHT = 4;
+
+	/**
+		Predicts income as the number of workers gathering each resource times the income per worker,
+		which starts at the simulator's estimate and is refit from the amounts the player has gathered.
+	*/
+	class IncomeForecast {
+	public:
+		enum ResourceTypes{
+			MINERALS,
+			GAS,
+			NUM_RESOURCES
+		};
+
+	private:
+		// frame of the last observation, or -1 before the first one
+		int _lastFrame;
+		// total gathered and number of gathering workers at the last observation
+		int _lastGathered[NUM_RESOURCES];
+		int _workers[NUM_RESOURCES];
+		// amount gathered, and worker-frames spent gathering it, since the last fit
+		int _sampleGathered[NUM_RESOURCES];
+		long long _sampleWorkerFrames[NUM_RESOURCES];
+		// fitted thousandths gathered by one worker each frame (see BuildSimulator::RESOURCE_SCALE)
+		int _ratePerWorker[NUM_RESOURCES];
+
+	public:
+		IncomeForecast();
+		/**
+			Records the player's state on the given frame, refitting the income per worker once enough has been gathered.
+			@param gatheredMinerals - total minerals gathered so far in the game (not reduced by spending)
+			@param gatheredGas - total gas gathered so far in the game
+			@param mineralWorkers - number of workers gathering minerals
+			@param gasWorkers - number of workers gathering gas
+		*/
+		void observe(int frame, int gatheredMinerals, int gatheredGas, int mineralWorkers, int gasWorkers);
+
+		/**
+			Returns the predicted thousandths of the resource gathered each frame.
+		*/
+		int getRate(int resource) const;
+		int getRatePerWorker(int resource) const;
+		int getWorkers(int resource) const;
+		/**
+			Returns the number of frames until the given costs can be paid from the given amounts at the predicted income,
+			or BuildSimulator::NEVER if a resource that's short has no income.
+		*/
+		int getFramesToAfford(int minerals, int gas, int mineralCost, int gasCost) const;
+	};
+}
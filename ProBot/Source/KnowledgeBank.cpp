@@ -10,16 +10,18 @@
 
 using namespace ProBot;
 
-KnowledgeBank::KnowledgeBank(){}
+KnowledgeBank::KnowledgeBank(){
+}
 
 void KnowledgeBank::handleMyUnitFirstSighting(BWAPI::Unit unit){
 	// anything that isn't a supply provider building (and not a resource depot)
 	// can be considered a tech unit
 	if (unit->getType().isResourceDepot()
 		|| (unit->getType().isBuilding() && unit->getType().supplyProvided() <= 0)){
-		// update list of tech units and the tech tree
+		// update list of tech units, and the tech tree if it's the first of its type
 		insertTech(unit->getType(), _myTechUnits);
-		BuildMinimax::updateTechTree(_myTechUnits, BuildMinimax::SELF);
+		if (_myTechUnits[unit->getType().getID()] == 1)
+			BuildMinimax::addTechType(unit->getType(), BuildMinimax::SELF);
 	}
 }
 
@@ -37,8 +39,12 @@ void KnowledgeBank::updateEnemyUnits(){
 		else if (_knownEnemies.find(enemy->getID()) == _knownEnemies.end())
 			handleEnemyUnitFirstSighting(enemy); // haven't seen this unit before, so handle it
 		else
-			if (enemy->getPosition().isValid()) // ensure that position on map is still valid, not invisible
-				_knownEnemies.at(enemy->getID()).update(enemy); // update existing
+			if (enemy->getPosition().isValid()){ // ensure that position on map is still valid, not invisible
+				EnemyUnit & known = _knownEnemies.at(enemy->getID());
+				// a morphed unit is counted as its new type
+				_knownEnemyCounts.morph(enemy->getID(), enemy->getType(), true);
+				known.update(enemy); // update existing
+			}
 	}
 }
 
@@ -55,13 +61,15 @@ void KnowledgeBank::handleEnemyUnitFirstSighting(BWAPI::Unit enemy){
 	if (enemy->getType().isResourceDepot()
 		|| (enemy->getType().isBuilding() && enemy->getType().supplyProvided() <= 0)){
 		insertTech(enemy->getType(), _enemyTechUnits);
-		BuildMinimax::updateTechTree(_enemyTechUnits, BuildMinimax::ENEMY);
+		if (_enemyTechUnits[enemy->getType().getID()] == 1)
+			BuildMinimax::addTechType(enemy->getType(), BuildMinimax::ENEMY);
 	}
 
 	// add unit to list of all known enemies
 	EnemyUnit enemyUnitInfo(enemy);
 	std::pair<unit_id_t, EnemyUnit> idEnemyPair(enemy->getID(), enemyUnitInfo);
-	_knownEnemies.insert(idEnemyPair);
+	if (_knownEnemies.insert(idEnemyPair).second)
+		_knownEnemyCounts.addCompleted(enemy->getID(), enemy->getType());
 }
 
 void KnowledgeBank::handleEnemyUnitKilled(BWAPI::Unit enemy){
@@ -72,7 +80,12 @@ void KnowledgeBank::handleEnemyUnitKilled(BWAPI::Unit enemy){
 				_enemyBases.erase(_enemyBases.begin() + i);
 		updateClosestEnemyBase();
 	}
-	_knownEnemies.erase(enemy->getID());
+	// units that were never sighted weren't counted
+	auto known = _knownEnemies.find(enemy->getID());
+	if (known != _knownEnemies.end()){
+		_knownEnemyCounts.remove(enemy->getID());
+		_knownEnemies.erase(known);
+	}
 }
 
 void KnowledgeBank::insertTech(BWAPI::UnitType techUnitType, tech_count_map_t & techCountMap){
@@ -147,19 +160,8 @@ tech_count_map_t KnowledgeBank::getMyTech(){
 	return _myTechUnits;
 }
 
-int KnowledgeBank::getNumberOfEnemiesOfType(BWAPI::UnitType type){
-	if (type.isBuilding()){ // if it's a tech unit then just return value in map
-		return _enemyTechUnits[type.getID()]; // defaults to 0
-	}
-	else { // else search through list of known enemies and sum
-		int counter = 0;
-		for (auto & enemyUnit : _knownEnemies){
-			if (enemyUnit.second.getUnitType().getID() == type.getID()){
-				counter++;
-			}
-		}
-		return counter;
-	}
+int KnowledgeBank::getNumberOfEnemiesOfType(BWAPI::UnitType type) const{
+	return _knownEnemyCounts.getCompletedCount(type);
 }
 
 void KnowledgeBank::draw(){
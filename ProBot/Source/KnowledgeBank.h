@@ -12,6 +12,7 @@
 #include "EnemyUnit.h"
 #include "Debug.h"
 #include "UnitStorage.h"
+#include "UnitTypeCounter.h"
 #include "Common.h"
 #include "BuildMinimax.h"
 
@@ -25,6 +26,8 @@ namespace ProBot{
 	{
 		// list of all enemies seen so far
 		std::unordered_map<unit_id_t, EnemyUnit> _knownEnemies;
+		// number of known enemies of each type, kept in step with _knownEnemies (every known enemy is counted as completed)
+		UnitTypeCounter _knownEnemyCounts;
 		
 		// note: a tech unit denotes any unit that contributes to a player's tech tree
 		
@@ -110,7 +113,10 @@ namespace ProBot{
 		BWAPI::Position getClosestEnemyBase();
 		tech_count_map_t getEnemyTech();
 		tech_count_map_t getMyTech();
-		int getNumberOfEnemiesOfType(BWAPI::UnitType);
+		/**
+			Returns the number of enemies of the given type that have been seen and not yet killed.
+		*/
+		int getNumberOfEnemiesOfType(BWAPI::UnitType) const;
 		EnemyUnit& getEnemyDataByID(unit_id_t);
 	};
 }
\ No newline at end of file
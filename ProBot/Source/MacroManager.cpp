@@ -1,4 +1,5 @@
 #include "MacroManager.h"
+#include "BuildSearchWorker.h"
 
 using namespace ProBot;
 using namespace BWAPI::Filter;
@@ -19,67 +20,174 @@ MicroManager * MacroManager::getMicroManager(){
 }
 
 void MacroManager::attemptBuildOrder(){
-	// do nothing if there's nothing left in the build order
-	if (_buildOrder.size() > 0){
-		BuildItem & next = _buildOrder.at(0);
-
-		// if additional requirements are not met, do nothing
-		if (!buildRequirementsAreMet(next.getRequirements()))
+	// sleep until woken if there's nothing left in the build order
+	int frame = BWAPI::Broodwar->getFrameCount();
+	_nextBuildFrame = frame + MAX_BUILD_SLEEP_FRAMES;
+	if (_buildOrder.isEmpty())
+		return;
+
+	// validate build orders by inserting build items needed before the next item
+	BuildItem & next = _buildOrder.front();
+	if (!next.isFlag() && next.getType() == Build::ItemTypes::UNIT && buildRequirementsAreMet(next.getRequirements())){
+		int supply = BWAPI::Broodwar->self()->supplyUsed();
+		// check if supply locked
+		// don't do anything if a pylon is already queued or under construction
+		if (next.getUnit().getID() != Protoss_Pylon.getID() && next.getUnit().supplyRequired() + supply > BWAPI::Broodwar->self()->supplyTotal()
+			&& BWAPI::Broodwar->self()->incompleteUnitCount(BWAPI::UnitTypes::Protoss_Pylon) <= 0){
+			// the pylon is started on the next update, ahead of this item
+			_buildOrder.pushFront(BuildItem{ Protoss_Pylon });
+			wake();
 			return;
+			// ensure that we have just the right amount of pylons, not too many
+		} else if (next.getUnit().getID() == BWAPI::UnitTypes::Protoss_Pylon.getID() && BWAPI::Broodwar->self()->supplyUsed() <= BWAPI::Broodwar->self()->supplyTotal() - 8){
+			_buildOrder.popFront();
+			wake();
+			return;
+		}
 
-		// short-hand aliases for game info
-		int minerals = BWAPI::Broodwar->self()->minerals();
-		int gas = BWAPI::Broodwar->self()->gas();
-		int supply = BWAPI::Broodwar->self()->supplyUsed();
+		if (!BWAPI::Broodwar->canMake(next.getUnit())){
+			// check if we have the prereqs for the unit, if not add it to build order
+			BWAPI::UnitType parentType = BuildMinimax::getParentType(next.getUnit());
+			if (!BuildMinimax::prereqObtained(next.getUnit()) && BWAPI::Broodwar->self()->incompleteUnitCount(parentType) <= 0){
+				Debug::message("Adding parent " + parentType.getName() + " for " + next.getUnit().getName());
+				//_buildOrder.pushFront(BuildItem{ parentType });
+			}
+		}
+	}
 
-		// if the next build item is a flag
-		if (next.isFlag()){
-			handleNewFlag(next.getFlag());
-			_lastFlag = next.getFlag();
-			_buildOrder.erase(_buildOrder.begin());
+	// decide which of the items near the front can be started without delaying the ones before them
+	int window = std::min(_buildOrder.size(), BuildScheduler::LOOKAHEAD);
+	std::vector<BuildScheduler::Candidate> candidates;
+	std::map<int, int> idleProducers;
+	for (int i = 0; i < window; i++){
+		candidates.push_back(getCandidate(_buildOrder.at(i)));
+		int producer = candidates.back()._producer;
+		if (producer != BuildScheduler::NO_PRODUCER && idleProducers.find(producer) == idleProducers.end())
+			idleProducers[producer] = getNumberOfIdleProducers(BWAPI::UnitType(producer));
+	}
+	std::vector<int> counts = BuildScheduler::scheduleItems(candidates, getScheduleResources(), idleProducers);
+
+	// start the scheduled items in build order, removing the ones that are finished
+	_assignedProducers.clear();
+	int removed = 0;
+	for (int i = 0; i < window; i++){
+		int index = i - removed;
+		BuildItem & item = _buildOrder.at(index);
+		// sleep until the soonest frame that an item left waiting could start, unless an event comes first
+		if (counts[i] < candidates[i]._count){
+			int wait = getFramesToWait(item);
+			if (wait != BuildSimulator::NEVER && frame + wait < _nextBuildFrame)
+				_nextBuildFrame = frame + wait;
 		}
-		else { // else, the next build item is something that should be trained/researched/upgraded
-			
-			// validate build orders by inserting build items needed before next item
-
-			if (next.getType() == Build::ItemTypes::UNIT){
-				// check if supply locked
-				// don't do anything if a pylon is already queued or under construction
-				if (next.getUnit().getID() != Protoss_Pylon.getID() && next.getUnit().supplyRequired() + supply > BWAPI::Broodwar->self()->supplyTotal()
-					&& BWAPI::Broodwar->self()->incompleteUnitCount(BWAPI::UnitTypes::Protoss_Pylon) <= 0){
-					_buildOrder.insert(_buildOrder.begin(), BuildItem{ Protoss_Pylon });
-					// ensure that we have just the right amount of pylons, not too many
-				} else if (next.getUnit().getID() == BWAPI::UnitTypes::Protoss_Pylon.getID() && BWAPI::Broodwar->self()->supplyUsed() <= BWAPI::Broodwar->self()->supplyTotal() - 8){
-					_buildOrder.erase(_buildOrder.begin());
-				}
-
-				if (!BWAPI::Broodwar->canMake(next.getUnit())){
-					// check if we have the prereqs for the unit, if not add it to build order
-					BWAPI::UnitType parentType = BuildMinimax::getParentType(next.getUnit());
-					if (!BuildMinimax::prereqObtained(next.getUnit()) && BWAPI::Broodwar->self()->incompleteUnitCount(parentType) <= 0){
-						Debug::message("Adding parent " + parentType.getName() + " for " + next.getUnit().getName());
-						//_buildOrder.insert(_buildOrder.begin(), BuildItem{ parentType });
-					}
-				}
-			}
+		bool finished = false;
+		for (int copy = 0; copy < counts[i]; copy++){
+			if (!startItem(item))
+				break;
+			// starting an item changes the resources and queue, so look again on the next update
+			wake();
+			finished = item.isFlag() || item.getType() != Build::ItemTypes::UNIT || item.getMultiplicity() <= 0;
+		}
+		if (finished){
+			_buildOrder.erase(index);
+			removed++;
+		}
+	}
+}
 
-			// check if we have enough resources to build the next build item
-			if (next.getMineralCost() <= (minerals - _queuedMinerals) && next.getGasCost() <= (gas - _queuedGas)){
-				if (next.getType() == Build::ItemTypes::UNIT){
-					trainUnit(next);
-				}
-				else if (next.getType() == Build::ItemTypes::TECH){
-					researchTech(next);
-				}
-				else if (next.getType() == Build::ItemTypes::UPGRADE){
-					purchaseUpgrade(next);
-				}
+BuildScheduler::Candidate MacroManager::getCandidate(const BuildItem & item){
+	BuildScheduler::Candidate candidate;
+	candidate._mineralCost = item.isFlag() ? 0 : item.getMineralCost();
+	candidate._gasCost = item.isFlag() ? 0 : item.getGasCost();
+	candidate._supplyCost = (!item.isFlag() && item.getType() == Build::ItemTypes::UNIT) ? item.getUnit().supplyRequired() : 0;
+	candidate._producer = item.isFlag() ? BuildScheduler::NO_PRODUCER : item.getParent().getID();
+	candidate._count = (!item.isFlag() && item.getType() == Build::ItemTypes::UNIT) ? item.getMultiplicity() : 1;
+	candidate._ready = buildRequirementsAreMet(item.getRequirements());
+	candidate._ordered = item.isOrdered();
+	// units also need every unit type they require to be completed
+	if (candidate._ready && !item.isFlag() && item.getType() == Build::ItemTypes::UNIT){
+		for (auto & required : item.getUnit().requiredUnits()){
+			if (_unitStorage.getCompletedCount(required.first) < 1){
+				candidate._ready = false;
+				break;
 			}
 		}
 	}
+	return candidate;
+}
+
+int MacroManager::getNumberOfIdleProducers(BWAPI::UnitType producerType){
+	// only one building is started each frame, since the builder is chosen from the workers' current orders
+	if (producerType.isWorker())
+		return getOptimalBuilder() ? 1 : 0;
+	int idle = 0;
+	for (auto & unit : _unitStorage.getUnitsOfType(producerType)){
+		if (unit->isCompleted() && unit->isIdle())
+			idle++;
+	}
+	return idle;
+}
+
+BuildScheduler::Resources MacroManager::getScheduleResources(){
+	BuildScheduler::Resources resources;
+	resources._minerals = BWAPI::Broodwar->self()->minerals() - _queuedMinerals;
+	resources._gas = BWAPI::Broodwar->self()->gas() - _queuedGas;
+	resources._supply = BWAPI::Broodwar->self()->supplyTotal() - BWAPI::Broodwar->self()->supplyUsed();
+	resources._mineralRate = _incomeForecast.getRate(IncomeForecast::MINERALS);
+	resources._gasRate = _incomeForecast.getRate(IncomeForecast::GAS);
+	return resources;
+}
+
+int MacroManager::getFramesToWait(const BuildItem & item){
+	int mineralsNeeded = item.isFlag() ? 0 : item.getMineralCost();
+	int gasNeeded = item.isFlag() ? 0 : item.getGasCost();
+	int wait = 0;
+	for (auto & requirement : item.getRequirements()){
+		switch (requirement.first){
+		case Build::ItemRequirements::MINERAL:
+			mineralsNeeded = std::max(mineralsNeeded, requirement.second);
+			break;
+		case Build::ItemRequirements::GAS:
+			gasNeeded = std::max(gasNeeded, requirement.second);
+			break;
+		case Build::ItemRequirements::TIME:
+			wait = std::max(wait, requirement.second - BWAPI::Broodwar->getFrameCount());
+			break;
+		}
+	}
+	int afford = _incomeForecast.getFramesToAfford(BWAPI::Broodwar->self()->minerals() - _queuedMinerals,
+		BWAPI::Broodwar->self()->gas() - _queuedGas, mineralsNeeded, gasNeeded);
+	if (afford == BuildSimulator::NEVER)
+		return BuildSimulator::NEVER;
+	// an item that's affordable now is waiting on an event (a producer, a requirement or supply)
+	if (afford == 0 && wait == 0)
+		return BuildSimulator::NEVER;
+	return std::max(afford, wait);
 }
 
-bool MacroManager::buildRequirementsAreMet(std::vector<req_value_pair_t> requirements){
+void MacroManager::updateIncomeForecast(){
+	_incomeForecast.observe(BWAPI::Broodwar->getFrameCount(), BWAPI::Broodwar->self()->gatheredMinerals(),
+		BWAPI::Broodwar->self()->gatheredGas(), _workerRegistry.getNumberOfMineralWorkers(), _workerRegistry.getNumberOfGasWorkers());
+}
+
+bool MacroManager::startItem(BuildItem & item){
+	if (item.isFlag()){
+		handleNewFlag(item.getFlag());
+		_lastFlag = item.getFlag();
+		return true;
+	}
+	switch (item.getType()){
+	case Build::ItemTypes::UNIT:
+		return trainUnit(item);
+	case Build::ItemTypes::TECH:
+		return researchTech(item);
+	case Build::ItemTypes::UPGRADE:
+		return purchaseUpgrade(item);
+	default:
+		return false;
+	}
+}
+
+bool MacroManager::buildRequirementsAreMet(const std::vector<req_value_pair_t> & requirements){
 	for (auto & requirement : requirements){
 		switch (requirement.first){
 		case Build::ItemRequirements::MINERAL:
@@ -105,8 +213,7 @@ bool MacroManager::buildRequirementsAreMet(std::vector<req_value_pair_t> require
 					return false;
 			}
 			else if (requirement.first >= Build::MY_UNIT_COUNT_ID){
-				if (static_cast<int>(_unitStorage.getUnitsOfType(BWAPI::UnitType(requirement.first - Build::MY_UNIT_COUNT_ID)).size())
-					< requirement.second)
+				if (_unitStorage.getCompletedCount(BWAPI::UnitType(requirement.first - Build::MY_UNIT_COUNT_ID)) < requirement.second)
 					return false;
 			}
 			break;
@@ -152,13 +259,12 @@ bool MacroManager::trainUnit(BuildItem & next){
 			if (!trainer->train(next.getUnit()))
 				return false;
 			_lastTrainer = trainer;
+			_assignedProducers.insert(trainer);
 		}
 
 		// successful build / train, so decrease the multiplicity of the build item by one
+		// (attemptBuildOrder removes it from the build order once there are no more of the unit type)
 		next.decreaseMulitplicity();
-		// if no more of unit type, then remove item from build order
-		if (next.getMultiplicity() <= 0)
-			_buildOrder.erase(_buildOrder.begin());
 		// if the unit needs to persist (ie. be rebuilt when destroyed), add to list 
 		if (next.isPersist()
 			&& std::find(_persistUnitTypes.begin(), _persistUnitTypes.end(), next.getUnit())
@@ -182,8 +288,7 @@ bool MacroManager::researchTech(BuildItem & next){
 		if (!researcher->research(next.getTech()))
 			return false;
 		_lastResearcher = researcher;
-		// successfully researched tech, erase item from build order
-		_buildOrder.erase(_buildOrder.begin());
+		_assignedProducers.insert(researcher);
 		return true;
 	}
 	else {
@@ -201,8 +306,7 @@ bool MacroManager::purchaseUpgrade(BuildItem & next){
 		if (!upgrader->upgrade(next.getUpgrade()))
 			return false;
 		_lastUpgrader = upgrader;
-		// successfully purchased upgrade, erase item from build order
-		_buildOrder.erase(_buildOrder.begin());
+		_assignedProducers.insert(upgrader);
 		return true;
 	}
 	else {
@@ -227,6 +331,9 @@ BWAPI::Unit MacroManager::getOptimalTrainer(BWAPI::UnitType trainerType){
 	BWAPI::Unit trainer = nullptr;
 	// for each unit that is a potential trainer
 	for (auto & unit : _unitStorage.getUnitsOfType(trainerType)){
+		// skip trainers already given a unit this frame, whose queues aren't updated yet
+		if (_assignedProducers.count(unit) > 0)
+			continue;
 		// choose trainer if not incomplete and nothing is in queue
 		if (unit->isCompleted() && unit->getTrainingQueue().size() == 0){
 			trainer = unit;
@@ -243,8 +350,10 @@ BWAPI::Unit MacroManager::getOptimalTrainer(BWAPI::UnitType trainerType){
 
 BWAPI::Unit MacroManager::getOptimalResearcher(BWAPI::UnitType researcherType){
 	BWAPI::Unit researcher = nullptr;
-	// any researcher is fine, since it's unlikely we have more than one of that type
+	// any idle researcher is fine, since it's unlikely we have more than one of that type
 	for (auto & unit : _unitStorage.getUnitsOfType(researcherType)){
+		if (_assignedProducers.count(unit) > 0)
+			continue;
 		researcher = unit;
 		break;
 	}
@@ -253,8 +362,10 @@ BWAPI::Unit MacroManager::getOptimalResearcher(BWAPI::UnitType researcherType){
 
 BWAPI::Unit MacroManager::getOptimalUpgrader(BWAPI::UnitType upgraderType){
 	BWAPI::Unit upgrader = nullptr;
-	// any upgrader is fine, since it's unlikely we have more than one of that type
+	// any idle upgrader is fine, since it's unlikely we have more than one of that type
 	for (auto & unit : _unitStorage.getUnitsOfType(upgraderType)){
+		if (_assignedProducers.count(unit) > 0)
+			continue;
 		upgrader = unit;
 		break;
 	}
@@ -262,42 +373,21 @@ BWAPI::Unit MacroManager::getOptimalUpgrader(BWAPI::UnitType upgraderType){
 }
 
 bool MacroManager::buildStructure(BWAPI::Unit worker, BWAPI::UnitType building){
-	BWAPI::TilePosition targetBuildLocation = BWAPI::Broodwar->getBuildLocation(building, worker->getTilePosition());
-	
-	// make sure there aren't any units in the way
-	BWAPI::Unitset units = BWAPI::Broodwar->getUnitsInRectangle(BWAPI::Position(targetBuildLocation), BWAPI::Position(targetBuildLocation + building.tileSize()));
-	for (auto & unit : units){
-		// ignore geysers, flying units and stationary units
-		if (building.isRefinery() && unit->getType().getID() == BWAPI::UnitTypes::Resource_Vespene_Geyser.getID()
-			|| unit->isFlying() || !unit->canMove())
-			continue;
-		else {
-			unit->move(unit->getClosestUnit(BWAPI::Filter::IsResourceDepot)->getPosition());
-			return false;
-		}
-	}
-
-	if (!targetBuildLocation)
+	// sites whose workers never started building are free to use again
+	_placementGrid.expireReservations(BWAPI::Broodwar->getFrameCount());
+	BWAPI::TilePosition targetBuildLocation = _placementGrid.findSite(building, worker->getTilePosition());
+	if (targetBuildLocation == BWAPI::TilePositions::Invalid)
 		return false;
-	
-	// register an event that draws the target build location
-	BWAPI::Broodwar->registerEvent([targetBuildLocation, building](BWAPI::Game*)
-			{
-				BWAPI::Broodwar->drawBoxMap(BWAPI::Position(targetBuildLocation),
-					BWAPI::Position(targetBuildLocation + building.tileSize()),
-						BWAPI::Colors::Blue);
-			},
-			nullptr,  // no condition to run
-			building.buildTime() + 100);  // frames to run
-
-	// last check to see if the building can be built at given location
-	if (BWAPI::Broodwar->canBuildHere(targetBuildLocation, building, worker)){
+
+	if (worker->build(building, targetBuildLocation)){
+		// reserve the site so that the next building isn't placed on it while the worker is moving there
+		_placementGrid.reserve(building, targetBuildLocation, BWAPI::Broodwar->getFrameCount() + RESERVATION_FRAMES);
+		// the worker leaves its patch, and is given one again once it's idle
+		_workerRegistry.unassign(worker->getID());
 		// queue resources so that they can't be used for the next build item while worker is moving to build site
-		if (worker->build(building, targetBuildLocation)){
-			_queuedMinerals += building.mineralPrice();
-			_queuedGas += building.gasPrice();
-			return true;
-		}
+		_queuedMinerals += building.mineralPrice();
+		_queuedGas += building.gasPrice();
+		return true;
 	}
 	return false;
 }
@@ -318,33 +408,36 @@ void MacroManager::onBuildingDestroyed(BWAPI::Unit unit){
 	// in general, it may be safer to just rely on missing dependencies
 	// so you will only build what is necessary for future builds
 	if (std::find(_persistUnitTypes.begin(), _persistUnitTypes.end(), unit->getType()) != _persistUnitTypes.end())
-		_buildOrder.insert(_buildOrder.begin(), BuildItem{unit->getType()});
+		_buildOrder.pushFront(BuildItem{unit->getType()});
+	wake();
 }
 
 void MacroManager::update()
 {
-	// try building the next build item
-	attemptBuildOrder();
+	updateIncomeForecast();
+	// try building the next build items, unless nothing that could let one start has happened since the last try
+	if (BWAPI::Broodwar->getFrameCount() >= _nextBuildFrame)
+		attemptBuildOrder();
 	
-	// ensure every refinery has three workers harvesting
-	for (auto & refineryWorkerPair : _unitStorage.getRefineryUnits()){
-		int workersNeeded = 3 - refineryWorkerPair.second;
-		// if no workers are needed, skip this refinery
-		if (workersNeeded <= 0)
-			continue;
-		// try to get the workers needed and order them to gather; increment count by actual number acquired
-		BWAPI::Unitset workers = _unitStorage.getNUnitsOfCategory(UnitStorage::WORKER, workersNeeded, BWAPI::Filter::IsIdle || !BWAPI::Filter::IsCarryingSomething && !BWAPI::Filter::IsConstructing);
-		workers.gather(refineryWorkerPair.first);
-		refineryWorkerPair.second += workers.size();
+	// fill refineries that need workers, taking them from the most occupied mineral patches
+	while (_workerRegistry.getRefineryNeedingWorkers() != NO_UNIT_ID){
+		int worker = _workerRegistry.takeMineralWorker();
+		if (worker == NO_UNIT_ID)
+			break;
+		gatherFrom(worker, _workerRegistry.assignGas(worker));
 	}
 
-	// delegate remaining idle units to nearest minerals, and return held resources to nearest depot
+	// send idle workers back to their resource (or to the least occupied mineral patch), and return held resources
 	for (auto & unit : _unitStorage.getUnits(UnitStorage::WORKER)){
 		if (unit->isIdle())
 			if (unit->isCarryingGas() || unit->isCarryingMinerals())
 				unit->returnCargo();
-			else
-				unit->gather(unit->getClosestUnit(IsMineralField));
+			else {
+				int resource = _workerRegistry.getResource(unit->getID());
+				if (resource == NO_UNIT_ID)
+					resource = _workerRegistry.assignMinerals(unit->getID());
+				gatherFrom(unit->getID(), resource);
+			}
 	}
 	 
 	// if the current flag is still to invade all in, then continue adding units to control groups with that flag
@@ -354,25 +447,162 @@ void MacroManager::update()
 	}
 
 	updateTargetTech();
+	planTargetTech();
 }
 
 void MacroManager::updateTargetTech(){
 	_targetTech = BuildItem{ BuildMinimax::getTargetTech() };
 }
 
-std::vector<BuildItem> MacroManager::getBuildOrder(){
+void MacroManager::planTargetTech(){
+	// only plan once the hand-written build order is done, and only for tech that we don't have yet
+	BWAPI::UnitType target = _targetTech.getUnit();
+	if (!_buildOrder.isEmpty() || BWAPI::Broodwar->self()->allUnitCount(target) > 0)
+		return;
+	// don't keep retrying a target that couldn't be planned for
+	if (target == _plannedTech && _targetTechFrame == BuildSimulator::NEVER)
+		return;
+	BuildPlanner::BuildGoal goal;
+	if (!goal.add(target))
+		return;
+
+	BuildSimulator::SimState state;
+	BuildSimulator::initGameState(state, BWAPI::Broodwar->self());
+	BuildPlanner::BuildPlan plan = BuildPlanner::planBuildOrder(state, goal);
+	_plannedTech = target;
+	_targetTechFrame = plan._makespan;
+	if (plan._makespan != BuildSimulator::NEVER){
+		Debug::message("Planned " + std::to_string(plan._buildOrder.size()) + " items to reach " + target.getName());
+		_buildOrder = plan._buildOrder;
+		wake();
+	}
+}
+
+const BuildQueue & MacroManager::getBuildOrder() const{
 	return _buildOrder;
 }
 
-void MacroManager::setBuildOrder(std::vector<BuildItem> buildOrder){
+void MacroManager::setBuildOrder(const std::vector<BuildItem> & buildOrder){
 	_buildOrder = buildOrder;
+	wake();
+}
+
+void MacroManager::setBuildOrder(const BuildOrderScript::LoadedBuildOrder & buildOrder){
+	_buildOrder.clear();
+	for (int i = 0; i < buildOrder._size; i++)
+		_buildOrder.pushBack(buildOrder.getItem(i));
+	wake();
+}
+
+bool MacroManager::loadBuildOrder(const std::string & path, const std::string & name, std::string & error){
+	BuildOrderScript::BuildOrderLibrary library;
+	if (!library.load(path, error))
+		return false;
+	BuildOrderScript::LoadedBuildOrder buildOrder;
+	if (!library.findBuildOrder(name, buildOrder)){
+		error = "no build order named " + name + " in " + path;
+		return false;
+	}
+	setBuildOrder(buildOrder);
+	return true;
+}
+
+void MacroManager::wake(){
+	_nextBuildFrame = 0;
+}
+
+int MacroManager::getNextBuildFrame() const{
+	return _nextBuildFrame;
+}
+
+const IncomeForecast & MacroManager::getIncomeForecast() const{
+	return _incomeForecast;
+}
+
+PlacementGrid * MacroManager::getPlacementGrid(){
+	return &_placementGrid;
+}
+
+WorkerRegistry * MacroManager::getWorkerRegistry(){
+	return &_workerRegistry;
+}
+
+void MacroManager::gatherFrom(int worker, int resource){
+	BWAPI::Unit workerUnit = BWAPI::Broodwar->getUnit(worker);
+	BWAPI::Unit resourceUnit = BWAPI::Broodwar->getUnit(resource);
+	if (!workerUnit || !resourceUnit)
+		return;
+	// a worker switching resources drops off what it's carrying first
+	if (workerUnit->isCarryingMinerals() || workerUnit->isCarryingGas()){
+		workerUnit->returnCargo();
+		workerUnit->gather(resourceUnit, true);
+	}
+	else
+		workerUnit->gather(resourceUnit);
+}
+
+void MacroManager::reassignWorkers(const std::vector<int> & workers){
+	for (int worker : workers)
+		gatherFrom(worker, _workerRegistry.assignMinerals(worker));
+}
+
+void MacroManager::addBase(BWAPI::Unit depot){
+	// the distances that workers return cargo over are worked out once, when the base is added
+	std::vector<std::pair<int, int>> minerals;
+	for (auto & mineral : BWAPI::Broodwar->getMinerals()){
+		int distance = depot->getPosition().getApproxDistance(mineral->getPosition());
+		if (distance <= BASE_RADIUS)
+			minerals.push_back(std::make_pair(mineral->getID(), distance));
+	}
+	_workerRegistry.addBase(depot->getID(), minerals);
+
+	// move workers from crowded patches to the new ones
+	for (int worker = _workerRegistry.takeOversaturatedWorker(); worker != NO_UNIT_ID; worker = _workerRegistry.takeOversaturatedWorker())
+		gatherFrom(worker, _workerRegistry.assignMinerals(worker));
+}
+
+void MacroManager::addRefinery(BWAPI::Unit refinery){
+	BWAPI::Unit closestDepot = nullptr;
+	int closestDistance = INT_MAX;
+	for (auto & depot : _unitStorage.getUnits(UnitStorage::BASE)){
+		int distance = depot->getPosition().getApproxDistance(refinery->getPosition());
+		if (distance < closestDistance){
+			closestDepot = depot;
+			closestDistance = distance;
+		}
+	}
+	if (closestDepot)
+		_workerRegistry.addRefinery(refinery->getID(), closestDepot->getID(), closestDistance);
+}
+
+void MacroManager::onUnitCompleted(BWAPI::Unit unit){
+	if (unit->getType().isWorker()){
+		_workerRegistry.addWorker(unit->getID());
+		gatherFrom(unit->getID(), _workerRegistry.assignMinerals(unit->getID()));
+	}
+	else if (unit->getType().isResourceDepot())
+		addBase(unit);
+	else if (unit->getType().isRefinery())
+		addRefinery(unit);
+}
+
+void MacroManager::onUnitDestroyed(BWAPI::Unit unit){
+	if (_workerRegistry.isWorker(unit->getID()))
+		_workerRegistry.removeWorker(unit->getID());
+	else if (unit->getType().isResourceDepot())
+		reassignWorkers(_workerRegistry.removeBase(unit->getID()));
+	else
+		reassignWorkers(_workerRegistry.removeResource(unit->getID()));
 }
 
 
 void MacroManager::draw(){
-	// draw build order list
+	// draw build order list, with the time until each item can be afforded at the forecast income
+	int minerals = BWAPI::Broodwar->self()->minerals() - _queuedMinerals;
+	int gas = BWAPI::Broodwar->self()->gas() - _queuedGas;
 	int counter = 3;
-	for (BuildItem bi : _buildOrder){
+	for (int i = 0; i < _buildOrder.size(); i++){
+		const BuildItem & bi = _buildOrder.at(i);
 		std::string s;
 		if (bi.isFlag()){
 			s = "Flag";
@@ -389,6 +619,11 @@ void MacroManager::draw(){
 				s = bi.getUpgrade().getName() + std::string(" lvl") + std::to_string(bi.getLevel());
 				break;
 			}
+			int frames = _incomeForecast.getFramesToAfford(minerals, gas, bi.getMineralCost(), bi.getGasCost());
+			if (frames == BuildSimulator::NEVER)
+				s += " (no income)";
+			else if (frames > 0)
+				s += " (" + std::to_string(frames) + " frames)";
 		}
 		Debug::log(s, counter);
 		counter++;
@@ -409,4 +644,25 @@ void MacroManager::draw(){
 
 	// draw the target tech
 	Debug::log("The target tech is " + _targetTech.getUnit().getName(), 10, 100);
+
+	// draw the tech search, income and worker diagnostics
+	if (Debug::DRAW_MACRO_STATS){
+		Debug::log("Tech search hit rate: " + std::to_string(static_cast<int>(BuildMinimax::getTranspositionTable().getHitRate() * 100)) + "%", 11, 100);
+		Debug::log("Tech searches run: " + std::to_string(BuildMinimax::getSearchWorker().getSearchesRun())
+			+ " / " + std::to_string(BuildMinimax::getSearchWorker().getRequestsPosted()) + " requested", 12, 100);
+		BuildMinimax::SearchStats searchStats = BuildMinimax::getLastSearchStats();
+		Debug::log("Last tech search: depth " + std::to_string(searchStats._depth) + ", " + std::to_string(searchStats._nodes) + " nodes, "
+			+ std::to_string(searchStats._wallTime) + "us", 13, 100);
+		Debug::log("Target tech planned for frame " + std::to_string(_targetTechFrame), 14, 100);
+
+		// draw the income forecast, per minute of game time
+		Debug::log("Income per minute: " + std::to_string(_incomeForecast.getRate(IncomeForecast::MINERALS) * 1440 / BuildSimulator::RESOURCE_SCALE)
+			+ " minerals, " + std::to_string(_incomeForecast.getRate(IncomeForecast::GAS) * 1440 / BuildSimulator::RESOURCE_SCALE) + " gas", 15, 100);
+		Debug::log("Build order sleeps until frame " + std::to_string(_nextBuildFrame), 16, 100);
+		Debug::log("Workers assigned: " + std::to_string(_workerRegistry.getNumberOfMineralWorkers()) + " minerals, "
+			+ std::to_string(_workerRegistry.getNumberOfGasWorkers()) + " gas", 17, 100);
+	}
+
+	// draw the sites reserved for buildings
+	_placementGrid.draw();
 }
\ No newline at end of file
@@ -10,9 +10,16 @@
 
 #include <BWAPI.h>
 #include "BuildItem.h"
+#include "BuildQueue.h"
 #include "BuildOrders.h"
 #include "MicroManager.h"
 #include "BuildMinimax.h"
+#include "BuildPlanner.h"
+#include "BuildScheduler.h"
+#include "IncomeForecast.h"
+#include "BuildOrderScript.h"
+#include "PlacementGrid.h"
+#include "WorkerRegistry.h"
 
 using namespace BWAPI::UnitTypes;
 using namespace BWAPI::TechTypes;
@@ -21,6 +28,8 @@ using namespace BWAPI::UpgradeTypes;
 namespace ProBot
 {
 	const int MAX_QUEUE_SIZE = 5;
+	// most frames that the build order sleeps between attempts, for changes that no event announces (such as finished research)
+	const int MAX_BUILD_SLEEP_FRAMES = 96;
 
 	class MacroManager
 	{
@@ -37,12 +46,66 @@ namespace ProBot
 
 		// the build item that should be built, based on minimax algorithm
 		BuildItem _targetTech;
+		// frame on which the planned build order finishes the target tech, or BuildSimulator::NEVER if there is no plan
+		int _targetTechFrame = BuildSimulator::NEVER;
+		// the target tech that was last planned for
+		BWAPI::UnitType _plannedTech;
 		// unit types (building only) that should be rebuilt when destroyed
 		std::vector<BWAPI::UnitType> _persistUnitTypes;
 
 		int _queuedMinerals = 0;
 		int _queuedGas = 0;
-		std::vector<BuildItem> _buildOrder = BuildOrders::BASIC_DRAGOON;
+		BuildQueue _buildOrder = BuildOrders::BASIC_DRAGOON;
+		// trainers, researchers and upgraders given an order during the current call to attemptBuildOrder
+		BWAPI::Unitset _assignedProducers;
+		IncomeForecast _incomeForecast;
+		// frame on which the build order is next attempted, unless an event wakes it earlier
+		int _nextBuildFrame = 0;
+		PlacementGrid _placementGrid;
+		WorkerRegistry _workerRegistry;
+
+		/**
+			Returns the scheduler's view of a build item, checking whether its requirements are met.
+		*/
+		BuildScheduler::Candidate getCandidate(const BuildItem &);
+		/**
+			Returns the number of completed producers of the given type that could start an item this frame.
+		*/
+		int getNumberOfIdleProducers(BWAPI::UnitType);
+		/**
+			Returns the resources and income that scheduled items are paid from.
+		*/
+		BuildScheduler::Resources getScheduleResources();
+		/**
+			Returns the number of frames until a build item that couldn't be started may become startable without an event:
+			when it becomes affordable at the forecast income, or when its time requirement passes.
+		*/
+		int getFramesToWait(const BuildItem &);
+		/**
+			Observes the resources gathered and the number of gathering workers.
+		*/
+		void updateIncomeForecast();
+		/**
+			Orders the worker with the given ID to gather from the resource with the given ID, if both exist.
+		*/
+		void gatherFrom(int worker, int resource);
+		/**
+			Sends workers that lost their resource to the least occupied mineral patches.
+		*/
+		void reassignWorkers(const std::vector<int> &);
+		/**
+			Registers the mineral patches around a new resource depot, then moves workers over from crowded patches.
+		*/
+		void addBase(BWAPI::Unit);
+		/**
+			Registers a refinery with the closest resource depot.
+		*/
+		void addRefinery(BWAPI::Unit);
+		/**
+			Starts one copy of a build item (or handles a flag). Doesn't remove it from the build order.
+			@return true if the item was started, false otherwise
+		*/
+		bool startItem(BuildItem &);
 
 	public:
 		MacroManager();
@@ -59,13 +122,18 @@ namespace ProBot
 		*/
 		void updateTargetTech();
 		/**
-			Attempts creation of next build item in queue by checking if the requirements are met.
+			Plans the quickest build order to the target tech once the current build order has run out.
+		*/
+		void planTargetTech();
+		/**
+			Attempts creation of the build items near the front of the queue whose requirements are met,
+			starting later items on idle producers when that doesn't delay the ones before them.
 		*/
 		void attemptBuildOrder();
 		/**
 			Returns true if all requirements for a build item are met, false otherwise.
 		*/
-		bool buildRequirementsAreMet(std::vector<req_value_pair_t>);
+		bool buildRequirementsAreMet(const std::vector<req_value_pair_t> &);
 		/**
 			Delegates units into control groups based on the newest flag.
 		*/
@@ -95,6 +163,32 @@ namespace ProBot
 			@return true if building successfully constructed, false otherwise
 		*/
 		bool buildStructure(BWAPI::Unit, BWAPI::UnitType);
+		/**
+			Makes the build order be attempted on the next update, after an event that may let a build item start.
+		*/
+		void wake();
+		/**
+			Returns the frame on which the build order is next attempted, unless an event wakes it earlier.
+		*/
+		int getNextBuildFrame() const;
+		const IncomeForecast & getIncomeForecast() const;
+		/**
+			Returns the grids used to place buildings, which the unit event handlers keep up to date.
+		*/
+		PlacementGrid * getPlacementGrid();
+		/**
+			Returns the resource that each worker gathers from, kept up to date by the unit event handlers.
+		*/
+		WorkerRegistry * getWorkerRegistry();
+		/**
+			Event handler for own unit completion, which registers workers and the resources of new bases.
+		*/
+		void onUnitCompleted(BWAPI::Unit);
+		/**
+			Event handler for the destruction of any unit (including a mined out patch or a refinery that reverts to a geyser),
+			which reassigns the workers of lost resources.
+		*/
+		void onUnitDestroyed(BWAPI::Unit);
 		/**
 			Event handler for building creation.
 		*/
@@ -104,8 +198,20 @@ namespace ProBot
 		*/
 		void onBuildingDestroyed(BWAPI::Unit);
 
-		std::vector<BuildItem> getBuildOrder();
-		void setBuildOrder(std::vector<BuildItem>);
+		const BuildQueue & getBuildOrder() const;
+		void setBuildOrder(const std::vector<BuildItem> &);
+		/**
+			Replaces the build order with one loaded from a script, copying its items out of the library.
+		*/
+		void setBuildOrder(const BuildOrderScript::LoadedBuildOrder &);
+		/**
+			Loads the given script and plays the named build order from it.
+			@param path - path of the script
+			@param name - name of the build order in the script
+			@param error - set to a description of the problem if the build order can't be loaded
+			@return true if the build order was replaced, false if the current one was kept
+		*/
+		bool loadBuildOrder(const std::string & path, const std::string & name, std::string & error);
 
 		KnowledgeBank * getKnowledgeBank();
 		UnitStorage * getUnitStorage();
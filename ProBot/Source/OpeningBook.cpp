@@ -0,0 +1,206 @@
+/**
+	OpeningBook.cpp
+	Tech choices for early game states, searched offline and compiled into the DLL as sorted tables.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "OpeningBook.h"
+#include "BuildMinimax.h"
+#include "CombatUtil.h"
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <set>
+
+using namespace ProBot;
+using namespace OpeningBook;
+
+namespace {
+	/**
+		Returns true if the tree has the same nodes, in the same slots, as a tree built from the definition.
+	*/
+	bool matchesDefinition(const TechTreeStore & tree, const TechTreeDef & def){
+		if (tree.size() != def._size)
+			return false;
+		for (tech_slot_t slot = 0; slot < tree.size(); slot++){
+			if (tree[slot]._unitType != BWAPI::UnitType(def._nodes[slot]._unitType) || tree[slot]._parent != def._nodes[slot]._parent)
+				return false;
+		}
+		return true;
+	}
+
+	bool isEntryBefore(const BookEntry & first, const BookEntry & second){
+		if (first._selfState != second._selfState)
+			return first._selfState < second._selfState;
+		return first._enemyState < second._enemyState;
+	}
+
+	/**
+		Adds every state of the tree reachable in up to the given number of moves (including its current state) to the list.
+	*/
+	void enumerateStates(const TechTreeStore & tree, int maxMoves, std::set<tech_mask_t> & seen, std::vector<TechTreeStore> & states){
+		if (seen.count(tree.getObtainedMask()) > 0)
+			return;
+		seen.insert(tree.getObtainedMask());
+		states.push_back(tree);
+		if (maxMoves <= 0)
+			return;
+		std::vector<BWAPI::UnitType> moves = BuildMinimax::generateMoves(tree);
+		for (BWAPI::UnitType move : moves){
+			// obtain the move the same way as BuildMinimax::addTechType does for a unit seen in the game
+			TechTreeStore next = tree;
+			next.setPrereqsObtained(move);
+			next.setBuildingNodeObtained(move);
+			enumerateStates(next, maxMoves - 1, seen, states);
+		}
+	}
+
+	/**
+		Returns the C++ name of a race's enumeration value.
+	*/
+	std::string getRaceEnumName(BWAPI::Race race){
+		return "BWAPI::Races::Enum::" + race.getName();
+	}
+}
+
+OpeningBookDef GeneratedBook::getDef() const{
+	OpeningBookDef def;
+	def._selfRace = static_cast<BWAPI::Races::Enum::Enum>(_selfRace.getID());
+	def._enemyRace = static_cast<BWAPI::Races::Enum::Enum>(_enemyRace.getID());
+	def._depth = _depth;
+	def._entries = _entries.empty() ? NULL : &_entries[0];
+	def._size = static_cast<int>(_entries.size());
+	return def;
+}
+
+tech_slot_t OpeningBook::lookupMove(const OpeningBookDef & book, const TechTreeStore & self, const TechTreeStore & enemy){
+	// the book was searched without removed nodes, on trees built from the race definitions
+	if (book._size == 0 || self.getRemovedMask() != 0 || enemy.getRemovedMask() != 0)
+		return NULL_SLOT;
+	if (!matchesDefinition(self, getTreeDef(BWAPI::Race(book._selfRace))) || !matchesDefinition(enemy, getTreeDef(BWAPI::Race(book._enemyRace))))
+		return NULL_SLOT;
+
+	BookEntry key;
+	key._selfState = self.getObtainedMask();
+	key._enemyState = enemy.getObtainedMask();
+	const BookEntry * end = book._entries + book._size;
+	const BookEntry * entry = std::lower_bound(book._entries, end, key, isEntryBefore);
+	if (entry == end || entry->_selfState != key._selfState || entry->_enemyState != key._enemyState)
+		return NULL_SLOT;
+	return entry->_move;
+}
+
+tech_slot_t OpeningBook::lookupMove(const TechTreeStore & self, const TechTreeStore & enemy, int minDepth, int & depth){
+	for (int i = 0; i < NUM_OPENING_BOOKS; i++){
+		if (OPENING_BOOKS[i]._depth < minDepth)
+			continue;
+		tech_slot_t move = lookupMove(OPENING_BOOKS[i], self, enemy);
+		if (move != NULL_SLOT){
+			depth = OPENING_BOOKS[i]._depth;
+			return move;
+		}
+	}
+	return NULL_SLOT;
+}
+
+bool OpeningBook::generateBook(BWAPI::Race selfRace, BWAPI::Race enemyRace, int maxMoves, int depth, GeneratedBook & book){
+	const TechTreeDef & selfDef = getTreeDef(selfRace);
+	const TechTreeDef & enemyDef = getTreeDef(enemyRace);
+	if (selfDef._size == 0 || enemyDef._size == 0)
+		return false;
+	depth = (depth < BuildMinimax::MAX_DEPTH) ? depth : BuildMinimax::MAX_DEPTH;
+
+	std::set<tech_mask_t> seen;
+	std::vector<TechTreeStore> selfStates;
+	enumerateStates(getBaseTreeStore(selfRace), maxMoves, seen, selfStates);
+	seen.clear();
+	std::vector<TechTreeStore> enemyStates;
+	enumerateStates(getBaseTreeStore(enemyRace), maxMoves, seen, enemyStates);
+
+	book._selfRace = selfRace;
+	book._enemyRace = enemyRace;
+	book._depth = depth;
+	book._entries.clear();
+	BuildMinimax::SearchContext search(BuildMinimax::getTranspositionTable());
+	BuildMinimax::clearSearchHistory(search);
+	for (const TechTreeStore & self : selfStates){
+		for (const TechTreeStore & enemy : enemyStates){
+			BuildMinimax::initSearchState(search, self, enemy);
+			tech_slot_t move = BuildMinimax::minimaxAlphaBeta(search, depth, BuildMinimax::SELF, INT_MIN, INT_MAX).first;
+			// states without a move are searched just as quickly at runtime
+			if (move == NULL_SLOT)
+				continue;
+			BookEntry entry;
+			entry._selfState = self.getObtainedMask();
+			entry._enemyState = enemy.getObtainedMask();
+			entry._move = move;
+			book._entries.push_back(entry);
+		}
+	}
+	std::sort(book._entries.begin(), book._entries.end(), isEntryBefore);
+	return true;
+}
+
+bool OpeningBook::writeBookSource(const std::string & path, const std::vector<GeneratedBook> & books){
+	std::ofstream file(path.c_str());
+	if (!file.is_open()){
+		return false;
+	}
+	file << "/**\n"
+		<< "\tOpeningBookData.cpp\n"
+		<< "\tCompiled opening book tables. Generated by OpeningBook::generateBookSource (see OpeningBookGenerator in the tests); don't edit by hand.\n"
+		<< "\n"
+		<< "\t@author Paul Wang\n"
+		<< "\t@version 9/8/16\n"
+		<< "*/\n\n"
+		<< "#include \"OpeningBook.h\"\n\n"
+		<< "using namespace ProBot;\n"
+		<< "using namespace OpeningBook;\n\n";
+
+	if (books.empty()){
+		file << "// no books have been generated\n"
+			<< "const OpeningBookDef * const OpeningBook::OPENING_BOOKS = NULL;\n"
+			<< "const int OpeningBook::NUM_OPENING_BOOKS = 0;\n";
+		return file.good();
+	}
+
+	for (size_t i = 0; i < books.size(); i++){
+		const GeneratedBook & book = books[i];
+		file << "// " << book._selfRace.getName() << " versus " << book._enemyRace.getName() << ", searched to depth " << book._depth << "\n"
+			<< "static const BookEntry BOOK_" << i << "[] = {\n";
+		for (const BookEntry & entry : book._entries){
+			file << "\t{ 0x" << std::hex << entry._selfState << "ULL, 0x" << entry._enemyState << "ULL, "
+				<< std::dec << entry._move << " },\n";
+		}
+		// an empty array isn't allowed, so an empty book still gets an (unused) entry
+		if (book._entries.empty())
+			file << "\t{ 0x0ULL, 0x0ULL, NULL_SLOT },\n";
+		file << "};\n\n";
+	}
+	file << "static const OpeningBookDef BOOKS[] = {\n";
+	for (size_t i = 0; i < books.size(); i++){
+		const GeneratedBook & book = books[i];
+		file << "\t{ " << getRaceEnumName(book._selfRace) << ", " << getRaceEnumName(book._enemyRace) << ", " << book._depth
+			<< ", BOOK_" << i << ", " << book._entries.size() << " },\n";
+	}
+	file << "};\n\n"
+		<< "const OpeningBookDef * const OpeningBook::OPENING_BOOKS = BOOKS;\n"
+		<< "const int OpeningBook::NUM_OPENING_BOOKS = sizeof(BOOKS) / sizeof(BOOKS[0]);\n";
+	return file.good();
+}
+
+bool OpeningBook::generateBookSource(const std::string & path, int maxMoves, int depth){
+	// the search evaluates moves with the unit type scores, which are only computed once per process
+	CombatUtil::initStaticTables();
+	BWAPI::Race enemyRaces[] = { BWAPI::Races::Protoss, BWAPI::Races::Terran, BWAPI::Races::Zerg };
+	std::vector<GeneratedBook> books;
+	for (BWAPI::Race enemyRace : enemyRaces){
+		GeneratedBook book;
+		if (!generateBook(BWAPI::Races::Protoss, enemyRace, maxMoves, depth, book))
+			return false;
+		books.push_back(book);
+	}
+	return writeBookSource(path, books);
+}
@@ -0,0 +1,97 @@
+/**
+	OpeningBook.h
+	Tech choices for early game states, searched offline and compiled into the DLL as sorted tables.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+#include <BWAPI.h>
+#include <string>
+#include <vector>
+#include "TechTreeStore.h"
+
+namespace ProBot{
+	namespace OpeningBook{
+		// default number of moves from the base tree that each player's states are enumerated to
+		const int DEFAULT_BOOK_MOVES = 4;
+		// default depth of the search run for each pair of states
+		const int DEFAULT_BOOK_DEPTH = 10;
+
+		/**
+			The move searched for one pair of obtained states. Plain data, so that the tables are built by the compiler.
+		*/
+		struct BookEntry {
+			tech_mask_t _selfState;
+			tech_mask_t _enemyState;
+			// slot of SELF's tree to obtain next
+			tech_slot_t _move;
+		};
+
+		/**
+			The entries searched for one pair of race trees, sorted by SELF's state and then ENEMY's state.
+			Slots refer to the trees built from the race definitions (see getTreeDef).
+		*/
+		struct OpeningBookDef {
+			BWAPI::Races::Enum::Enum _selfRace;
+			BWAPI::Races::Enum::Enum _enemyRace;
+			// depth that each entry was searched to
+			int _depth;
+			const BookEntry * _entries;
+			int _size;
+		};
+
+		// the books compiled into the DLL (generated by generateBookSource into OpeningBookData.cpp)
+		extern const OpeningBookDef * const OPENING_BOOKS;
+		extern const int NUM_OPENING_BOOKS;
+
+		/**
+			A book built by generateBook, which owns its entries.
+		*/
+		struct GeneratedBook {
+			BWAPI::Race _selfRace;
+			BWAPI::Race _enemyRace;
+			int _depth;
+			std::vector<BookEntry> _entries;
+
+			/**
+				Returns a definition referring to the entries, valid as long as the entries aren't changed.
+			*/
+			OpeningBookDef getDef() const;
+		};
+
+		/**
+			Returns the book's move for the given trees, or NULL_SLOT if the trees aren't those the book was built for,
+			either tree has removed nodes or the pair of states isn't in the book.
+		*/
+		tech_slot_t lookupMove(const OpeningBookDef & book, const TechTreeStore & self, const TechTreeStore & enemy);
+		/**
+			Looks the given trees up in the compiled books that were searched to at least the given depth.
+			@param minDepth - the shallowest book depth to use
+			@param depth - set to the depth of the book the move was found in
+			@return the move, or NULL_SLOT if no book has it
+		*/
+		tech_slot_t lookupMove(const TechTreeStore & self, const TechTreeStore & enemy, int minDepth, int & depth);
+
+		/**
+			Builds a book offline: enumerates each player's tree states reachable from the base tree of its race
+			in up to maxMoves moves (obtained the same way as units seen in a game), and searches every pair to the given depth.
+			Uses the game's transposition table, so it must not be run while a game is searching.
+			@return false if either race has no tree
+		*/
+		bool generateBook(BWAPI::Race selfRace, BWAPI::Race enemyRace, int maxMoves, int depth, GeneratedBook & book);
+		/**
+			Writes the given books as the C++ source of the compiled tables (OpeningBookData.cpp).
+			@return true if the file was written, false otherwise
+		*/
+		bool writeBookSource(const std::string & path, const std::vector<GeneratedBook> & books);
+		/**
+			Generates the books compiled into the DLL, Protoss versus each race, and writes them to the given path
+			(normally ProBot/Source/OpeningBookData.cpp). Needs BWAPI's static unit data, so it's run from the test project.
+			@return true if every book was generated and the file was written, false otherwise
+		*/
+		bool generateBookSource(const std::string & path, int maxMoves = DEFAULT_BOOK_MOVES, int depth = DEFAULT_BOOK_DEPTH);
+	}
+}
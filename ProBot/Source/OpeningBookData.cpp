@@ -0,0 +1,1135 @@
+/**
+	OpeningBookData.cpp
+	Compiled opening book tables. Generated by OpeningBook::generateBookSource (see OpeningBookGenerator in the tests); don't edit by hand.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "OpeningBook.h"
+
+using namespace ProBot;
+using namespace OpeningBook;
+
+// Protoss versus Protoss, searched to depth 10
+static const BookEntry BOOK_0[] = {
+	{ 0x0ULL, 0x0ULL, 0 },
+	{ 0x0ULL, 0x1ULL, 0 },
+	{ 0x0ULL, 0x20000000003ULL, 0 },
+	{ 0x0ULL, 0x22000000007ULL, 0 },
+	{ 0x0ULL, 0x2200000001fULL, 0 },
+	{ 0x0ULL, 0x26000000007ULL, 0 },
+	{ 0x0ULL, 0x28000000003ULL, 0 },
+	{ 0x0ULL, 0x2a000000007ULL, 0 },
+	{ 0x0ULL, 0x38000000003ULL, 0 },
+	{ 0x0ULL, 0x40000000001ULL, 0 },
+	{ 0x0ULL, 0x60000000003ULL, 0 },
+	{ 0x0ULL, 0x62000000007ULL, 0 },
+	{ 0x0ULL, 0x68000000003ULL, 0 },
+	{ 0x0ULL, 0x80000000001ULL, 0 },
+	{ 0x0ULL, 0xa0000000003ULL, 0 },
+	{ 0x0ULL, 0xa2000000007ULL, 0 },
+	{ 0x0ULL, 0xa8000000003ULL, 0 },
+	{ 0x0ULL, 0xc0000000001ULL, 0 },
+	{ 0x0ULL, 0xe0000000003ULL, 0 },
+	{ 0x1ULL, 0x0ULL, 1 },
+	{ 0x1ULL, 0x1ULL, 1 },
+	{ 0x1ULL, 0x20000000003ULL, 1 },
+	{ 0x1ULL, 0x22000000007ULL, 1 },
+	{ 0x1ULL, 0x2200000001fULL, 1 },
+	{ 0x1ULL, 0x26000000007ULL, 1 },
+	{ 0x1ULL, 0x28000000003ULL, 1 },
+	{ 0x1ULL, 0x2a000000007ULL, 1 },
+	{ 0x1ULL, 0x38000000003ULL, 1 },
+	{ 0x1ULL, 0x40000000001ULL, 1 },
+	{ 0x1ULL, 0x60000000003ULL, 1 },
+	{ 0x1ULL, 0x62000000007ULL, 1 },
+	{ 0x1ULL, 0x68000000003ULL, 1 },
+	{ 0x1ULL, 0x80000000001ULL, 1 },
+	{ 0x1ULL, 0xa0000000003ULL, 1 },
+	{ 0x1ULL, 0xa2000000007ULL, 1 },
+	{ 0x1ULL, 0xa8000000003ULL, 1 },
+	{ 0x1ULL, 0xc0000000001ULL, 1 },
+	{ 0x1ULL, 0xe0000000003ULL, 1 },
+	{ 0x20000000003ULL, 0x0ULL, 2 },
+	{ 0x20000000003ULL, 0x1ULL, 2 },
+	{ 0x20000000003ULL, 0x20000000003ULL, 2 },
+	{ 0x20000000003ULL, 0x22000000007ULL, 2 },
+	{ 0x20000000003ULL, 0x2200000001fULL, 2 },
+	{ 0x20000000003ULL, 0x26000000007ULL, 2 },
+	{ 0x20000000003ULL, 0x28000000003ULL, 2 },
+	{ 0x20000000003ULL, 0x2a000000007ULL, 2 },
+	{ 0x20000000003ULL, 0x38000000003ULL, 2 },
+	{ 0x20000000003ULL, 0x40000000001ULL, 2 },
+	{ 0x20000000003ULL, 0x60000000003ULL, 2 },
+	{ 0x20000000003ULL, 0x62000000007ULL, 2 },
+	{ 0x20000000003ULL, 0x68000000003ULL, 2 },
+	{ 0x20000000003ULL, 0x80000000001ULL, 2 },
+	{ 0x20000000003ULL, 0xa0000000003ULL, 2 },
+	{ 0x20000000003ULL, 0xa2000000007ULL, 2 },
+	{ 0x20000000003ULL, 0xa8000000003ULL, 2 },
+	{ 0x20000000003ULL, 0xc0000000001ULL, 2 },
+	{ 0x20000000003ULL, 0xe0000000003ULL, 2 },
+	{ 0x22000000007ULL, 0x0ULL, 3 },
+	{ 0x22000000007ULL, 0x1ULL, 3 },
+	{ 0x22000000007ULL, 0x20000000003ULL, 3 },
+	{ 0x22000000007ULL, 0x22000000007ULL, 3 },
+	{ 0x22000000007ULL, 0x2200000001fULL, 3 },
+	{ 0x22000000007ULL, 0x26000000007ULL, 3 },
+	{ 0x22000000007ULL, 0x28000000003ULL, 3 },
+	{ 0x22000000007ULL, 0x2a000000007ULL, 3 },
+	{ 0x22000000007ULL, 0x38000000003ULL, 3 },
+	{ 0x22000000007ULL, 0x40000000001ULL, 3 },
+	{ 0x22000000007ULL, 0x60000000003ULL, 3 },
+	{ 0x22000000007ULL, 0x62000000007ULL, 3 },
+	{ 0x22000000007ULL, 0x68000000003ULL, 3 },
+	{ 0x22000000007ULL, 0x80000000001ULL, 3 },
+	{ 0x22000000007ULL, 0xa0000000003ULL, 3 },
+	{ 0x22000000007ULL, 0xa2000000007ULL, 3 },
+	{ 0x22000000007ULL, 0xa8000000003ULL, 3 },
+	{ 0x22000000007ULL, 0xc0000000001ULL, 3 },
+	{ 0x22000000007ULL, 0xe0000000003ULL, 3 },
+	{ 0x2200000001fULL, 0x0ULL, 11 },
+	{ 0x2200000001fULL, 0x1ULL, 11 },
+	{ 0x2200000001fULL, 0x20000000003ULL, 11 },
+	{ 0x2200000001fULL, 0x22000000007ULL, 11 },
+	{ 0x2200000001fULL, 0x2200000001fULL, 11 },
+	{ 0x2200000001fULL, 0x26000000007ULL, 11 },
+	{ 0x2200000001fULL, 0x28000000003ULL, 11 },
+	{ 0x2200000001fULL, 0x2a000000007ULL, 11 },
+	{ 0x2200000001fULL, 0x38000000003ULL, 11 },
+	{ 0x2200000001fULL, 0x40000000001ULL, 11 },
+	{ 0x2200000001fULL, 0x60000000003ULL, 11 },
+	{ 0x2200000001fULL, 0x62000000007ULL, 11 },
+	{ 0x2200000001fULL, 0x68000000003ULL, 11 },
+	{ 0x2200000001fULL, 0x80000000001ULL, 11 },
+	{ 0x2200000001fULL, 0xa0000000003ULL, 11 },
+	{ 0x2200000001fULL, 0xa2000000007ULL, 11 },
+	{ 0x2200000001fULL, 0xa8000000003ULL, 11 },
+	{ 0x2200000001fULL, 0xc0000000001ULL, 11 },
+	{ 0x2200000001fULL, 0xe0000000003ULL, 11 },
+	{ 0x26000000007ULL, 0x0ULL, 3 },
+	{ 0x26000000007ULL, 0x1ULL, 3 },
+	{ 0x26000000007ULL, 0x20000000003ULL, 3 },
+	{ 0x26000000007ULL, 0x22000000007ULL, 3 },
+	{ 0x26000000007ULL, 0x2200000001fULL, 3 },
+	{ 0x26000000007ULL, 0x26000000007ULL, 3 },
+	{ 0x26000000007ULL, 0x28000000003ULL, 3 },
+	{ 0x26000000007ULL, 0x2a000000007ULL, 3 },
+	{ 0x26000000007ULL, 0x38000000003ULL, 3 },
+	{ 0x26000000007ULL, 0x40000000001ULL, 3 },
+	{ 0x26000000007ULL, 0x60000000003ULL, 3 },
+	{ 0x26000000007ULL, 0x62000000007ULL, 3 },
+	{ 0x26000000007ULL, 0x68000000003ULL, 3 },
+	{ 0x26000000007ULL, 0x80000000001ULL, 3 },
+	{ 0x26000000007ULL, 0xa0000000003ULL, 3 },
+	{ 0x26000000007ULL, 0xa2000000007ULL, 3 },
+	{ 0x26000000007ULL, 0xa8000000003ULL, 3 },
+	{ 0x26000000007ULL, 0xc0000000001ULL, 3 },
+	{ 0x26000000007ULL, 0xe0000000003ULL, 3 },
+	{ 0x28000000003ULL, 0x0ULL, 2 },
+	{ 0x28000000003ULL, 0x1ULL, 2 },
+	{ 0x28000000003ULL, 0x20000000003ULL, 2 },
+	{ 0x28000000003ULL, 0x22000000007ULL, 2 },
+	{ 0x28000000003ULL, 0x2200000001fULL, 2 },
+	{ 0x28000000003ULL, 0x26000000007ULL, 2 },
+	{ 0x28000000003ULL, 0x28000000003ULL, 2 },
+	{ 0x28000000003ULL, 0x2a000000007ULL, 2 },
+	{ 0x28000000003ULL, 0x38000000003ULL, 2 },
+	{ 0x28000000003ULL, 0x40000000001ULL, 2 },
+	{ 0x28000000003ULL, 0x60000000003ULL, 2 },
+	{ 0x28000000003ULL, 0x62000000007ULL, 2 },
+	{ 0x28000000003ULL, 0x68000000003ULL, 2 },
+	{ 0x28000000003ULL, 0x80000000001ULL, 2 },
+	{ 0x28000000003ULL, 0xa0000000003ULL, 2 },
+	{ 0x28000000003ULL, 0xa2000000007ULL, 2 },
+	{ 0x28000000003ULL, 0xa8000000003ULL, 2 },
+	{ 0x28000000003ULL, 0xc0000000001ULL, 2 },
+	{ 0x28000000003ULL, 0xe0000000003ULL, 2 },
+	{ 0x2a000000007ULL, 0x0ULL, 3 },
+	{ 0x2a000000007ULL, 0x1ULL, 3 },
+	{ 0x2a000000007ULL, 0x20000000003ULL, 3 },
+	{ 0x2a000000007ULL, 0x22000000007ULL, 3 },
+	{ 0x2a000000007ULL, 0x2200000001fULL, 3 },
+	{ 0x2a000000007ULL, 0x26000000007ULL, 3 },
+	{ 0x2a000000007ULL, 0x28000000003ULL, 3 },
+	{ 0x2a000000007ULL, 0x2a000000007ULL, 3 },
+	{ 0x2a000000007ULL, 0x38000000003ULL, 3 },
+	{ 0x2a000000007ULL, 0x40000000001ULL, 3 },
+	{ 0x2a000000007ULL, 0x60000000003ULL, 3 },
+	{ 0x2a000000007ULL, 0x62000000007ULL, 3 },
+	{ 0x2a000000007ULL, 0x68000000003ULL, 3 },
+	{ 0x2a000000007ULL, 0x80000000001ULL, 3 },
+	{ 0x2a000000007ULL, 0xa0000000003ULL, 3 },
+	{ 0x2a000000007ULL, 0xa2000000007ULL, 3 },
+	{ 0x2a000000007ULL, 0xa8000000003ULL, 3 },
+	{ 0x2a000000007ULL, 0xc0000000001ULL, 3 },
+	{ 0x2a000000007ULL, 0xe0000000003ULL, 3 },
+	{ 0x38000000003ULL, 0x0ULL, 2 },
+	{ 0x38000000003ULL, 0x1ULL, 2 },
+	{ 0x38000000003ULL, 0x20000000003ULL, 2 },
+	{ 0x38000000003ULL, 0x22000000007ULL, 2 },
+	{ 0x38000000003ULL, 0x2200000001fULL, 2 },
+	{ 0x38000000003ULL, 0x26000000007ULL, 2 },
+	{ 0x38000000003ULL, 0x28000000003ULL, 2 },
+	{ 0x38000000003ULL, 0x2a000000007ULL, 2 },
+	{ 0x38000000003ULL, 0x38000000003ULL, 2 },
+	{ 0x38000000003ULL, 0x40000000001ULL, 2 },
+	{ 0x38000000003ULL, 0x60000000003ULL, 2 },
+	{ 0x38000000003ULL, 0x62000000007ULL, 2 },
+	{ 0x38000000003ULL, 0x68000000003ULL, 2 },
+	{ 0x38000000003ULL, 0x80000000001ULL, 2 },
+	{ 0x38000000003ULL, 0xa0000000003ULL, 2 },
+	{ 0x38000000003ULL, 0xa2000000007ULL, 2 },
+	{ 0x38000000003ULL, 0xa8000000003ULL, 2 },
+	{ 0x38000000003ULL, 0xc0000000001ULL, 2 },
+	{ 0x38000000003ULL, 0xe0000000003ULL, 2 },
+	{ 0x40000000001ULL, 0x0ULL, 1 },
+	{ 0x40000000001ULL, 0x1ULL, 1 },
+	{ 0x40000000001ULL, 0x20000000003ULL, 1 },
+	{ 0x40000000001ULL, 0x22000000007ULL, 1 },
+	{ 0x40000000001ULL, 0x2200000001fULL, 1 },
+	{ 0x40000000001ULL, 0x26000000007ULL, 1 },
+	{ 0x40000000001ULL, 0x28000000003ULL, 1 },
+	{ 0x40000000001ULL, 0x2a000000007ULL, 1 },
+	{ 0x40000000001ULL, 0x38000000003ULL, 1 },
+	{ 0x40000000001ULL, 0x40000000001ULL, 1 },
+	{ 0x40000000001ULL, 0x60000000003ULL, 1 },
+	{ 0x40000000001ULL, 0x62000000007ULL, 1 },
+	{ 0x40000000001ULL, 0x68000000003ULL, 1 },
+	{ 0x40000000001ULL, 0x80000000001ULL, 1 },
+	{ 0x40000000001ULL, 0xa0000000003ULL, 1 },
+	{ 0x40000000001ULL, 0xa2000000007ULL, 1 },
+	{ 0x40000000001ULL, 0xa8000000003ULL, 1 },
+	{ 0x40000000001ULL, 0xc0000000001ULL, 1 },
+	{ 0x40000000001ULL, 0xe0000000003ULL, 1 },
+	{ 0x60000000003ULL, 0x0ULL, 2 },
+	{ 0x60000000003ULL, 0x1ULL, 2 },
+	{ 0x60000000003ULL, 0x20000000003ULL, 2 },
+	{ 0x60000000003ULL, 0x22000000007ULL, 2 },
+	{ 0x60000000003ULL, 0x2200000001fULL, 2 },
+	{ 0x60000000003ULL, 0x26000000007ULL, 2 },
+	{ 0x60000000003ULL, 0x28000000003ULL, 2 },
+	{ 0x60000000003ULL, 0x2a000000007ULL, 2 },
+	{ 0x60000000003ULL, 0x38000000003ULL, 2 },
+	{ 0x60000000003ULL, 0x40000000001ULL, 2 },
+	{ 0x60000000003ULL, 0x60000000003ULL, 2 },
+	{ 0x60000000003ULL, 0x62000000007ULL, 2 },
+	{ 0x60000000003ULL, 0x68000000003ULL, 2 },
+	{ 0x60000000003ULL, 0x80000000001ULL, 2 },
+	{ 0x60000000003ULL, 0xa0000000003ULL, 2 },
+	{ 0x60000000003ULL, 0xa2000000007ULL, 2 },
+	{ 0x60000000003ULL, 0xa8000000003ULL, 2 },
+	{ 0x60000000003ULL, 0xc0000000001ULL, 2 },
+	{ 0x60000000003ULL, 0xe0000000003ULL, 2 },
+	{ 0x62000000007ULL, 0x0ULL, 3 },
+	{ 0x62000000007ULL, 0x1ULL, 3 },
+	{ 0x62000000007ULL, 0x20000000003ULL, 3 },
+	{ 0x62000000007ULL, 0x22000000007ULL, 3 },
+	{ 0x62000000007ULL, 0x2200000001fULL, 3 },
+	{ 0x62000000007ULL, 0x26000000007ULL, 3 },
+	{ 0x62000000007ULL, 0x28000000003ULL, 3 },
+	{ 0x62000000007ULL, 0x2a000000007ULL, 3 },
+	{ 0x62000000007ULL, 0x38000000003ULL, 3 },
+	{ 0x62000000007ULL, 0x40000000001ULL, 3 },
+	{ 0x62000000007ULL, 0x60000000003ULL, 3 },
+	{ 0x62000000007ULL, 0x62000000007ULL, 3 },
+	{ 0x62000000007ULL, 0x68000000003ULL, 3 },
+	{ 0x62000000007ULL, 0x80000000001ULL, 3 },
+	{ 0x62000000007ULL, 0xa0000000003ULL, 3 },
+	{ 0x62000000007ULL, 0xa2000000007ULL, 3 },
+	{ 0x62000000007ULL, 0xa8000000003ULL, 3 },
+	{ 0x62000000007ULL, 0xc0000000001ULL, 3 },
+	{ 0x62000000007ULL, 0xe0000000003ULL, 3 },
+	{ 0x68000000003ULL, 0x0ULL, 2 },
+	{ 0x68000000003ULL, 0x1ULL, 2 },
+	{ 0x68000000003ULL, 0x20000000003ULL, 2 },
+	{ 0x68000000003ULL, 0x22000000007ULL, 2 },
+	{ 0x68000000003ULL, 0x2200000001fULL, 2 },
+	{ 0x68000000003ULL, 0x26000000007ULL, 2 },
+	{ 0x68000000003ULL, 0x28000000003ULL, 2 },
+	{ 0x68000000003ULL, 0x2a000000007ULL, 2 },
+	{ 0x68000000003ULL, 0x38000000003ULL, 2 },
+	{ 0x68000000003ULL, 0x40000000001ULL, 2 },
+	{ 0x68000000003ULL, 0x60000000003ULL, 2 },
+	{ 0x68000000003ULL, 0x62000000007ULL, 2 },
+	{ 0x68000000003ULL, 0x68000000003ULL, 2 },
+	{ 0x68000000003ULL, 0x80000000001ULL, 2 },
+	{ 0x68000000003ULL, 0xa0000000003ULL, 2 },
+	{ 0x68000000003ULL, 0xa2000000007ULL, 2 },
+	{ 0x68000000003ULL, 0xa8000000003ULL, 2 },
+	{ 0x68000000003ULL, 0xc0000000001ULL, 2 },
+	{ 0x68000000003ULL, 0xe0000000003ULL, 2 },
+	{ 0x80000000001ULL, 0x0ULL, 1 },
+	{ 0x80000000001ULL, 0x1ULL, 1 },
+	{ 0x80000000001ULL, 0x20000000003ULL, 1 },
+	{ 0x80000000001ULL, 0x22000000007ULL, 1 },
+	{ 0x80000000001ULL, 0x2200000001fULL, 1 },
+	{ 0x80000000001ULL, 0x26000000007ULL, 1 },
+	{ 0x80000000001ULL, 0x28000000003ULL, 1 },
+	{ 0x80000000001ULL, 0x2a000000007ULL, 1 },
+	{ 0x80000000001ULL, 0x38000000003ULL, 1 },
+	{ 0x80000000001ULL, 0x40000000001ULL, 1 },
+	{ 0x80000000001ULL, 0x60000000003ULL, 1 },
+	{ 0x80000000001ULL, 0x62000000007ULL, 1 },
+	{ 0x80000000001ULL, 0x68000000003ULL, 1 },
+	{ 0x80000000001ULL, 0x80000000001ULL, 1 },
+	{ 0x80000000001ULL, 0xa0000000003ULL, 1 },
+	{ 0x80000000001ULL, 0xa2000000007ULL, 1 },
+	{ 0x80000000001ULL, 0xa8000000003ULL, 1 },
+	{ 0x80000000001ULL, 0xc0000000001ULL, 1 },
+	{ 0x80000000001ULL, 0xe0000000003ULL, 1 },
+	{ 0xa0000000003ULL, 0x0ULL, 2 },
+	{ 0xa0000000003ULL, 0x1ULL, 2 },
+	{ 0xa0000000003ULL, 0x20000000003ULL, 2 },
+	{ 0xa0000000003ULL, 0x22000000007ULL, 2 },
+	{ 0xa0000000003ULL, 0x2200000001fULL, 2 },
+	{ 0xa0000000003ULL, 0x26000000007ULL, 2 },
+	{ 0xa0000000003ULL, 0x28000000003ULL, 2 },
+	{ 0xa0000000003ULL, 0x2a000000007ULL, 2 },
+	{ 0xa0000000003ULL, 0x38000000003ULL, 2 },
+	{ 0xa0000000003ULL, 0x40000000001ULL, 2 },
+	{ 0xa0000000003ULL, 0x60000000003ULL, 2 },
+	{ 0xa0000000003ULL, 0x62000000007ULL, 2 },
+	{ 0xa0000000003ULL, 0x68000000003ULL, 2 },
+	{ 0xa0000000003ULL, 0x80000000001ULL, 2 },
+	{ 0xa0000000003ULL, 0xa0000000003ULL, 2 },
+	{ 0xa0000000003ULL, 0xa2000000007ULL, 2 },
+	{ 0xa0000000003ULL, 0xa8000000003ULL, 2 },
+	{ 0xa0000000003ULL, 0xc0000000001ULL, 2 },
+	{ 0xa0000000003ULL, 0xe0000000003ULL, 2 },
+	{ 0xa2000000007ULL, 0x0ULL, 3 },
+	{ 0xa2000000007ULL, 0x1ULL, 3 },
+	{ 0xa2000000007ULL, 0x20000000003ULL, 3 },
+	{ 0xa2000000007ULL, 0x22000000007ULL, 3 },
+	{ 0xa2000000007ULL, 0x2200000001fULL, 3 },
+	{ 0xa2000000007ULL, 0x26000000007ULL, 3 },
+	{ 0xa2000000007ULL, 0x28000000003ULL, 3 },
+	{ 0xa2000000007ULL, 0x2a000000007ULL, 3 },
+	{ 0xa2000000007ULL, 0x38000000003ULL, 3 },
+	{ 0xa2000000007ULL, 0x40000000001ULL, 3 },
+	{ 0xa2000000007ULL, 0x60000000003ULL, 3 },
+	{ 0xa2000000007ULL, 0x62000000007ULL, 3 },
+	{ 0xa2000000007ULL, 0x68000000003ULL, 3 },
+	{ 0xa2000000007ULL, 0x80000000001ULL, 3 },
+	{ 0xa2000000007ULL, 0xa0000000003ULL, 3 },
+	{ 0xa2000000007ULL, 0xa2000000007ULL, 3 },
+	{ 0xa2000000007ULL, 0xa8000000003ULL, 3 },
+	{ 0xa2000000007ULL, 0xc0000000001ULL, 3 },
+	{ 0xa2000000007ULL, 0xe0000000003ULL, 3 },
+	{ 0xa8000000003ULL, 0x0ULL, 2 },
+	{ 0xa8000000003ULL, 0x1ULL, 2 },
+	{ 0xa8000000003ULL, 0x20000000003ULL, 2 },
+	{ 0xa8000000003ULL, 0x22000000007ULL, 2 },
+	{ 0xa8000000003ULL, 0x2200000001fULL, 2 },
+	{ 0xa8000000003ULL, 0x26000000007ULL, 2 },
+	{ 0xa8000000003ULL, 0x28000000003ULL, 2 },
+	{ 0xa8000000003ULL, 0x2a000000007ULL, 2 },
+	{ 0xa8000000003ULL, 0x38000000003ULL, 2 },
+	{ 0xa8000000003ULL, 0x40000000001ULL, 2 },
+	{ 0xa8000000003ULL, 0x60000000003ULL, 2 },
+	{ 0xa8000000003ULL, 0x62000000007ULL, 2 },
+	{ 0xa8000000003ULL, 0x68000000003ULL, 2 },
+	{ 0xa8000000003ULL, 0x80000000001ULL, 2 },
+	{ 0xa8000000003ULL, 0xa0000000003ULL, 2 },
+	{ 0xa8000000003ULL, 0xa2000000007ULL, 2 },
+	{ 0xa8000000003ULL, 0xa8000000003ULL, 2 },
+	{ 0xa8000000003ULL, 0xc0000000001ULL, 2 },
+	{ 0xa8000000003ULL, 0xe0000000003ULL, 2 },
+	{ 0xc0000000001ULL, 0x0ULL, 1 },
+	{ 0xc0000000001ULL, 0x1ULL, 1 },
+	{ 0xc0000000001ULL, 0x20000000003ULL, 1 },
+	{ 0xc0000000001ULL, 0x22000000007ULL, 1 },
+	{ 0xc0000000001ULL, 0x2200000001fULL, 1 },
+	{ 0xc0000000001ULL, 0x26000000007ULL, 1 },
+	{ 0xc0000000001ULL, 0x28000000003ULL, 1 },
+	{ 0xc0000000001ULL, 0x2a000000007ULL, 1 },
+	{ 0xc0000000001ULL, 0x38000000003ULL, 1 },
+	{ 0xc0000000001ULL, 0x40000000001ULL, 1 },
+	{ 0xc0000000001ULL, 0x60000000003ULL, 1 },
+	{ 0xc0000000001ULL, 0x62000000007ULL, 1 },
+	{ 0xc0000000001ULL, 0x68000000003ULL, 1 },
+	{ 0xc0000000001ULL, 0x80000000001ULL, 1 },
+	{ 0xc0000000001ULL, 0xa0000000003ULL, 1 },
+	{ 0xc0000000001ULL, 0xa2000000007ULL, 1 },
+	{ 0xc0000000001ULL, 0xa8000000003ULL, 1 },
+	{ 0xc0000000001ULL, 0xc0000000001ULL, 1 },
+	{ 0xc0000000001ULL, 0xe0000000003ULL, 1 },
+	{ 0xe0000000003ULL, 0x0ULL, 2 },
+	{ 0xe0000000003ULL, 0x1ULL, 2 },
+	{ 0xe0000000003ULL, 0x20000000003ULL, 2 },
+	{ 0xe0000000003ULL, 0x22000000007ULL, 2 },
+	{ 0xe0000000003ULL, 0x2200000001fULL, 2 },
+	{ 0xe0000000003ULL, 0x26000000007ULL, 2 },
+	{ 0xe0000000003ULL, 0x28000000003ULL, 2 },
+	{ 0xe0000000003ULL, 0x2a000000007ULL, 2 },
+	{ 0xe0000000003ULL, 0x38000000003ULL, 2 },
+	{ 0xe0000000003ULL, 0x40000000001ULL, 2 },
+	{ 0xe0000000003ULL, 0x60000000003ULL, 2 },
+	{ 0xe0000000003ULL, 0x62000000007ULL, 2 },
+	{ 0xe0000000003ULL, 0x68000000003ULL, 2 },
+	{ 0xe0000000003ULL, 0x80000000001ULL, 2 },
+	{ 0xe0000000003ULL, 0xa0000000003ULL, 2 },
+	{ 0xe0000000003ULL, 0xa2000000007ULL, 2 },
+	{ 0xe0000000003ULL, 0xa8000000003ULL, 2 },
+	{ 0xe0000000003ULL, 0xc0000000001ULL, 2 },
+	{ 0xe0000000003ULL, 0xe0000000003ULL, 2 },
+};
+
+// Protoss versus Terran, searched to depth 10
+static const BookEntry BOOK_1[] = {
+	{ 0x0ULL, 0x0ULL, 0 },
+	{ 0x0ULL, 0x1ULL, 0 },
+	{ 0x0ULL, 0x80000003ULL, 0 },
+	{ 0x0ULL, 0x90000007ULL, 0 },
+	{ 0x0ULL, 0x9040000fULL, 0 },
+	{ 0x0ULL, 0x90800007ULL, 0 },
+	{ 0x0ULL, 0x97000007ULL, 0 },
+	{ 0x0ULL, 0xa0000003ULL, 0 },
+	{ 0x0ULL, 0xb0000007ULL, 0 },
+	{ 0x0ULL, 0xe0000003ULL, 0 },
+	{ 0x0ULL, 0x100000001ULL, 0 },
+	{ 0x0ULL, 0x180000003ULL, 0 },
+	{ 0x0ULL, 0x190000007ULL, 0 },
+	{ 0x0ULL, 0x1a0000003ULL, 0 },
+	{ 0x0ULL, 0x200000001ULL, 0 },
+	{ 0x0ULL, 0x280000003ULL, 0 },
+	{ 0x0ULL, 0x290000007ULL, 0 },
+	{ 0x0ULL, 0x2a0000003ULL, 0 },
+	{ 0x0ULL, 0x300000001ULL, 0 },
+	{ 0x0ULL, 0x380000003ULL, 0 },
+	{ 0x1ULL, 0x0ULL, 1 },
+	{ 0x1ULL, 0x1ULL, 1 },
+	{ 0x1ULL, 0x80000003ULL, 1 },
+	{ 0x1ULL, 0x90000007ULL, 1 },
+	{ 0x1ULL, 0x9040000fULL, 1 },
+	{ 0x1ULL, 0x90800007ULL, 1 },
+	{ 0x1ULL, 0x97000007ULL, 1 },
+	{ 0x1ULL, 0xa0000003ULL, 1 },
+	{ 0x1ULL, 0xb0000007ULL, 1 },
+	{ 0x1ULL, 0xe0000003ULL, 1 },
+	{ 0x1ULL, 0x100000001ULL, 1 },
+	{ 0x1ULL, 0x180000003ULL, 1 },
+	{ 0x1ULL, 0x190000007ULL, 1 },
+	{ 0x1ULL, 0x1a0000003ULL, 1 },
+	{ 0x1ULL, 0x200000001ULL, 1 },
+	{ 0x1ULL, 0x280000003ULL, 1 },
+	{ 0x1ULL, 0x290000007ULL, 1 },
+	{ 0x1ULL, 0x2a0000003ULL, 1 },
+	{ 0x1ULL, 0x300000001ULL, 1 },
+	{ 0x1ULL, 0x380000003ULL, 1 },
+	{ 0x20000000003ULL, 0x0ULL, 2 },
+	{ 0x20000000003ULL, 0x1ULL, 2 },
+	{ 0x20000000003ULL, 0x80000003ULL, 2 },
+	{ 0x20000000003ULL, 0x90000007ULL, 2 },
+	{ 0x20000000003ULL, 0x9040000fULL, 2 },
+	{ 0x20000000003ULL, 0x90800007ULL, 2 },
+	{ 0x20000000003ULL, 0x97000007ULL, 2 },
+	{ 0x20000000003ULL, 0xa0000003ULL, 2 },
+	{ 0x20000000003ULL, 0xb0000007ULL, 2 },
+	{ 0x20000000003ULL, 0xe0000003ULL, 2 },
+	{ 0x20000000003ULL, 0x100000001ULL, 2 },
+	{ 0x20000000003ULL, 0x180000003ULL, 2 },
+	{ 0x20000000003ULL, 0x190000007ULL, 2 },
+	{ 0x20000000003ULL, 0x1a0000003ULL, 2 },
+	{ 0x20000000003ULL, 0x200000001ULL, 2 },
+	{ 0x20000000003ULL, 0x280000003ULL, 2 },
+	{ 0x20000000003ULL, 0x290000007ULL, 2 },
+	{ 0x20000000003ULL, 0x2a0000003ULL, 2 },
+	{ 0x20000000003ULL, 0x300000001ULL, 2 },
+	{ 0x20000000003ULL, 0x380000003ULL, 2 },
+	{ 0x22000000007ULL, 0x0ULL, 3 },
+	{ 0x22000000007ULL, 0x1ULL, 3 },
+	{ 0x22000000007ULL, 0x80000003ULL, 3 },
+	{ 0x22000000007ULL, 0x90000007ULL, 3 },
+	{ 0x22000000007ULL, 0x9040000fULL, 3 },
+	{ 0x22000000007ULL, 0x90800007ULL, 3 },
+	{ 0x22000000007ULL, 0x97000007ULL, 3 },
+	{ 0x22000000007ULL, 0xa0000003ULL, 3 },
+	{ 0x22000000007ULL, 0xb0000007ULL, 3 },
+	{ 0x22000000007ULL, 0xe0000003ULL, 3 },
+	{ 0x22000000007ULL, 0x100000001ULL, 3 },
+	{ 0x22000000007ULL, 0x180000003ULL, 3 },
+	{ 0x22000000007ULL, 0x190000007ULL, 3 },
+	{ 0x22000000007ULL, 0x1a0000003ULL, 3 },
+	{ 0x22000000007ULL, 0x200000001ULL, 3 },
+	{ 0x22000000007ULL, 0x280000003ULL, 3 },
+	{ 0x22000000007ULL, 0x290000007ULL, 3 },
+	{ 0x22000000007ULL, 0x2a0000003ULL, 3 },
+	{ 0x22000000007ULL, 0x300000001ULL, 3 },
+	{ 0x22000000007ULL, 0x380000003ULL, 3 },
+	{ 0x2200000001fULL, 0x0ULL, 11 },
+	{ 0x2200000001fULL, 0x1ULL, 11 },
+	{ 0x2200000001fULL, 0x80000003ULL, 11 },
+	{ 0x2200000001fULL, 0x90000007ULL, 11 },
+	{ 0x2200000001fULL, 0x9040000fULL, 11 },
+	{ 0x2200000001fULL, 0x90800007ULL, 11 },
+	{ 0x2200000001fULL, 0x97000007ULL, 11 },
+	{ 0x2200000001fULL, 0xa0000003ULL, 11 },
+	{ 0x2200000001fULL, 0xb0000007ULL, 11 },
+	{ 0x2200000001fULL, 0xe0000003ULL, 11 },
+	{ 0x2200000001fULL, 0x100000001ULL, 11 },
+	{ 0x2200000001fULL, 0x180000003ULL, 11 },
+	{ 0x2200000001fULL, 0x190000007ULL, 11 },
+	{ 0x2200000001fULL, 0x1a0000003ULL, 11 },
+	{ 0x2200000001fULL, 0x200000001ULL, 11 },
+	{ 0x2200000001fULL, 0x280000003ULL, 11 },
+	{ 0x2200000001fULL, 0x290000007ULL, 11 },
+	{ 0x2200000001fULL, 0x2a0000003ULL, 11 },
+	{ 0x2200000001fULL, 0x300000001ULL, 11 },
+	{ 0x2200000001fULL, 0x380000003ULL, 11 },
+	{ 0x26000000007ULL, 0x0ULL, 3 },
+	{ 0x26000000007ULL, 0x1ULL, 3 },
+	{ 0x26000000007ULL, 0x80000003ULL, 3 },
+	{ 0x26000000007ULL, 0x90000007ULL, 3 },
+	{ 0x26000000007ULL, 0x9040000fULL, 3 },
+	{ 0x26000000007ULL, 0x90800007ULL, 3 },
+	{ 0x26000000007ULL, 0x97000007ULL, 3 },
+	{ 0x26000000007ULL, 0xa0000003ULL, 3 },
+	{ 0x26000000007ULL, 0xb0000007ULL, 3 },
+	{ 0x26000000007ULL, 0xe0000003ULL, 3 },
+	{ 0x26000000007ULL, 0x100000001ULL, 3 },
+	{ 0x26000000007ULL, 0x180000003ULL, 3 },
+	{ 0x26000000007ULL, 0x190000007ULL, 3 },
+	{ 0x26000000007ULL, 0x1a0000003ULL, 3 },
+	{ 0x26000000007ULL, 0x200000001ULL, 3 },
+	{ 0x26000000007ULL, 0x280000003ULL, 3 },
+	{ 0x26000000007ULL, 0x290000007ULL, 3 },
+	{ 0x26000000007ULL, 0x2a0000003ULL, 3 },
+	{ 0x26000000007ULL, 0x300000001ULL, 3 },
+	{ 0x26000000007ULL, 0x380000003ULL, 3 },
+	{ 0x28000000003ULL, 0x0ULL, 2 },
+	{ 0x28000000003ULL, 0x1ULL, 2 },
+	{ 0x28000000003ULL, 0x80000003ULL, 2 },
+	{ 0x28000000003ULL, 0x90000007ULL, 2 },
+	{ 0x28000000003ULL, 0x9040000fULL, 2 },
+	{ 0x28000000003ULL, 0x90800007ULL, 2 },
+	{ 0x28000000003ULL, 0x97000007ULL, 2 },
+	{ 0x28000000003ULL, 0xa0000003ULL, 2 },
+	{ 0x28000000003ULL, 0xb0000007ULL, 2 },
+	{ 0x28000000003ULL, 0xe0000003ULL, 2 },
+	{ 0x28000000003ULL, 0x100000001ULL, 2 },
+	{ 0x28000000003ULL, 0x180000003ULL, 2 },
+	{ 0x28000000003ULL, 0x190000007ULL, 2 },
+	{ 0x28000000003ULL, 0x1a0000003ULL, 2 },
+	{ 0x28000000003ULL, 0x200000001ULL, 2 },
+	{ 0x28000000003ULL, 0x280000003ULL, 2 },
+	{ 0x28000000003ULL, 0x290000007ULL, 2 },
+	{ 0x28000000003ULL, 0x2a0000003ULL, 2 },
+	{ 0x28000000003ULL, 0x300000001ULL, 2 },
+	{ 0x28000000003ULL, 0x380000003ULL, 2 },
+	{ 0x2a000000007ULL, 0x0ULL, 3 },
+	{ 0x2a000000007ULL, 0x1ULL, 3 },
+	{ 0x2a000000007ULL, 0x80000003ULL, 3 },
+	{ 0x2a000000007ULL, 0x90000007ULL, 3 },
+	{ 0x2a000000007ULL, 0x9040000fULL, 3 },
+	{ 0x2a000000007ULL, 0x90800007ULL, 3 },
+	{ 0x2a000000007ULL, 0x97000007ULL, 3 },
+	{ 0x2a000000007ULL, 0xa0000003ULL, 3 },
+	{ 0x2a000000007ULL, 0xb0000007ULL, 3 },
+	{ 0x2a000000007ULL, 0xe0000003ULL, 3 },
+	{ 0x2a000000007ULL, 0x100000001ULL, 3 },
+	{ 0x2a000000007ULL, 0x180000003ULL, 3 },
+	{ 0x2a000000007ULL, 0x190000007ULL, 3 },
+	{ 0x2a000000007ULL, 0x1a0000003ULL, 3 },
+	{ 0x2a000000007ULL, 0x200000001ULL, 3 },
+	{ 0x2a000000007ULL, 0x280000003ULL, 3 },
+	{ 0x2a000000007ULL, 0x290000007ULL, 3 },
+	{ 0x2a000000007ULL, 0x2a0000003ULL, 3 },
+	{ 0x2a000000007ULL, 0x300000001ULL, 3 },
+	{ 0x2a000000007ULL, 0x380000003ULL, 3 },
+	{ 0x38000000003ULL, 0x0ULL, 2 },
+	{ 0x38000000003ULL, 0x1ULL, 2 },
+	{ 0x38000000003ULL, 0x80000003ULL, 2 },
+	{ 0x38000000003ULL, 0x90000007ULL, 2 },
+	{ 0x38000000003ULL, 0x9040000fULL, 2 },
+	{ 0x38000000003ULL, 0x90800007ULL, 2 },
+	{ 0x38000000003ULL, 0x97000007ULL, 2 },
+	{ 0x38000000003ULL, 0xa0000003ULL, 2 },
+	{ 0x38000000003ULL, 0xb0000007ULL, 2 },
+	{ 0x38000000003ULL, 0xe0000003ULL, 2 },
+	{ 0x38000000003ULL, 0x100000001ULL, 2 },
+	{ 0x38000000003ULL, 0x180000003ULL, 2 },
+	{ 0x38000000003ULL, 0x190000007ULL, 2 },
+	{ 0x38000000003ULL, 0x1a0000003ULL, 2 },
+	{ 0x38000000003ULL, 0x200000001ULL, 2 },
+	{ 0x38000000003ULL, 0x280000003ULL, 2 },
+	{ 0x38000000003ULL, 0x290000007ULL, 2 },
+	{ 0x38000000003ULL, 0x2a0000003ULL, 2 },
+	{ 0x38000000003ULL, 0x300000001ULL, 2 },
+	{ 0x38000000003ULL, 0x380000003ULL, 2 },
+	{ 0x40000000001ULL, 0x0ULL, 1 },
+	{ 0x40000000001ULL, 0x1ULL, 1 },
+	{ 0x40000000001ULL, 0x80000003ULL, 1 },
+	{ 0x40000000001ULL, 0x90000007ULL, 1 },
+	{ 0x40000000001ULL, 0x9040000fULL, 1 },
+	{ 0x40000000001ULL, 0x90800007ULL, 1 },
+	{ 0x40000000001ULL, 0x97000007ULL, 1 },
+	{ 0x40000000001ULL, 0xa0000003ULL, 1 },
+	{ 0x40000000001ULL, 0xb0000007ULL, 1 },
+	{ 0x40000000001ULL, 0xe0000003ULL, 1 },
+	{ 0x40000000001ULL, 0x100000001ULL, 1 },
+	{ 0x40000000001ULL, 0x180000003ULL, 1 },
+	{ 0x40000000001ULL, 0x190000007ULL, 1 },
+	{ 0x40000000001ULL, 0x1a0000003ULL, 1 },
+	{ 0x40000000001ULL, 0x200000001ULL, 1 },
+	{ 0x40000000001ULL, 0x280000003ULL, 1 },
+	{ 0x40000000001ULL, 0x290000007ULL, 1 },
+	{ 0x40000000001ULL, 0x2a0000003ULL, 1 },
+	{ 0x40000000001ULL, 0x300000001ULL, 1 },
+	{ 0x40000000001ULL, 0x380000003ULL, 1 },
+	{ 0x60000000003ULL, 0x0ULL, 2 },
+	{ 0x60000000003ULL, 0x1ULL, 2 },
+	{ 0x60000000003ULL, 0x80000003ULL, 2 },
+	{ 0x60000000003ULL, 0x90000007ULL, 2 },
+	{ 0x60000000003ULL, 0x9040000fULL, 2 },
+	{ 0x60000000003ULL, 0x90800007ULL, 2 },
+	{ 0x60000000003ULL, 0x97000007ULL, 2 },
+	{ 0x60000000003ULL, 0xa0000003ULL, 2 },
+	{ 0x60000000003ULL, 0xb0000007ULL, 2 },
+	{ 0x60000000003ULL, 0xe0000003ULL, 2 },
+	{ 0x60000000003ULL, 0x100000001ULL, 2 },
+	{ 0x60000000003ULL, 0x180000003ULL, 2 },
+	{ 0x60000000003ULL, 0x190000007ULL, 2 },
+	{ 0x60000000003ULL, 0x1a0000003ULL, 2 },
+	{ 0x60000000003ULL, 0x200000001ULL, 2 },
+	{ 0x60000000003ULL, 0x280000003ULL, 2 },
+	{ 0x60000000003ULL, 0x290000007ULL, 2 },
+	{ 0x60000000003ULL, 0x2a0000003ULL, 2 },
+	{ 0x60000000003ULL, 0x300000001ULL, 2 },
+	{ 0x60000000003ULL, 0x380000003ULL, 2 },
+	{ 0x62000000007ULL, 0x0ULL, 3 },
+	{ 0x62000000007ULL, 0x1ULL, 3 },
+	{ 0x62000000007ULL, 0x80000003ULL, 3 },
+	{ 0x62000000007ULL, 0x90000007ULL, 3 },
+	{ 0x62000000007ULL, 0x9040000fULL, 3 },
+	{ 0x62000000007ULL, 0x90800007ULL, 3 },
+	{ 0x62000000007ULL, 0x97000007ULL, 3 },
+	{ 0x62000000007ULL, 0xa0000003ULL, 3 },
+	{ 0x62000000007ULL, 0xb0000007ULL, 3 },
+	{ 0x62000000007ULL, 0xe0000003ULL, 3 },
+	{ 0x62000000007ULL, 0x100000001ULL, 3 },
+	{ 0x62000000007ULL, 0x180000003ULL, 3 },
+	{ 0x62000000007ULL, 0x190000007ULL, 3 },
+	{ 0x62000000007ULL, 0x1a0000003ULL, 3 },
+	{ 0x62000000007ULL, 0x200000001ULL, 3 },
+	{ 0x62000000007ULL, 0x280000003ULL, 3 },
+	{ 0x62000000007ULL, 0x290000007ULL, 3 },
+	{ 0x62000000007ULL, 0x2a0000003ULL, 3 },
+	{ 0x62000000007ULL, 0x300000001ULL, 3 },
+	{ 0x62000000007ULL, 0x380000003ULL, 3 },
+	{ 0x68000000003ULL, 0x0ULL, 2 },
+	{ 0x68000000003ULL, 0x1ULL, 2 },
+	{ 0x68000000003ULL, 0x80000003ULL, 2 },
+	{ 0x68000000003ULL, 0x90000007ULL, 2 },
+	{ 0x68000000003ULL, 0x9040000fULL, 2 },
+	{ 0x68000000003ULL, 0x90800007ULL, 2 },
+	{ 0x68000000003ULL, 0x97000007ULL, 2 },
+	{ 0x68000000003ULL, 0xa0000003ULL, 2 },
+	{ 0x68000000003ULL, 0xb0000007ULL, 2 },
+	{ 0x68000000003ULL, 0xe0000003ULL, 2 },
+	{ 0x68000000003ULL, 0x100000001ULL, 2 },
+	{ 0x68000000003ULL, 0x180000003ULL, 2 },
+	{ 0x68000000003ULL, 0x190000007ULL, 2 },
+	{ 0x68000000003ULL, 0x1a0000003ULL, 2 },
+	{ 0x68000000003ULL, 0x200000001ULL, 2 },
+	{ 0x68000000003ULL, 0x280000003ULL, 2 },
+	{ 0x68000000003ULL, 0x290000007ULL, 2 },
+	{ 0x68000000003ULL, 0x2a0000003ULL, 2 },
+	{ 0x68000000003ULL, 0x300000001ULL, 2 },
+	{ 0x68000000003ULL, 0x380000003ULL, 2 },
+	{ 0x80000000001ULL, 0x0ULL, 1 },
+	{ 0x80000000001ULL, 0x1ULL, 1 },
+	{ 0x80000000001ULL, 0x80000003ULL, 1 },
+	{ 0x80000000001ULL, 0x90000007ULL, 1 },
+	{ 0x80000000001ULL, 0x9040000fULL, 1 },
+	{ 0x80000000001ULL, 0x90800007ULL, 1 },
+	{ 0x80000000001ULL, 0x97000007ULL, 1 },
+	{ 0x80000000001ULL, 0xa0000003ULL, 1 },
+	{ 0x80000000001ULL, 0xb0000007ULL, 1 },
+	{ 0x80000000001ULL, 0xe0000003ULL, 1 },
+	{ 0x80000000001ULL, 0x100000001ULL, 1 },
+	{ 0x80000000001ULL, 0x180000003ULL, 1 },
+	{ 0x80000000001ULL, 0x190000007ULL, 1 },
+	{ 0x80000000001ULL, 0x1a0000003ULL, 1 },
+	{ 0x80000000001ULL, 0x200000001ULL, 1 },
+	{ 0x80000000001ULL, 0x280000003ULL, 1 },
+	{ 0x80000000001ULL, 0x290000007ULL, 1 },
+	{ 0x80000000001ULL, 0x2a0000003ULL, 1 },
+	{ 0x80000000001ULL, 0x300000001ULL, 1 },
+	{ 0x80000000001ULL, 0x380000003ULL, 1 },
+	{ 0xa0000000003ULL, 0x0ULL, 2 },
+	{ 0xa0000000003ULL, 0x1ULL, 2 },
+	{ 0xa0000000003ULL, 0x80000003ULL, 2 },
+	{ 0xa0000000003ULL, 0x90000007ULL, 2 },
+	{ 0xa0000000003ULL, 0x9040000fULL, 2 },
+	{ 0xa0000000003ULL, 0x90800007ULL, 2 },
+	{ 0xa0000000003ULL, 0x97000007ULL, 2 },
+	{ 0xa0000000003ULL, 0xa0000003ULL, 2 },
+	{ 0xa0000000003ULL, 0xb0000007ULL, 2 },
+	{ 0xa0000000003ULL, 0xe0000003ULL, 2 },
+	{ 0xa0000000003ULL, 0x100000001ULL, 2 },
+	{ 0xa0000000003ULL, 0x180000003ULL, 2 },
+	{ 0xa0000000003ULL, 0x190000007ULL, 2 },
+	{ 0xa0000000003ULL, 0x1a0000003ULL, 2 },
+	{ 0xa0000000003ULL, 0x200000001ULL, 2 },
+	{ 0xa0000000003ULL, 0x280000003ULL, 2 },
+	{ 0xa0000000003ULL, 0x290000007ULL, 2 },
+	{ 0xa0000000003ULL, 0x2a0000003ULL, 2 },
+	{ 0xa0000000003ULL, 0x300000001ULL, 2 },
+	{ 0xa0000000003ULL, 0x380000003ULL, 2 },
+	{ 0xa2000000007ULL, 0x0ULL, 3 },
+	{ 0xa2000000007ULL, 0x1ULL, 3 },
+	{ 0xa2000000007ULL, 0x80000003ULL, 3 },
+	{ 0xa2000000007ULL, 0x90000007ULL, 3 },
+	{ 0xa2000000007ULL, 0x9040000fULL, 3 },
+	{ 0xa2000000007ULL, 0x90800007ULL, 3 },
+	{ 0xa2000000007ULL, 0x97000007ULL, 3 },
+	{ 0xa2000000007ULL, 0xa0000003ULL, 3 },
+	{ 0xa2000000007ULL, 0xb0000007ULL, 3 },
+	{ 0xa2000000007ULL, 0xe0000003ULL, 3 },
+	{ 0xa2000000007ULL, 0x100000001ULL, 3 },
+	{ 0xa2000000007ULL, 0x180000003ULL, 3 },
+	{ 0xa2000000007ULL, 0x190000007ULL, 3 },
+	{ 0xa2000000007ULL, 0x1a0000003ULL, 3 },
+	{ 0xa2000000007ULL, 0x200000001ULL, 3 },
+	{ 0xa2000000007ULL, 0x280000003ULL, 3 },
+	{ 0xa2000000007ULL, 0x290000007ULL, 3 },
+	{ 0xa2000000007ULL, 0x2a0000003ULL, 3 },
+	{ 0xa2000000007ULL, 0x300000001ULL, 3 },
+	{ 0xa2000000007ULL, 0x380000003ULL, 3 },
+	{ 0xa8000000003ULL, 0x0ULL, 2 },
+	{ 0xa8000000003ULL, 0x1ULL, 2 },
+	{ 0xa8000000003ULL, 0x80000003ULL, 2 },
+	{ 0xa8000000003ULL, 0x90000007ULL, 2 },
+	{ 0xa8000000003ULL, 0x9040000fULL, 2 },
+	{ 0xa8000000003ULL, 0x90800007ULL, 2 },
+	{ 0xa8000000003ULL, 0x97000007ULL, 2 },
+	{ 0xa8000000003ULL, 0xa0000003ULL, 2 },
+	{ 0xa8000000003ULL, 0xb0000007ULL, 2 },
+	{ 0xa8000000003ULL, 0xe0000003ULL, 2 },
+	{ 0xa8000000003ULL, 0x100000001ULL, 2 },
+	{ 0xa8000000003ULL, 0x180000003ULL, 2 },
+	{ 0xa8000000003ULL, 0x190000007ULL, 2 },
+	{ 0xa8000000003ULL, 0x1a0000003ULL, 2 },
+	{ 0xa8000000003ULL, 0x200000001ULL, 2 },
+	{ 0xa8000000003ULL, 0x280000003ULL, 2 },
+	{ 0xa8000000003ULL, 0x290000007ULL, 2 },
+	{ 0xa8000000003ULL, 0x2a0000003ULL, 2 },
+	{ 0xa8000000003ULL, 0x300000001ULL, 2 },
+	{ 0xa8000000003ULL, 0x380000003ULL, 2 },
+	{ 0xc0000000001ULL, 0x0ULL, 1 },
+	{ 0xc0000000001ULL, 0x1ULL, 1 },
+	{ 0xc0000000001ULL, 0x80000003ULL, 1 },
+	{ 0xc0000000001ULL, 0x90000007ULL, 1 },
+	{ 0xc0000000001ULL, 0x9040000fULL, 1 },
+	{ 0xc0000000001ULL, 0x90800007ULL, 1 },
+	{ 0xc0000000001ULL, 0x97000007ULL, 1 },
+	{ 0xc0000000001ULL, 0xa0000003ULL, 1 },
+	{ 0xc0000000001ULL, 0xb0000007ULL, 1 },
+	{ 0xc0000000001ULL, 0xe0000003ULL, 1 },
+	{ 0xc0000000001ULL, 0x100000001ULL, 1 },
+	{ 0xc0000000001ULL, 0x180000003ULL, 1 },
+	{ 0xc0000000001ULL, 0x190000007ULL, 1 },
+	{ 0xc0000000001ULL, 0x1a0000003ULL, 1 },
+	{ 0xc0000000001ULL, 0x200000001ULL, 1 },
+	{ 0xc0000000001ULL, 0x280000003ULL, 1 },
+	{ 0xc0000000001ULL, 0x290000007ULL, 1 },
+	{ 0xc0000000001ULL, 0x2a0000003ULL, 1 },
+	{ 0xc0000000001ULL, 0x300000001ULL, 1 },
+	{ 0xc0000000001ULL, 0x380000003ULL, 1 },
+	{ 0xe0000000003ULL, 0x0ULL, 2 },
+	{ 0xe0000000003ULL, 0x1ULL, 2 },
+	{ 0xe0000000003ULL, 0x80000003ULL, 2 },
+	{ 0xe0000000003ULL, 0x90000007ULL, 2 },
+	{ 0xe0000000003ULL, 0x9040000fULL, 2 },
+	{ 0xe0000000003ULL, 0x90800007ULL, 2 },
+	{ 0xe0000000003ULL, 0x97000007ULL, 2 },
+	{ 0xe0000000003ULL, 0xa0000003ULL, 2 },
+	{ 0xe0000000003ULL, 0xb0000007ULL, 2 },
+	{ 0xe0000000003ULL, 0xe0000003ULL, 2 },
+	{ 0xe0000000003ULL, 0x100000001ULL, 2 },
+	{ 0xe0000000003ULL, 0x180000003ULL, 2 },
+	{ 0xe0000000003ULL, 0x190000007ULL, 2 },
+	{ 0xe0000000003ULL, 0x1a0000003ULL, 2 },
+	{ 0xe0000000003ULL, 0x200000001ULL, 2 },
+	{ 0xe0000000003ULL, 0x280000003ULL, 2 },
+	{ 0xe0000000003ULL, 0x290000007ULL, 2 },
+	{ 0xe0000000003ULL, 0x2a0000003ULL, 2 },
+	{ 0xe0000000003ULL, 0x300000001ULL, 2 },
+	{ 0xe0000000003ULL, 0x380000003ULL, 2 },
+};
+
+// Protoss versus Zerg, searched to depth 10
+static const BookEntry BOOK_2[] = {
+	{ 0x0ULL, 0x0ULL, 0 },
+	{ 0x0ULL, 0x1ULL, 0 },
+	{ 0x0ULL, 0x20000000003ULL, 0 },
+	{ 0x0ULL, 0x22000000007ULL, 0 },
+	{ 0x0ULL, 0x2200000001fULL, 0 },
+	{ 0x0ULL, 0x26000000007ULL, 0 },
+	{ 0x0ULL, 0x28000000003ULL, 0 },
+	{ 0x0ULL, 0x2a000000007ULL, 0 },
+	{ 0x0ULL, 0x38000000003ULL, 0 },
+	{ 0x0ULL, 0x40000000001ULL, 0 },
+	{ 0x0ULL, 0x60000000003ULL, 0 },
+	{ 0x0ULL, 0x62000000007ULL, 0 },
+	{ 0x0ULL, 0x68000000003ULL, 0 },
+	{ 0x0ULL, 0x80000000001ULL, 0 },
+	{ 0x0ULL, 0xa0000000003ULL, 0 },
+	{ 0x0ULL, 0xa2000000007ULL, 0 },
+	{ 0x0ULL, 0xa8000000003ULL, 0 },
+	{ 0x0ULL, 0xc0000000001ULL, 0 },
+	{ 0x0ULL, 0xe0000000003ULL, 0 },
+	{ 0x1ULL, 0x0ULL, 1 },
+	{ 0x1ULL, 0x1ULL, 1 },
+	{ 0x1ULL, 0x20000000003ULL, 1 },
+	{ 0x1ULL, 0x22000000007ULL, 1 },
+	{ 0x1ULL, 0x2200000001fULL, 1 },
+	{ 0x1ULL, 0x26000000007ULL, 1 },
+	{ 0x1ULL, 0x28000000003ULL, 1 },
+	{ 0x1ULL, 0x2a000000007ULL, 1 },
+	{ 0x1ULL, 0x38000000003ULL, 1 },
+	{ 0x1ULL, 0x40000000001ULL, 1 },
+	{ 0x1ULL, 0x60000000003ULL, 1 },
+	{ 0x1ULL, 0x62000000007ULL, 1 },
+	{ 0x1ULL, 0x68000000003ULL, 1 },
+	{ 0x1ULL, 0x80000000001ULL, 1 },
+	{ 0x1ULL, 0xa0000000003ULL, 1 },
+	{ 0x1ULL, 0xa2000000007ULL, 1 },
+	{ 0x1ULL, 0xa8000000003ULL, 1 },
+	{ 0x1ULL, 0xc0000000001ULL, 1 },
+	{ 0x1ULL, 0xe0000000003ULL, 1 },
+	{ 0x20000000003ULL, 0x0ULL, 2 },
+	{ 0x20000000003ULL, 0x1ULL, 2 },
+	{ 0x20000000003ULL, 0x20000000003ULL, 2 },
+	{ 0x20000000003ULL, 0x22000000007ULL, 2 },
+	{ 0x20000000003ULL, 0x2200000001fULL, 2 },
+	{ 0x20000000003ULL, 0x26000000007ULL, 2 },
+	{ 0x20000000003ULL, 0x28000000003ULL, 2 },
+	{ 0x20000000003ULL, 0x2a000000007ULL, 2 },
+	{ 0x20000000003ULL, 0x38000000003ULL, 2 },
+	{ 0x20000000003ULL, 0x40000000001ULL, 2 },
+	{ 0x20000000003ULL, 0x60000000003ULL, 2 },
+	{ 0x20000000003ULL, 0x62000000007ULL, 2 },
+	{ 0x20000000003ULL, 0x68000000003ULL, 2 },
+	{ 0x20000000003ULL, 0x80000000001ULL, 2 },
+	{ 0x20000000003ULL, 0xa0000000003ULL, 2 },
+	{ 0x20000000003ULL, 0xa2000000007ULL, 2 },
+	{ 0x20000000003ULL, 0xa8000000003ULL, 2 },
+	{ 0x20000000003ULL, 0xc0000000001ULL, 2 },
+	{ 0x20000000003ULL, 0xe0000000003ULL, 2 },
+	{ 0x22000000007ULL, 0x0ULL, 3 },
+	{ 0x22000000007ULL, 0x1ULL, 3 },
+	{ 0x22000000007ULL, 0x20000000003ULL, 3 },
+	{ 0x22000000007ULL, 0x22000000007ULL, 3 },
+	{ 0x22000000007ULL, 0x2200000001fULL, 3 },
+	{ 0x22000000007ULL, 0x26000000007ULL, 3 },
+	{ 0x22000000007ULL, 0x28000000003ULL, 3 },
+	{ 0x22000000007ULL, 0x2a000000007ULL, 3 },
+	{ 0x22000000007ULL, 0x38000000003ULL, 3 },
+	{ 0x22000000007ULL, 0x40000000001ULL, 3 },
+	{ 0x22000000007ULL, 0x60000000003ULL, 3 },
+	{ 0x22000000007ULL, 0x62000000007ULL, 3 },
+	{ 0x22000000007ULL, 0x68000000003ULL, 3 },
+	{ 0x22000000007ULL, 0x80000000001ULL, 3 },
+	{ 0x22000000007ULL, 0xa0000000003ULL, 3 },
+	{ 0x22000000007ULL, 0xa2000000007ULL, 3 },
+	{ 0x22000000007ULL, 0xa8000000003ULL, 3 },
+	{ 0x22000000007ULL, 0xc0000000001ULL, 3 },
+	{ 0x22000000007ULL, 0xe0000000003ULL, 3 },
+	{ 0x2200000001fULL, 0x0ULL, 11 },
+	{ 0x2200000001fULL, 0x1ULL, 11 },
+	{ 0x2200000001fULL, 0x20000000003ULL, 11 },
+	{ 0x2200000001fULL, 0x22000000007ULL, 11 },
+	{ 0x2200000001fULL, 0x2200000001fULL, 11 },
+	{ 0x2200000001fULL, 0x26000000007ULL, 11 },
+	{ 0x2200000001fULL, 0x28000000003ULL, 11 },
+	{ 0x2200000001fULL, 0x2a000000007ULL, 11 },
+	{ 0x2200000001fULL, 0x38000000003ULL, 11 },
+	{ 0x2200000001fULL, 0x40000000001ULL, 11 },
+	{ 0x2200000001fULL, 0x60000000003ULL, 11 },
+	{ 0x2200000001fULL, 0x62000000007ULL, 11 },
+	{ 0x2200000001fULL, 0x68000000003ULL, 11 },
+	{ 0x2200000001fULL, 0x80000000001ULL, 11 },
+	{ 0x2200000001fULL, 0xa0000000003ULL, 11 },
+	{ 0x2200000001fULL, 0xa2000000007ULL, 11 },
+	{ 0x2200000001fULL, 0xa8000000003ULL, 11 },
+	{ 0x2200000001fULL, 0xc0000000001ULL, 11 },
+	{ 0x2200000001fULL, 0xe0000000003ULL, 11 },
+	{ 0x26000000007ULL, 0x0ULL, 3 },
+	{ 0x26000000007ULL, 0x1ULL, 3 },
+	{ 0x26000000007ULL, 0x20000000003ULL, 3 },
+	{ 0x26000000007ULL, 0x22000000007ULL, 3 },
+	{ 0x26000000007ULL, 0x2200000001fULL, 3 },
+	{ 0x26000000007ULL, 0x26000000007ULL, 3 },
+	{ 0x26000000007ULL, 0x28000000003ULL, 3 },
+	{ 0x26000000007ULL, 0x2a000000007ULL, 3 },
+	{ 0x26000000007ULL, 0x38000000003ULL, 3 },
+	{ 0x26000000007ULL, 0x40000000001ULL, 3 },
+	{ 0x26000000007ULL, 0x60000000003ULL, 3 },
+	{ 0x26000000007ULL, 0x62000000007ULL, 3 },
+	{ 0x26000000007ULL, 0x68000000003ULL, 3 },
+	{ 0x26000000007ULL, 0x80000000001ULL, 3 },
+	{ 0x26000000007ULL, 0xa0000000003ULL, 3 },
+	{ 0x26000000007ULL, 0xa2000000007ULL, 3 },
+	{ 0x26000000007ULL, 0xa8000000003ULL, 3 },
+	{ 0x26000000007ULL, 0xc0000000001ULL, 3 },
+	{ 0x26000000007ULL, 0xe0000000003ULL, 3 },
+	{ 0x28000000003ULL, 0x0ULL, 2 },
+	{ 0x28000000003ULL, 0x1ULL, 2 },
+	{ 0x28000000003ULL, 0x20000000003ULL, 2 },
+	{ 0x28000000003ULL, 0x22000000007ULL, 2 },
+	{ 0x28000000003ULL, 0x2200000001fULL, 2 },
+	{ 0x28000000003ULL, 0x26000000007ULL, 2 },
+	{ 0x28000000003ULL, 0x28000000003ULL, 2 },
+	{ 0x28000000003ULL, 0x2a000000007ULL, 2 },
+	{ 0x28000000003ULL, 0x38000000003ULL, 2 },
+	{ 0x28000000003ULL, 0x40000000001ULL, 2 },
+	{ 0x28000000003ULL, 0x60000000003ULL, 2 },
+	{ 0x28000000003ULL, 0x62000000007ULL, 2 },
+	{ 0x28000000003ULL, 0x68000000003ULL, 2 },
+	{ 0x28000000003ULL, 0x80000000001ULL, 2 },
+	{ 0x28000000003ULL, 0xa0000000003ULL, 2 },
+	{ 0x28000000003ULL, 0xa2000000007ULL, 2 },
+	{ 0x28000000003ULL, 0xa8000000003ULL, 2 },
+	{ 0x28000000003ULL, 0xc0000000001ULL, 2 },
+	{ 0x28000000003ULL, 0xe0000000003ULL, 2 },
+	{ 0x2a000000007ULL, 0x0ULL, 3 },
+	{ 0x2a000000007ULL, 0x1ULL, 3 },
+	{ 0x2a000000007ULL, 0x20000000003ULL, 3 },
+	{ 0x2a000000007ULL, 0x22000000007ULL, 3 },
+	{ 0x2a000000007ULL, 0x2200000001fULL, 3 },
+	{ 0x2a000000007ULL, 0x26000000007ULL, 3 },
+	{ 0x2a000000007ULL, 0x28000000003ULL, 3 },
+	{ 0x2a000000007ULL, 0x2a000000007ULL, 3 },
+	{ 0x2a000000007ULL, 0x38000000003ULL, 3 },
+	{ 0x2a000000007ULL, 0x40000000001ULL, 3 },
+	{ 0x2a000000007ULL, 0x60000000003ULL, 3 },
+	{ 0x2a000000007ULL, 0x62000000007ULL, 3 },
+	{ 0x2a000000007ULL, 0x68000000003ULL, 3 },
+	{ 0x2a000000007ULL, 0x80000000001ULL, 3 },
+	{ 0x2a000000007ULL, 0xa0000000003ULL, 3 },
+	{ 0x2a000000007ULL, 0xa2000000007ULL, 3 },
+	{ 0x2a000000007ULL, 0xa8000000003ULL, 3 },
+	{ 0x2a000000007ULL, 0xc0000000001ULL, 3 },
+	{ 0x2a000000007ULL, 0xe0000000003ULL, 3 },
+	{ 0x38000000003ULL, 0x0ULL, 2 },
+	{ 0x38000000003ULL, 0x1ULL, 2 },
+	{ 0x38000000003ULL, 0x20000000003ULL, 2 },
+	{ 0x38000000003ULL, 0x22000000007ULL, 2 },
+	{ 0x38000000003ULL, 0x2200000001fULL, 2 },
+	{ 0x38000000003ULL, 0x26000000007ULL, 2 },
+	{ 0x38000000003ULL, 0x28000000003ULL, 2 },
+	{ 0x38000000003ULL, 0x2a000000007ULL, 2 },
+	{ 0x38000000003ULL, 0x38000000003ULL, 2 },
+	{ 0x38000000003ULL, 0x40000000001ULL, 2 },
+	{ 0x38000000003ULL, 0x60000000003ULL, 2 },
+	{ 0x38000000003ULL, 0x62000000007ULL, 2 },
+	{ 0x38000000003ULL, 0x68000000003ULL, 2 },
+	{ 0x38000000003ULL, 0x80000000001ULL, 2 },
+	{ 0x38000000003ULL, 0xa0000000003ULL, 2 },
+	{ 0x38000000003ULL, 0xa2000000007ULL, 2 },
+	{ 0x38000000003ULL, 0xa8000000003ULL, 2 },
+	{ 0x38000000003ULL, 0xc0000000001ULL, 2 },
+	{ 0x38000000003ULL, 0xe0000000003ULL, 2 },
+	{ 0x40000000001ULL, 0x0ULL, 1 },
+	{ 0x40000000001ULL, 0x1ULL, 1 },
+	{ 0x40000000001ULL, 0x20000000003ULL, 1 },
+	{ 0x40000000001ULL, 0x22000000007ULL, 1 },
+	{ 0x40000000001ULL, 0x2200000001fULL, 1 },
+	{ 0x40000000001ULL, 0x26000000007ULL, 1 },
+	{ 0x40000000001ULL, 0x28000000003ULL, 1 },
+	{ 0x40000000001ULL, 0x2a000000007ULL, 1 },
+	{ 0x40000000001ULL, 0x38000000003ULL, 1 },
+	{ 0x40000000001ULL, 0x40000000001ULL, 1 },
+	{ 0x40000000001ULL, 0x60000000003ULL, 1 },
+	{ 0x40000000001ULL, 0x62000000007ULL, 1 },
+	{ 0x40000000001ULL, 0x68000000003ULL, 1 },
+	{ 0x40000000001ULL, 0x80000000001ULL, 1 },
+	{ 0x40000000001ULL, 0xa0000000003ULL, 1 },
+	{ 0x40000000001ULL, 0xa2000000007ULL, 1 },
+	{ 0x40000000001ULL, 0xa8000000003ULL, 1 },
+	{ 0x40000000001ULL, 0xc0000000001ULL, 1 },
+	{ 0x40000000001ULL, 0xe0000000003ULL, 1 },
+	{ 0x60000000003ULL, 0x0ULL, 2 },
+	{ 0x60000000003ULL, 0x1ULL, 2 },
+	{ 0x60000000003ULL, 0x20000000003ULL, 2 },
+	{ 0x60000000003ULL, 0x22000000007ULL, 2 },
+	{ 0x60000000003ULL, 0x2200000001fULL, 2 },
+	{ 0x60000000003ULL, 0x26000000007ULL, 2 },
+	{ 0x60000000003ULL, 0x28000000003ULL, 2 },
+	{ 0x60000000003ULL, 0x2a000000007ULL, 2 },
+	{ 0x60000000003ULL, 0x38000000003ULL, 2 },
+	{ 0x60000000003ULL, 0x40000000001ULL, 2 },
+	{ 0x60000000003ULL, 0x60000000003ULL, 2 },
+	{ 0x60000000003ULL, 0x62000000007ULL, 2 },
+	{ 0x60000000003ULL, 0x68000000003ULL, 2 },
+	{ 0x60000000003ULL, 0x80000000001ULL, 2 },
+	{ 0x60000000003ULL, 0xa0000000003ULL, 2 },
+	{ 0x60000000003ULL, 0xa2000000007ULL, 2 },
+	{ 0x60000000003ULL, 0xa8000000003ULL, 2 },
+	{ 0x60000000003ULL, 0xc0000000001ULL, 2 },
+	{ 0x60000000003ULL, 0xe0000000003ULL, 2 },
+	{ 0x62000000007ULL, 0x0ULL, 3 },
+	{ 0x62000000007ULL, 0x1ULL, 3 },
+	{ 0x62000000007ULL, 0x20000000003ULL, 3 },
+	{ 0x62000000007ULL, 0x22000000007ULL, 3 },
+	{ 0x62000000007ULL, 0x2200000001fULL, 3 },
+	{ 0x62000000007ULL, 0x26000000007ULL, 3 },
+	{ 0x62000000007ULL, 0x28000000003ULL, 3 },
+	{ 0x62000000007ULL, 0x2a000000007ULL, 3 },
+	{ 0x62000000007ULL, 0x38000000003ULL, 3 },
+	{ 0x62000000007ULL, 0x40000000001ULL, 3 },
+	{ 0x62000000007ULL, 0x60000000003ULL, 3 },
+	{ 0x62000000007ULL, 0x62000000007ULL, 3 },
+	{ 0x62000000007ULL, 0x68000000003ULL, 3 },
+	{ 0x62000000007ULL, 0x80000000001ULL, 3 },
+	{ 0x62000000007ULL, 0xa0000000003ULL, 3 },
+	{ 0x62000000007ULL, 0xa2000000007ULL, 3 },
+	{ 0x62000000007ULL, 0xa8000000003ULL, 3 },
+	{ 0x62000000007ULL, 0xc0000000001ULL, 3 },
+	{ 0x62000000007ULL, 0xe0000000003ULL, 3 },
+	{ 0x68000000003ULL, 0x0ULL, 2 },
+	{ 0x68000000003ULL, 0x1ULL, 2 },
+	{ 0x68000000003ULL, 0x20000000003ULL, 2 },
+	{ 0x68000000003ULL, 0x22000000007ULL, 2 },
+	{ 0x68000000003ULL, 0x2200000001fULL, 2 },
+	{ 0x68000000003ULL, 0x26000000007ULL, 2 },
+	{ 0x68000000003ULL, 0x28000000003ULL, 2 },
+	{ 0x68000000003ULL, 0x2a000000007ULL, 2 },
+	{ 0x68000000003ULL, 0x38000000003ULL, 2 },
+	{ 0x68000000003ULL, 0x40000000001ULL, 2 },
+	{ 0x68000000003ULL, 0x60000000003ULL, 2 },
+	{ 0x68000000003ULL, 0x62000000007ULL, 2 },
+	{ 0x68000000003ULL, 0x68000000003ULL, 2 },
+	{ 0x68000000003ULL, 0x80000000001ULL, 2 },
+	{ 0x68000000003ULL, 0xa0000000003ULL, 2 },
+	{ 0x68000000003ULL, 0xa2000000007ULL, 2 },
+	{ 0x68000000003ULL, 0xa8000000003ULL, 2 },
+	{ 0x68000000003ULL, 0xc0000000001ULL, 2 },
+	{ 0x68000000003ULL, 0xe0000000003ULL, 2 },
+	{ 0x80000000001ULL, 0x0ULL, 1 },
+	{ 0x80000000001ULL, 0x1ULL, 1 },
+	{ 0x80000000001ULL, 0x20000000003ULL, 1 },
+	{ 0x80000000001ULL, 0x22000000007ULL, 1 },
+	{ 0x80000000001ULL, 0x2200000001fULL, 1 },
+	{ 0x80000000001ULL, 0x26000000007ULL, 1 },
+	{ 0x80000000001ULL, 0x28000000003ULL, 1 },
+	{ 0x80000000001ULL, 0x2a000000007ULL, 1 },
+	{ 0x80000000001ULL, 0x38000000003ULL, 1 },
+	{ 0x80000000001ULL, 0x40000000001ULL, 1 },
+	{ 0x80000000001ULL, 0x60000000003ULL, 1 },
+	{ 0x80000000001ULL, 0x62000000007ULL, 1 },
+	{ 0x80000000001ULL, 0x68000000003ULL, 1 },
+	{ 0x80000000001ULL, 0x80000000001ULL, 1 },
+	{ 0x80000000001ULL, 0xa0000000003ULL, 1 },
+	{ 0x80000000001ULL, 0xa2000000007ULL, 1 },
+	{ 0x80000000001ULL, 0xa8000000003ULL, 1 },
+	{ 0x80000000001ULL, 0xc0000000001ULL, 1 },
+	{ 0x80000000001ULL, 0xe0000000003ULL, 1 },
+	{ 0xa0000000003ULL, 0x0ULL, 2 },
+	{ 0xa0000000003ULL, 0x1ULL, 2 },
+	{ 0xa0000000003ULL, 0x20000000003ULL, 2 },
+	{ 0xa0000000003ULL, 0x22000000007ULL, 2 },
+	{ 0xa0000000003ULL, 0x2200000001fULL, 2 },
+	{ 0xa0000000003ULL, 0x26000000007ULL, 2 },
+	{ 0xa0000000003ULL, 0x28000000003ULL, 2 },
+	{ 0xa0000000003ULL, 0x2a000000007ULL, 2 },
+	{ 0xa0000000003ULL, 0x38000000003ULL, 2 },
+	{ 0xa0000000003ULL, 0x40000000001ULL, 2 },
+	{ 0xa0000000003ULL, 0x60000000003ULL, 2 },
+	{ 0xa0000000003ULL, 0x62000000007ULL, 2 },
+	{ 0xa0000000003ULL, 0x68000000003ULL, 2 },
+	{ 0xa0000000003ULL, 0x80000000001ULL, 2 },
+	{ 0xa0000000003ULL, 0xa0000000003ULL, 2 },
+	{ 0xa0000000003ULL, 0xa2000000007ULL, 2 },
+	{ 0xa0000000003ULL, 0xa8000000003ULL, 2 },
+	{ 0xa0000000003ULL, 0xc0000000001ULL, 2 },
+	{ 0xa0000000003ULL, 0xe0000000003ULL, 2 },
+	{ 0xa2000000007ULL, 0x0ULL, 3 },
+	{ 0xa2000000007ULL, 0x1ULL, 3 },
+	{ 0xa2000000007ULL, 0x20000000003ULL, 3 },
+	{ 0xa2000000007ULL, 0x22000000007ULL, 3 },
+	{ 0xa2000000007ULL, 0x2200000001fULL, 3 },
+	{ 0xa2000000007ULL, 0x26000000007ULL, 3 },
+	{ 0xa2000000007ULL, 0x28000000003ULL, 3 },
+	{ 0xa2000000007ULL, 0x2a000000007ULL, 3 },
+	{ 0xa2000000007ULL, 0x38000000003ULL, 3 },
+	{ 0xa2000000007ULL, 0x40000000001ULL, 3 },
+	{ 0xa2000000007ULL, 0x60000000003ULL, 3 },
+	{ 0xa2000000007ULL, 0x62000000007ULL, 3 },
+	{ 0xa2000000007ULL, 0x68000000003ULL, 3 },
+	{ 0xa2000000007ULL, 0x80000000001ULL, 3 },
+	{ 0xa2000000007ULL, 0xa0000000003ULL, 3 },
+	{ 0xa2000000007ULL, 0xa2000000007ULL, 3 },
+	{ 0xa2000000007ULL, 0xa8000000003ULL, 3 },
+	{ 0xa2000000007ULL, 0xc0000000001ULL, 3 },
+	{ 0xa2000000007ULL, 0xe0000000003ULL, 3 },
+	{ 0xa8000000003ULL, 0x0ULL, 2 },
+	{ 0xa8000000003ULL, 0x1ULL, 2 },
+	{ 0xa8000000003ULL, 0x20000000003ULL, 2 },
+	{ 0xa8000000003ULL, 0x22000000007ULL, 2 },
+	{ 0xa8000000003ULL, 0x2200000001fULL, 2 },
+	{ 0xa8000000003ULL, 0x26000000007ULL, 2 },
+	{ 0xa8000000003ULL, 0x28000000003ULL, 2 },
+	{ 0xa8000000003ULL, 0x2a000000007ULL, 2 },
+	{ 0xa8000000003ULL, 0x38000000003ULL, 2 },
+	{ 0xa8000000003ULL, 0x40000000001ULL, 2 },
+	{ 0xa8000000003ULL, 0x60000000003ULL, 2 },
+	{ 0xa8000000003ULL, 0x62000000007ULL, 2 },
+	{ 0xa8000000003ULL, 0x68000000003ULL, 2 },
+	{ 0xa8000000003ULL, 0x80000000001ULL, 2 },
+	{ 0xa8000000003ULL, 0xa0000000003ULL, 2 },
+	{ 0xa8000000003ULL, 0xa2000000007ULL, 2 },
+	{ 0xa8000000003ULL, 0xa8000000003ULL, 2 },
+	{ 0xa8000000003ULL, 0xc0000000001ULL, 2 },
+	{ 0xa8000000003ULL, 0xe0000000003ULL, 2 },
+	{ 0xc0000000001ULL, 0x0ULL, 1 },
+	{ 0xc0000000001ULL, 0x1ULL, 1 },
+	{ 0xc0000000001ULL, 0x20000000003ULL, 1 },
+	{ 0xc0000000001ULL, 0x22000000007ULL, 1 },
+	{ 0xc0000000001ULL, 0x2200000001fULL, 1 },
+	{ 0xc0000000001ULL, 0x26000000007ULL, 1 },
+	{ 0xc0000000001ULL, 0x28000000003ULL, 1 },
+	{ 0xc0000000001ULL, 0x2a000000007ULL, 1 },
+	{ 0xc0000000001ULL, 0x38000000003ULL, 1 },
+	{ 0xc0000000001ULL, 0x40000000001ULL, 1 },
+	{ 0xc0000000001ULL, 0x60000000003ULL, 1 },
+	{ 0xc0000000001ULL, 0x62000000007ULL, 1 },
+	{ 0xc0000000001ULL, 0x68000000003ULL, 1 },
+	{ 0xc0000000001ULL, 0x80000000001ULL, 1 },
+	{ 0xc0000000001ULL, 0xa0000000003ULL, 1 },
+	{ 0xc0000000001ULL, 0xa2000000007ULL, 1 },
+	{ 0xc0000000001ULL, 0xa8000000003ULL, 1 },
+	{ 0xc0000000001ULL, 0xc0000000001ULL, 1 },
+	{ 0xc0000000001ULL, 0xe0000000003ULL, 1 },
+	{ 0xe0000000003ULL, 0x0ULL, 2 },
+	{ 0xe0000000003ULL, 0x1ULL, 2 },
+	{ 0xe0000000003ULL, 0x20000000003ULL, 2 },
+	{ 0xe0000000003ULL, 0x22000000007ULL, 2 },
+	{ 0xe0000000003ULL, 0x2200000001fULL, 2 },
+	{ 0xe0000000003ULL, 0x26000000007ULL, 2 },
+	{ 0xe0000000003ULL, 0x28000000003ULL, 2 },
+	{ 0xe0000000003ULL, 0x2a000000007ULL, 2 },
+	{ 0xe0000000003ULL, 0x38000000003ULL, 2 },
+	{ 0xe0000000003ULL, 0x40000000001ULL, 2 },
+	{ 0xe0000000003ULL, 0x60000000003ULL, 2 },
+	{ 0xe0000000003ULL, 0x62000000007ULL, 2 },
+	{ 0xe0000000003ULL, 0x68000000003ULL, 2 },
+	{ 0xe0000000003ULL, 0x80000000001ULL, 2 },
+	{ 0xe0000000003ULL, 0xa0000000003ULL, 2 },
+	{ 0xe0000000003ULL, 0xa2000000007ULL, 2 },
+	{ 0xe0000000003ULL, 0xa8000000003ULL, 2 },
+	{ 0xe0000000003ULL, 0xc0000000001ULL, 2 },
+	{ 0xe0000000003ULL, 0xe0000000003ULL, 2 },
+};
+
+static const OpeningBookDef BOOKS[] = {
+	{ BWAPI::Races::Enum::Protoss, BWAPI::Races::Enum::Protoss, 10, BOOK_0, 361 },
+	{ BWAPI::Races::Enum::Protoss, BWAPI::Races::Enum::Terran, 10, BOOK_1, 380 },
+	{ BWAPI::Races::Enum::Protoss, BWAPI::Races::Enum::Zerg, 10, BOOK_2, 361 },
+};
+
+const OpeningBookDef * const OpeningBook::OPENING_BOOKS = BOOKS;
+const int OpeningBook::NUM_OPENING_BOOKS = sizeof(BOOKS) / sizeof(BOOKS[0]);
@@ -0,0 +1,309 @@
+/**
+	PlacementGrid.cpp
+	Tile grids of buildability, reserved building sites and pylon power, used to place buildings without BWAPI's searches.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "PlacementGrid.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+using namespace ProBot;
+
+namespace {
+	// tiles powered by a pylon, relative to the tile POWER_FIELD_LEFT / POWER_FIELD_TOP tiles left of / above its top left tile
+	// (the same field as BWAPI's, sampled at the centre of each tile)
+	const bool POWER_FIELD[POWER_FIELD_HEIGHT][POWER_FIELD_WIDTH] = {
+		{ 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0 },
+		{ 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0 },
+		{ 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0 },
+		{ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 },
+		{ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 },
+		{ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 },
+		{ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1 },
+		{ 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0 },
+		{ 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0 },
+		{ 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0 }
+	};
+	const int POWER_FIELD_LEFT = 7;
+	const int POWER_FIELD_TOP = 4;
+}
+
+PlacementGrid::PlacementGrid()
+	: _width(0), _height(0){
+}
+
+int PlacementGrid::getIndex(int x, int y) const{
+	return y * _width + x;
+}
+
+bool PlacementGrid::isInside(int x, int y) const{
+	return x >= 0 && y >= 0 && x < _width && y < _height;
+}
+
+void PlacementGrid::reset(int width, int height){
+	_width = width;
+	_height = height;
+	_buildable.assign(width * height, 0);
+	_occupied.assign(width * height, 0);
+	_reserved.assign(width * height, 0);
+	_resourceClearance.assign(width * height, 0);
+	_power.assign(width * height, 0);
+	_geysers.clear();
+	_geyserTaken.clear();
+	_reservations.clear();
+	_buildings.clear();
+	_resources.clear();
+	_pylons.clear();
+}
+
+void PlacementGrid::initialize(){
+	reset(BWAPI::Broodwar->mapWidth(), BWAPI::Broodwar->mapHeight());
+	for (int y = 0; y < _height; y++){
+		for (int x = 0; x < _width; x++)
+			setBuildable(x, y, BWAPI::Broodwar->isBuildable(x, y));
+	}
+	for (auto & mineral : BWAPI::Broodwar->getStaticMinerals())
+		addResource(mineral->getID(), mineral->getInitialType(), mineral->getInitialTilePosition());
+	for (auto & geyser : BWAPI::Broodwar->getStaticGeysers())
+		addResource(geyser->getID(), geyser->getInitialType(), geyser->getInitialTilePosition());
+	// buildings already on the map, such as the starting resource depots
+	for (auto & unit : BWAPI::Broodwar->getAllUnits()){
+		if (!unit->getType().isBuilding())
+			continue;
+		addBuilding(unit->getID(), unit->getType(), unit->getTilePosition());
+		if (unit->getType() == BWAPI::UnitTypes::Protoss_Pylon && unit->isCompleted() && unit->getPlayer() == BWAPI::Broodwar->self())
+			addPylon(unit->getID(), unit->getTilePosition());
+	}
+}
+
+bool PlacementGrid::isInitialized() const{
+	return _width > 0;
+}
+
+void PlacementGrid::setBuildable(int x, int y, bool buildable){
+	if (isInside(x, y))
+		_buildable[getIndex(x, y)] = buildable ? 1 : 0;
+}
+
+void PlacementGrid::addToArea(std::vector<unsigned char> & grid, int left, int top, int width, int height, int amount){
+	for (int y = top; y < top + height; y++){
+		for (int x = left; x < left + width; x++){
+			if (isInside(x, y))
+				grid[getIndex(x, y)] = static_cast<unsigned char>(grid[getIndex(x, y)] + amount);
+		}
+	}
+}
+
+int PlacementGrid::findGeyser(BWAPI::TilePosition tile) const{
+	for (size_t i = 0; i < _geysers.size(); i++){
+		if (_geysers[i] == tile)
+			return static_cast<int>(i);
+	}
+	return -1;
+}
+
+void PlacementGrid::addBuilding(int unitID, BWAPI::UnitType unitType, BWAPI::TilePosition tile){
+	if (!isInitialized())
+		return;
+	removeBuilding(unitID);
+	// the reservation for the building (if it's ours) has been used
+	for (size_t i = 0; i < _reservations.size(); i++){
+		if (_reservations[i]._tile == tile && _reservations[i]._unitType == unitType){
+			setReserved(_reservations[i], -1);
+			_reservations.erase(_reservations.begin() + i);
+			break;
+		}
+	}
+	Placement placement;
+	placement._unitType = unitType;
+	placement._tile = tile;
+	_buildings[unitID] = placement;
+	// a refinery replaces its geyser, which already occupies the tiles
+	if (unitType.isRefinery()){
+		int geyser = findGeyser(tile);
+		if (geyser >= 0)
+			_geyserTaken[geyser] = true;
+		return;
+	}
+	addToArea(_occupied, tile.x, tile.y, unitType.tileWidth(), unitType.tileHeight(), 1);
+}
+
+void PlacementGrid::removeBuilding(int unitID){
+	auto it = _buildings.find(unitID);
+	if (it == _buildings.end())
+		return;
+	Placement placement = it->second;
+	_buildings.erase(it);
+	if (placement._unitType.isRefinery()){
+		int geyser = findGeyser(placement._tile);
+		if (geyser >= 0)
+			_geyserTaken[geyser] = false;
+		return;
+	}
+	addToArea(_occupied, placement._tile.x, placement._tile.y, placement._unitType.tileWidth(), placement._unitType.tileHeight(), -1);
+}
+
+void PlacementGrid::addResource(int unitID, BWAPI::UnitType unitType, BWAPI::TilePosition tile){
+	if (!isInitialized() || _resources.count(unitID) > 0)
+		return;
+	Placement placement;
+	placement._unitType = unitType;
+	placement._tile = tile;
+	_resources[unitID] = placement;
+	addToArea(_occupied, tile.x, tile.y, unitType.tileWidth(), unitType.tileHeight(), 1);
+	addToArea(_resourceClearance, tile.x - RESOURCE_CLEARANCE, tile.y - RESOURCE_CLEARANCE,
+		unitType.tileWidth() + 2 * RESOURCE_CLEARANCE, unitType.tileHeight() + 2 * RESOURCE_CLEARANCE, 1);
+	if (unitType == BWAPI::UnitTypes::Resource_Vespene_Geyser){
+		_geysers.push_back(tile);
+		_geyserTaken.push_back(false);
+	}
+}
+
+void PlacementGrid::removeResource(int unitID){
+	auto it = _resources.find(unitID);
+	if (it == _resources.end())
+		return;
+	BWAPI::UnitType unitType = it->second._unitType;
+	BWAPI::TilePosition tile = it->second._tile;
+	_resources.erase(it);
+	addToArea(_occupied, tile.x, tile.y, unitType.tileWidth(), unitType.tileHeight(), -1);
+	addToArea(_resourceClearance, tile.x - RESOURCE_CLEARANCE, tile.y - RESOURCE_CLEARANCE,
+		unitType.tileWidth() + 2 * RESOURCE_CLEARANCE, unitType.tileHeight() + 2 * RESOURCE_CLEARANCE, -1);
+}
+
+void PlacementGrid::addPowerField(BWAPI::TilePosition pylon, int amount){
+	for (int row = 0; row < POWER_FIELD_HEIGHT; row++){
+		for (int column = 0; column < POWER_FIELD_WIDTH; column++){
+			int x = pylon.x - POWER_FIELD_LEFT + column;
+			int y = pylon.y - POWER_FIELD_TOP + row;
+			if (POWER_FIELD[row][column] && isInside(x, y))
+				_power[getIndex(x, y)] = static_cast<unsigned char>(_power[getIndex(x, y)] + amount);
+		}
+	}
+}
+
+void PlacementGrid::addPylon(int unitID, BWAPI::TilePosition tile){
+	if (!isInitialized() || _pylons.count(unitID) > 0)
+		return;
+	_pylons[unitID] = tile;
+	addPowerField(tile, 1);
+}
+
+void PlacementGrid::removePylon(int unitID){
+	auto it = _pylons.find(unitID);
+	if (it == _pylons.end())
+		return;
+	addPowerField(it->second, -1);
+	_pylons.erase(it);
+}
+
+void PlacementGrid::setReserved(const Reservation & reservation, int amount){
+	addToArea(_reserved, reservation._tile.x, reservation._tile.y, reservation._unitType.tileWidth(), reservation._unitType.tileHeight(), amount);
+}
+
+void PlacementGrid::reserve(BWAPI::UnitType unitType, BWAPI::TilePosition tile, int expireFrame){
+	if (!isInitialized())
+		return;
+	Reservation reservation;
+	reservation._tile = tile;
+	reservation._unitType = unitType;
+	reservation._expireFrame = expireFrame;
+	_reservations.push_back(reservation);
+	setReserved(reservation, 1);
+}
+
+void PlacementGrid::expireReservations(int frame){
+	for (size_t i = 0; i < _reservations.size();){
+		if (_reservations[i]._expireFrame <= frame){
+			setReserved(_reservations[i], -1);
+			_reservations.erase(_reservations.begin() + i);
+		}
+		else
+			i++;
+	}
+}
+
+int PlacementGrid::getNumberOfReservations() const{
+	return static_cast<int>(_reservations.size());
+}
+
+bool PlacementGrid::hasPower(BWAPI::UnitType unitType, BWAPI::TilePosition tile) const{
+	if (!unitType.requiresPsi())
+		return true;
+	// a building is powered if the tile at its centre is
+	int x = tile.x + unitType.tileWidth() / 2;
+	int y = tile.y + unitType.tileHeight() / 2;
+	return isInside(x, y) && _power[getIndex(x, y)] > 0;
+}
+
+bool PlacementGrid::canPlace(BWAPI::UnitType unitType, BWAPI::TilePosition tile) const{
+	if (!isInitialized())
+		return false;
+	if (unitType.isRefinery()){
+		int geyser = findGeyser(tile);
+		return geyser >= 0 && !_geyserTaken[geyser] && _reserved[getIndex(tile.x, tile.y)] == 0;
+	}
+	int width = unitType.tileWidth();
+	int height = unitType.tileHeight();
+	if (!isInside(tile.x, tile.y) || !isInside(tile.x + width - 1, tile.y + height - 1))
+		return false;
+	for (int y = tile.y; y < tile.y + height; y++){
+		for (int x = tile.x; x < tile.x + width; x++){
+			int index = getIndex(x, y);
+			if (!_buildable[index] || _occupied[index] || _reserved[index] || _resourceClearance[index])
+				return false;
+		}
+	}
+	// the margin may be off the map or unbuildable, but not taken by another building
+	for (int y = tile.y - BUILDING_MARGIN; y < tile.y + height + BUILDING_MARGIN; y++){
+		for (int x = tile.x - BUILDING_MARGIN; x < tile.x + width + BUILDING_MARGIN; x++){
+			if (isInside(x, y) && (_occupied[getIndex(x, y)] || _reserved[getIndex(x, y)]))
+				return false;
+		}
+	}
+	return hasPower(unitType, tile);
+}
+
+BWAPI::TilePosition PlacementGrid::findSite(BWAPI::UnitType unitType, BWAPI::TilePosition near) const{
+	if (!isInitialized())
+		return BWAPI::TilePositions::Invalid;
+	if (unitType.isRefinery()){
+		int closest = -1;
+		int closestDistance = INT_MAX;
+		for (size_t i = 0; i < _geysers.size(); i++){
+			int distance = std::max(std::abs(_geysers[i].x - near.x), std::abs(_geysers[i].y - near.y));
+			if (distance < closestDistance && canPlace(unitType, _geysers[i])){
+				closest = static_cast<int>(i);
+				closestDistance = distance;
+			}
+		}
+		return closest >= 0 ? _geysers[closest] : BWAPI::TilePositions::Invalid;
+	}
+
+	// centre the building on the given tile, then search rings of tiles around it, closest first
+	int centreX = near.x - unitType.tileWidth() / 2;
+	int centreY = near.y - unitType.tileHeight() / 2;
+	for (int radius = 0; radius <= MAX_PLACEMENT_RADIUS; radius++){
+		for (int dy = -radius; dy <= radius; dy++){
+			// the top and bottom rows of the ring are searched in full, and only the ends of the rows in between
+			int step = (dy == -radius || dy == radius || radius == 0) ? 1 : 2 * radius;
+			for (int dx = -radius; dx <= radius; dx += step){
+				BWAPI::TilePosition tile(centreX + dx, centreY + dy);
+				if (canPlace(unitType, tile))
+					return tile;
+			}
+		}
+	}
+	return BWAPI::TilePositions::Invalid;
+}
+
+void PlacementGrid::draw() const{
+	for (const Reservation & reservation : _reservations){
+		BWAPI::Broodwar->drawBoxMap(BWAPI::Position(reservation._tile),
+			BWAPI::Position(reservation._tile + reservation._unitType.tileSize()), BWAPI::Colors::Blue);
+	}
+}
@@ -0,0 +1,138 @@
+/**
+	PlacementGrid.h
+	Tile grids of buildability, reserved building sites and pylon power, used to place buildings without BWAPI's searches.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+#include <BWAPI.h>
+#include <map>
+#include <vector>
+
+namespace ProBot{
+	// furthest (in tiles, in each direction) from the requested location that a building site is searched for
+	const int MAX_PLACEMENT_RADIUS = 32;
+	// frames that a site stays reserved for a worker on its way to build there
+	const int RESERVATION_FRAMES = 480;
+	// tiles kept clear around minerals and geysers, so that no building gets in the way of mining (and resource depots are legal)
+	const int RESOURCE_CLEARANCE = 3;
+	// tiles kept clear around every building (other than refineries), so that units can walk out of production buildings
+	const int BUILDING_MARGIN = 1;
+	// size of the pylon power field in tiles, centred on the pylon
+	const int POWER_FIELD_WIDTH = 16;
+	const int POWER_FIELD_HEIGHT = 10;
+
+	/**
+		Tile resolution grids of the map, kept up to date by the unit event handlers so that a building site can be found
+		with a local search: terrain buildability, tiles occupied by buildings and resources, tiles kept clear around resources,
+		footprints reserved for queued buildings, and the number of pylons powering each tile.
+	*/
+	class PlacementGrid {
+		/**
+			A site that a worker has been sent to build on.
+		*/
+		struct Reservation {
+			BWAPI::TilePosition _tile;
+			BWAPI::UnitType _unitType;
+			int _expireFrame;
+		};
+
+		/**
+			The footprint that a unit was added to the grids with.
+		*/
+		struct Placement {
+			BWAPI::UnitType _unitType;
+			BWAPI::TilePosition _tile;
+		};
+
+		int _width;
+		int _height;
+		// one value per tile, indexed by y * _width + x
+		std::vector<unsigned char> _buildable;
+		std::vector<unsigned char> _occupied;
+		std::vector<unsigned char> _reserved;
+		// number of resources / pylons whose clearance area / power field covers each tile
+		std::vector<unsigned char> _resourceClearance;
+		std::vector<unsigned char> _power;
+		// top left tiles of the geysers, and whether a refinery has been built on each
+		std::vector<BWAPI::TilePosition> _geysers;
+		std::vector<bool> _geyserTaken;
+		std::vector<Reservation> _reservations;
+		// units added to the grids, by unit ID, so that only what was added is ever removed
+		std::map<int, Placement> _buildings;
+		std::map<int, Placement> _resources;
+		std::map<int, BWAPI::TilePosition> _pylons;
+
+		int getIndex(int x, int y) const;
+		bool isInside(int x, int y) const;
+		/**
+			Adds the given amount to every tile of a rectangle (clipped to the map) in the given grid.
+		*/
+		void addToArea(std::vector<unsigned char> & grid, int left, int top, int width, int height, int amount);
+		void addPowerField(BWAPI::TilePosition pylon, int amount);
+		void setReserved(const Reservation & reservation, int amount);
+		int findGeyser(BWAPI::TilePosition tile) const;
+
+	public:
+		PlacementGrid();
+		/**
+			Clears the grids to a map of the given size, with no buildable tiles.
+		*/
+		void reset(int width, int height);
+		/**
+			Builds the grids from the current game: the map's buildable tiles, the static resources,
+			and every building already on the map. Should be called once the game has started.
+		*/
+		void initialize();
+		bool isInitialized() const;
+		void setBuildable(int x, int y, bool buildable);
+
+		/**
+			Event handlers, which keep the grids up to date. They do nothing before the grids are initialized.
+			Buildings (including refineries) occupy their footprint from when they're placed, and release any reservation there.
+			Pylons only power the tiles around them once they're completed.
+			Units are keyed by ID: adding a unit again (such as a building that morphed, or one seen again) replaces its footprint,
+			and removing a unit that was never added (such as an enemy building placed out of sight) does nothing.
+		*/
+		void addBuilding(int unitID, BWAPI::UnitType unitType, BWAPI::TilePosition tile);
+		void removeBuilding(int unitID);
+		void addResource(int unitID, BWAPI::UnitType unitType, BWAPI::TilePosition tile);
+		void removeResource(int unitID);
+		void addPylon(int unitID, BWAPI::TilePosition tile);
+		void removePylon(int unitID);
+
+		/**
+			Reserves a site for a building that a worker has been sent to build, until the given frame or until the building is placed.
+		*/
+		void reserve(BWAPI::UnitType unitType, BWAPI::TilePosition tile, int expireFrame);
+		/**
+			Releases the reservations that have expired by the given frame.
+		*/
+		void expireReservations(int frame);
+		int getNumberOfReservations() const;
+
+		/**
+			Returns true if a completed pylon powers a building of the given type placed at the given tile.
+		*/
+		bool hasPower(BWAPI::UnitType unitType, BWAPI::TilePosition tile) const;
+		/**
+			Returns true if a building of the given type can be placed with its top left corner at the given tile,
+			keeping clear of other buildings, reservations and resources.
+		*/
+		bool canPlace(BWAPI::UnitType unitType, BWAPI::TilePosition tile) const;
+		/**
+			Returns the site closest to the given tile (by the larger of the x and y distances) that a building of the given type
+			can be placed at, or TilePositions::Invalid if there's none within MAX_PLACEMENT_RADIUS.
+			Refineries are placed on the closest geyser without one.
+		*/
+		BWAPI::TilePosition findSite(BWAPI::UnitType unitType, BWAPI::TilePosition near) const;
+
+		/**
+			Draws the reserved sites for debugging purposes.
+		*/
+		void draw() const;
+	};
+}
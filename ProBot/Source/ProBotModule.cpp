@@ -1,6 +1,7 @@
 
 #include "ProBotModule.h"
 #include <iostream>
+#include <thread>
 
 using namespace ProBot;
 using namespace BWAPI;
@@ -17,6 +18,22 @@ void ProBotModule::onStart()
 	// groups commands together to reduce bot apm
 	Broodwar->setCommandOptimizationLevel(2);
 
+	// precompute unit type scores and race trees used by the tech search, then start searching in the background
+	// (split between every core but the one running the game thread)
+	CombatUtil::initStaticTables();
+	initBaseTreeStores();
+	BuildMinimax::clearSearchLog();
+	BuildMinimax::setSearchThreads(static_cast<int>(std::thread::hardware_concurrency()) - 1);
+	BuildMinimax::startSearchWorker();
+
+	// build the grids that buildings are placed with, which the unit events keep up to date from here on
+	_gameManager.getMacroManager()->getPlacementGrid()->initialize();
+
+	// play the scripted build order if there is one; the script is loaded every game, so it can be changed between games
+	std::string error;
+	if (!_gameManager.getMacroManager()->loadBuildOrder(BuildOrderScript::DEFAULT_SCRIPT_PATH, BuildOrderScript::DEFAULT_BUILD_ORDER, error))
+		Broodwar << "Using the built-in build order (" << error << ")" << std::endl;
+
 	// if race isn't protoss, then may as well surrender.
 	if (Broodwar->self()->getRace() != Races::Protoss)
 		Broodwar->leaveGame();
@@ -25,8 +42,10 @@ void ProBotModule::onStart()
 void ProBotModule::onEnd(bool isWinner)
 {
 	// called when the game ends
+	BuildMinimax::stopSearchWorker();
+	// keep the cost of every tech search, to compare against frame times and other games
+	BuildMinimax::exportSearchStats("bwapi-data/write/tech_search_stats.json");
 	//if (isWinner)
-	// TODO: Export stats as JSON
 }
 
 void ProBotModule::onFrame()
@@ -0,0 +1,30 @@
+/**
+	SearchContext.cpp
+	Everything a single tech search reads and writes, so that independent searches can run side by side.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "SearchContext.h"
+
+using namespace ProBot;
+
+BuildMinimax::SearchContext::SearchContext(TranspositionTable & transpositionTable)
+	: _transpositionTable(&transpositionTable), _searchHash(0), _evalAdvantage(0), _searchBudget(0),
+	_searchAborted(false), _moveOrdering(true), _ply(0){
+	for (int player = 0; player < 2; player++){
+		_searchState[player] = 0;
+		_blockedState[player] = 0;
+		_evalUnitCount[player] = 0;
+		_evalUnitScore[player] = 0;
+		for (tech_slot_t slot = 0; slot < MAX_TECH_NODES; slot++){
+			_historyScore[player][slot] = 0;
+			_moveOrderScore[player][slot] = 0;
+		}
+		for (int depth = 0; depth <= MAX_DEPTH; depth++){
+			for (int i = 0; i < NUM_KILLER_MOVES; i++)
+				_killerMoves[player][depth][i] = NULL_SLOT;
+		}
+	}
+}
@@ -0,0 +1,89 @@
+/**
+	SearchContext.h
+	Everything a single tech search reads and writes, so that independent searches can run side by side.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+#include "TechTreeStore.h"
+#include "TranspositionTable.h"
+#include "SearchStats.h"
+#include "Timer.h"
+
+namespace ProBot{
+	namespace BuildMinimax{
+		// number of killer moves remembered for each depth
+		const int NUM_KILLER_MOVES = 2;
+
+		/**
+			The state of one search: the trees being searched, the running evaluation, move ordering data,
+			scratch buffers and statistics. Searches with different contexts don't share anything except
+			the transposition table they are given, so each thread (or what-if analysis, or benchmark) can hold its own.
+			Copying a context gives a second search of the same position, sharing the same table.
+		*/
+		struct SearchContext {
+			// table of searched states, which may be shared with other contexts searching trees of the same layout
+			TranspositionTable * _transpositionTable;
+
+			// the trees being searched (a copy of each player's tree, taken when the search starts)
+			TechTreeStore _searchTree[2];
+
+			// the obtained state of each player's tree during a search, one bit per node of _searchTree
+			tech_mask_t _searchState[2];
+
+			// nodes of each player's tree that can't be obtained during a search
+			tech_mask_t _blockedState[2];
+
+			// Zobrist hash of both players' obtained nodes during a search
+			zobrist_key_t _searchHash;
+
+			// running totals that make up evaluateGameState for the current search state:
+			// the number and summed static score of each player's units, and the summed advantage of SELF's units over ENEMY's
+			int _evalUnitCount[2];
+			int _evalUnitScore[2];
+			int _evalAdvantage;
+
+			// static score of the unit at each node of each player's tree
+			int _slotUnitScore[2][MAX_TECH_NODES];
+
+			// static advantage of the unit at each node of SELF's tree over the unit at each node of ENEMY's tree
+			int _slotAdvantage[MAX_TECH_NODES][MAX_TECH_NODES];
+
+			// the moves generated at each remaining depth, so that searching a node doesn't need its own move list
+			tech_slot_t _moveBuffer[MAX_DEPTH + 1][MAX_TECH_NODES];
+
+			// time limit of the current search, measured by _searchTimer (0 for no limit)
+			Timer _searchTimer;
+			long long _searchBudget;
+
+			// set when the current search runs out of time, after which its results are discarded
+			bool _searchAborted;
+
+			// whether moves are ordered by static score, killer moves and history (can be disabled to compare node counts)
+			bool _moveOrdering;
+
+			// static ordering score of each move in each player's tree (the combat score of the units it unlocks)
+			int _moveOrderScore[2][MAX_TECH_NODES];
+
+			// the last moves that caused a cut-off at each remaining depth, for each player
+			tech_slot_t _killerMoves[2][MAX_DEPTH + 1][NUM_KILLER_MOVES];
+
+			// how often each move has caused a cut-off, weighted by depth (kept between searches)
+			int _historyScore[2][MAX_TECH_NODES];
+
+			// number of moves made from the root of the current search
+			int _ply;
+
+			// counters and timings of the current search
+			SearchStats _stats;
+
+			/**
+				Constructs an empty context that stores its searched states in the given table.
+			*/
+			explicit SearchContext(TranspositionTable & transpositionTable);
+		};
+	}
+}
@@ -0,0 +1,86 @@
+/**
+	SearchStats.cpp
+	Counters and timings describing the cost of a tech search.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "SearchStats.h"
+#include <cmath>
+#include <sstream>
+
+using namespace ProBot;
+
+BuildMinimax::SearchStats::SearchStats(){
+	clear();
+}
+
+void BuildMinimax::SearchStats::clear(){
+	_frame = -1;
+	_nodes = 0;
+	_leaves = 0;
+	for (int ply = 0; ply <= MAX_DEPTH; ply++){
+		_nodesByPly[ply] = 0;
+		_cutoffsByPly[ply] = 0;
+	}
+	_depth = 0;
+	_wallTime = 0;
+	_peakScratchBytes = 0;
+	_bookHit = false;
+}
+
+void BuildMinimax::SearchStats::addCounters(const SearchStats & other){
+	_nodes += other._nodes;
+	_leaves += other._leaves;
+	for (int ply = 0; ply <= MAX_DEPTH; ply++){
+		_nodesByPly[ply] += other._nodesByPly[ply];
+		_cutoffsByPly[ply] += other._cutoffsByPly[ply];
+	}
+}
+
+void BuildMinimax::SearchStats::recordScratch(unsigned int bytes){
+	if (bytes > _peakScratchBytes)
+		_peakScratchBytes = bytes;
+}
+
+unsigned int BuildMinimax::SearchStats::getCutoffs() const{
+	unsigned int cutoffs = 0;
+	for (int ply = 0; ply <= MAX_DEPTH; ply++)
+		cutoffs += _cutoffsByPly[ply];
+	return cutoffs;
+}
+
+double BuildMinimax::SearchStats::getEffectiveBranchingFactor() const{
+	int deepestPly = 0;
+	for (int ply = 1; ply <= MAX_DEPTH; ply++){
+		if (_nodesByPly[ply] > 0)
+			deepestPly = ply;
+	}
+	if (deepestPly == 0 || _nodesByPly[0] == 0)
+		return 0.0;
+	return std::pow(static_cast<double>(_nodesByPly[deepestPly]) / _nodesByPly[0], 1.0 / deepestPly);
+}
+
+std::string BuildMinimax::SearchStats::toJson() const{
+	std::ostringstream json;
+	json << "{\"frame\":" << _frame
+		<< ",\"depth\":" << _depth
+		<< ",\"wallTimeUs\":" << _wallTime
+		<< ",\"nodes\":" << _nodes
+		<< ",\"leaves\":" << _leaves
+		<< ",\"cutoffs\":" << getCutoffs()
+		<< ",\"effectiveBranchingFactor\":" << getEffectiveBranchingFactor()
+		<< ",\"peakScratchBytes\":" << _peakScratchBytes
+		<< ",\"bookHit\":" << (_bookHit ? "true" : "false");
+
+	// only the plies that were reached
+	json << ",\"nodesByPly\":[";
+	for (int ply = 0; ply <= MAX_DEPTH && _nodesByPly[ply] > 0; ply++)
+		json << (ply > 0 ? "," : "") << _nodesByPly[ply];
+	json << "],\"cutoffsByPly\":[";
+	for (int ply = 0; ply <= MAX_DEPTH && _nodesByPly[ply] > 0; ply++)
+		json << (ply > 0 ? "," : "") << _cutoffsByPly[ply];
+	json << "]}";
+	return json.str();
+}
@@ -0,0 +1,69 @@
+/**
+	SearchStats.h
+	Counters and timings describing the cost of a tech search.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+#include <string>
+
+namespace ProBot{
+	namespace BuildMinimax{
+		// deepest search supported by a context (and the number of plies that statistics are kept for, less one)
+		const int MAX_DEPTH = 16;
+
+		/**
+			Statistics of one search call. Counters are kept by ply (distance from the root move).
+			The counters of a search split between threads include the nodes searched by every thread.
+		*/
+		struct SearchStats {
+			// frame on which the search was requested (-1 if not requested by the game)
+			int _frame;
+			// number of nodes visited, and the number of those that were evaluated as leaves
+			unsigned int _nodes;
+			unsigned int _leaves;
+			unsigned int _nodesByPly[MAX_DEPTH + 1];
+			// number of alpha-beta cut-offs at each ply
+			unsigned int _cutoffsByPly[MAX_DEPTH + 1];
+			// deepest completed search (the deepest completed iteration of a time-budgeted search)
+			int _depth;
+			// time taken by the whole call, in microseconds
+			long long _wallTime;
+			// most memory used at once for move lists and thread copies of the search context, in bytes
+			unsigned int _peakScratchBytes;
+			// true if the move was taken from an opening book instead of being searched
+			bool _bookHit;
+
+			SearchStats();
+
+			/**
+				Resets every counter to zero.
+			*/
+			void clear();
+			/**
+				Adds the node, leaf and cut-off counters of another search (such as a helper thread) to these.
+			*/
+			void addCounters(const SearchStats & other);
+			/**
+				Raises the peak scratch memory to the given number of bytes if it is higher.
+			*/
+			void recordScratch(unsigned int bytes);
+			/**
+				Returns the total number of cut-offs over all plies.
+			*/
+			unsigned int getCutoffs() const;
+			/**
+				Returns the average number of children searched per node: the geometric mean of the growth in nodes
+				from each ply to the next, or 0 if only the root was searched.
+			*/
+			double getEffectiveBranchingFactor() const;
+			/**
+				Returns the statistics as a JSON object.
+			*/
+			std::string toJson() const;
+		};
+	}
+}
@@ -8,6 +8,9 @@
 
 
 #include "TechTree.h"
+#include "TechTreeData.h"
+#include "TechTreeVisitor.h"
+#include <mutex>
 
 using namespace ProBot;
 
@@ -184,54 +187,144 @@ bool ProBot::removeNode(TechTree * node, TechTree & tree){
 	return false;
 }
 
-TechTree ProBot::getBaseTree(BWAPI::Race race){
+/**
+	Expands the node at the given index of a tree definition, along with all of its children.
+*/
+static TechTree expandTreeDef(const TechTreeDef & def, int index){
+	TechTree tree(def._nodes[index]._unitType, false, def._nodes[index]._isUnique);
+	// children follow their parent in pre-order, so there is no need to look before the node
+	for (int child = index + 1; child < def._size; child++){
+		if (def._nodes[child]._parent == index)
+			tree._subs.push_back(expandTreeDef(def, child));
+	}
+	return tree;
+}
+
+// the expanded tree of each race, built once (see getBaseTree)
+static std::once_flag baseTreesInitialized;
+static TechTree protossBaseTree;
+static TechTree terranBaseTree;
+static TechTree zergBaseTree;
+
+static void expandBaseTrees(){
+	protossBaseTree = expandTreeDef(PROTOSS_TREE, 0);
+	terranBaseTree = expandTreeDef(TERRAN_TREE, 0);
+	zergBaseTree = expandTreeDef(ZERG_TREE, 0);
+}
+
+const TechTree & ProBot::getBaseTree(BWAPI::Race race){
+	std::call_once(baseTreesInitialized, expandBaseTrees);
 	if (race == BWAPI::Races::Protoss){
-		return PROTOSS_TREE;
+		return protossBaseTree;
 	}
 	else if (race == BWAPI::Races::Terran){
-		return TERRAN_TREE;
+		return terranBaseTree;
 	}
 	else if (race == BWAPI::Races::Zerg){
-		return ZERG_TREE;
+		return zergBaseTree;
 	}
 	else {
 		return NULL_TREE;
 	}
 }
 
-std::vector<TechTree> ProBot::findLeafNodes(TechTree tree, std::vector<TechTree> resultSoFar){
-	if (!tree.hasSubs()) // if leaf node found, add it to rsf
-		resultSoFar.push_back(tree);
-	for (int i = 0; i < static_cast<int>(tree._subs.size()); i++) // search through children recursively for leaf nodes
-		resultSoFar = findLeafNodes(tree._subs.at(i), resultSoFar);
-	return resultSoFar; // return results
+namespace {
+	/**
+		Collects the leaf nodes of a tree, optionally only those that are obtained and aren't buildings.
+	*/
+	class LeafNodeCollector : public TechTreeVisitor {
+		std::vector<const TechTree*> & _result;
+		bool _obtainedUnitsOnly;
+	public:
+		LeafNodeCollector(std::vector<const TechTree*> & result, bool obtainedUnitsOnly)
+			: _result(result), _obtainedUnitsOnly(obtainedUnitsOnly){}
+		virtual bool visit(const TechTree & node){
+			if (node._subs.empty() && (!_obtainedUnitsOnly || (node._obtained && !node._unitType.isBuilding())))
+				_result.push_back(&node);
+			return true;
+		}
+	};
+
+	/**
+		Collects the first unobtained node along each branch of a tree.
+	*/
+	class NextObtainableCollector : public TechTreeVisitor {
+		std::vector<const TechTree*> & _result;
+	public:
+		explicit NextObtainableCollector(std::vector<const TechTree*> & result) : _result(result){}
+		virtual bool visit(const TechTree & node){
+			if (node._obtained)
+				return true;
+			_result.push_back(&node);
+			return false; // nothing below an unobtained node can be obtained yet
+		}
+	};
+
+	/**
+		Collects the unit types of the obtained nodes of a tree.
+	*/
+	class ObtainedTypeCollector : public TechTreeVisitor {
+		std::vector<BWAPI::UnitType> & _result;
+	public:
+		explicit ObtainedTypeCollector(std::vector<BWAPI::UnitType> & result) : _result(result){}
+		virtual bool visit(const TechTree & node){
+			if (node._obtained)
+				_result.push_back(node._unitType);
+			return true;
+		}
+	};
+
+	/**
+		Copies the nodes that a collector found, for the functions that return their results by value.
+	*/
+	std::vector<TechTree> copyNodes(const std::vector<const TechTree*> & nodes){
+		std::vector<TechTree> result;
+		result.reserve(nodes.size());
+		for (const TechTree * node : nodes)
+			result.push_back(*node);
+		return result;
+	}
+}
+
+void ProBot::findLeafNodes(const TechTree & tree, std::vector<const TechTree*> & result){
+	LeafNodeCollector collector(result, false);
+	traverseTree(tree, collector);
+}
+
+std::vector<TechTree> ProBot::findLeafNodes(const TechTree & tree){
+	std::vector<const TechTree*> leafNodes;
+	findLeafNodes(tree, leafNodes);
+	return copyNodes(leafNodes);
+}
+
+void ProBot::findNonBuildingLeafNodes(const TechTree & tree, std::vector<const TechTree*> & result){
+	LeafNodeCollector collector(result, true);
+	traverseTree(tree, collector);
+}
+
+std::vector<TechTree> ProBot::findNonBuildingLeafNodes(const TechTree & tree){
+	std::vector<const TechTree*> leafNodes;
+	findNonBuildingLeafNodes(tree, leafNodes);
+	return copyNodes(leafNodes);
 }
 
-std::vector<TechTree> ProBot::findNonBuildingLeafNodes(TechTree tree){
-	// get all leaf nodes
-	std::vector<TechTree> leafNodes = findLeafNodes(tree);
-	// remove non-obtained nodes
-	leafNodes.erase(std::remove_if(leafNodes.begin(), leafNodes.end(), [](TechTree tree){ return !tree._obtained; }), leafNodes.end());
-	// remove non-building nodes
-	leafNodes.erase(std::remove_if(leafNodes.begin(), leafNodes.end(), [](TechTree tree){ return tree._unitType.isBuilding(); }), leafNodes.end());
-	return leafNodes;
+void ProBot::findNextObtainableNodes(const TechTree & tree, std::vector<const TechTree*> & result){
+	NextObtainableCollector collector(result);
+	traverseTree(tree, collector);
 }
 
-std::vector<TechTree> ProBot::findNextObtainableNodes(TechTree tree, std::vector<TechTree> resultSoFar){
-	if (!tree._obtained) // if node is obtained, add to results
-		resultSoFar.push_back(tree);
-	else 
-		for (int i = 0; i < static_cast<int>(tree._subs.size()); i++) // if any child is also obtained, remove from vector and check that child
-			resultSoFar = findNextObtainableNodes(tree._subs.at(i), resultSoFar);
-	return resultSoFar; // return results
+std::vector<TechTree> ProBot::findNextObtainableNodes(const TechTree & tree){
+	std::vector<const TechTree*> nodes;
+	findNextObtainableNodes(tree, nodes);
+	return copyNodes(nodes);
 }
 
-BWAPI::UnitType ProBot::getFirstDifference(TechTree tree1, TechTree tree2){
+BWAPI::UnitType ProBot::getFirstDifference(const TechTree & tree1, const TechTree & tree2){
 	if (tree1._obtained != tree2._obtained) // if the two obtained values are different, then return the unit type
 		return tree1._unitType;
 	for (int i = 0; i < static_cast<int>(tree1._subs.size()); i++){ // otherwise check recursively through children
 		BWAPI::UnitType res = getFirstDifference(tree1._subs.at(i), tree2._subs.at(i));
-		if (res.getName() != BWAPI::UnitTypes::None.getName()) // ignore the null node at the base
+		if (res != BWAPI::UnitTypes::None) // ignore the null node at the base
 			return res;
 	}
 	return BWAPI::UnitTypes::None; // there was only the null node for both trees
@@ -266,10 +359,13 @@ std::vector<BWAPI::UnitType> ProBot::getUnitPrereqs(BWAPI::UnitType nodeUnitType
 	return prereqs;
 }
 
-std::vector<BWAPI::UnitType> ProBot::getObtainedNodes(TechTree tree, std::vector<BWAPI::UnitType> rsf){
-	if (tree._obtained)
-		rsf.push_back(tree._unitType); // base case, if obtained add to list size 1
-	for (TechTree & sub : tree._subs) // check each child to see if the units should be added
-		rsf = getObtainedNodes(sub, rsf);
-	return rsf;
-}
\ No newline at end of file
+void ProBot::getObtainedNodes(const TechTree & tree, std::vector<BWAPI::UnitType> & result){
+	ObtainedTypeCollector collector(result);
+	traverseTree(tree, collector);
+}
+
+std::vector<BWAPI::UnitType> ProBot::getObtainedNodes(const TechTree & tree){
+	std::vector<BWAPI::UnitType> obtainedNodes;
+	getObtainedNodes(tree, obtainedNodes);
+	return obtainedNodes;
+}
@@ -45,8 +45,9 @@ namespace ProBot{
 
 		/**
 			Returns the TechTree associated with a race, where each node is initialized with obtained = false. 
+			The trees are expanded from the races' constant definitions (see TechTreeData.h) once, on the first call.
 		*/
-		TechTree getBaseTree(BWAPI::Race);
+		const TechTree & getBaseTree(BWAPI::Race);
 		/**
 			Returns a reference to the node representation of a given unit type in a tree.
 			@param nodeUnitType - the unit type to search for
@@ -139,28 +140,45 @@ namespace ProBot{
 			@return true if successful in removing node, false otherwise
 		*/
 		bool removeNode(TechTree * node, TechTree & tree);
+		/**
+			Appends the leaf nodes of a tree to the result, in pre-order.
+			Leaf nodes are nodes that do not have subs.
+			@param tree - the tree in which the nodes exist
+			@param result - the buffer that the found nodes are appended to
+		*/
+		void findLeafNodes(const TechTree & tree, std::vector<const TechTree*> & result);
 		/**
 			Returns a list of leaf nodes.
 			Leaf nodes are nodes that do not have subs.
 			@param tree - the tree in which the nodes exist
-			@param resultSoFar - an accumulator used to store temporary result in recursive calls
 			@param return the list of found leaf nodes.
 		*/
-		std::vector<TechTree> findLeafNodes(TechTree tree, std::vector<TechTree> resultSoFar = std::vector<TechTree>());
+		std::vector<TechTree> findLeafNodes(const TechTree & tree);
+		/**
+			Appends the obtained leaf nodes of a tree that are not building units to the result.
+			@param tree - the tree in which the nodes exist
+			@param result - the buffer that the found nodes are appended to
+		*/
+		void findNonBuildingLeafNodes(const TechTree & tree, std::vector<const TechTree*> & result);
 		/**
 			Returns a list of leaf nodes that are not building units.
 			Leaf nodes are nodes that do not have subs.
 			@param tree - the tree in which the nodes exist
 			@param return the list of found non-building leaf nodes.
 		*/
-		std::vector<TechTree> findNonBuildingLeafNodes(TechTree tree);
+		std::vector<TechTree> findNonBuildingLeafNodes(const TechTree & tree);
+		/**
+			Appends the nodes that are children of obtained nodes, but are not themselves obtained, to the result.
+			@param tree - the tree in which the nodes exist
+			@param result - the buffer that the found nodes are appended to
+		*/
+		void findNextObtainableNodes(const TechTree & tree, std::vector<const TechTree*> & result);
 		/**
 			Returns a list of nodes that are children of obtained nodes, but are not themselves obtained.
 			@param tree - the tree in which the nodes exist
-			@param resultSoFar - an accumulator used to store temporary result in recursive calls
 			@param return the list of found next obtainable nodes
 		*/
-		std::vector<TechTree> findNextObtainableNodes(TechTree tree, std::vector<TechTree> resultSoFar = std::vector<TechTree>());
+		std::vector<TechTree> findNextObtainableNodes(const TechTree & tree);
 		/**
 			Returns the first found unit type that is obtained in one tree but not the other.
 			ASSUMPTION: both trees are the same base tree.
@@ -168,7 +186,7 @@ namespace ProBot{
 			@param tree2 - the second tech tree
 			@param return the unit type with different obtained value in the two trees
 		*/
-		BWAPI::UnitType getFirstDifference(TechTree tree1, TechTree tree2);
+		BWAPI::UnitType getFirstDifference(const TechTree & tree1, const TechTree & tree2);
 		/**
 			Returns a list of pre-requisite nodes that form a path to reach the node representing the given unit type.
 			@param nodeUnitType - the unit type to search for
@@ -181,131 +199,12 @@ namespace ProBot{
 			Returns pre-requisite nodes and removes the highest level null node for each tree.
 		*/
 		std::vector<BWAPI::UnitType> getUnitPrereqs(BWAPI::UnitType, TechTree);
+		/**
+			Appends the unit types of all nodes with obtained property set to true to the result.
+		*/
+		void getObtainedNodes(const TechTree & tree, std::vector<BWAPI::UnitType> & result);
 		/**
 			Returns all nodes with obtained property set to true.
 		*/
-		std::vector<BWAPI::UnitType> getObtainedNodes(TechTree, std::vector<BWAPI::UnitType> = std::vector<BWAPI::UnitType>());
-
-		// CONSTANTS
-		// PROTOSS TECH TREE
-		const TechTree PROTOSS_ROBOTICS_FACILITY{
-			Protoss_Robotics_Facility, {
-				TechTree{ Protoss_Robotics_Support_Bay, { TechTree{ Protoss_Reaver } } },
-				TechTree{ Protoss_Observatory, { TechTree{ Protoss_Observer } } },
-				TechTree{ Protoss_Shuttle } }
-		};
-
-		const TechTree PROTOSS_STARGATE{
-			Protoss_Stargate, false, false, {
-				TechTree{ Protoss_Fleet_Beacon, {
-					TechTree{ Protoss_Citadel_of_Adun, {
-						TechTree{ Protoss_Templar_Archives, {
-							TechTree{ Protoss_High_Templar },
-							TechTree{ Protoss_Dark_Templar },
-							TechTree{ Protoss_Archon },
-							TechTree{ Protoss_Dark_Archon },
-							TechTree{ Protoss_Arbiter_Tribunal, {
-								TechTree{ Protoss_Arbiter } }
-							}
-						} } } },
-						TechTree{ Protoss_Carrier } } },
-				TechTree{Protoss_Scout},
-				TechTree{Protoss_Corsair}
-			}
-		};
-
-		const TechTree PROTOSS_CITADEL_OF_ADUN{
-			Protoss_Citadel_of_Adun, false, false, {
-				TechTree{ Protoss_Templar_Archives, {
-					TechTree{ Protoss_High_Templar },
-					TechTree{ Protoss_Dark_Templar },
-					TechTree{ Protoss_Archon },
-					TechTree{ Protoss_Dark_Archon },
-					TechTree{ Protoss_Stargate, {
-						TechTree{ Protoss_Fleet_Beacon, {
-							TechTree{ Protoss_Carrier } } },
-							TechTree{ Protoss_Arbiter_Tribunal, {
-								TechTree{ Protoss_Arbiter } } },
-								TechTree{ Protoss_Scout },
-								TechTree{ Protoss_Corsair }
-					} } } } }
-		};
-
-		const TechTree PROTOSS_TREE{
-			BWAPI::UnitTypes::None, {
-				TechTree{ Protoss_Nexus, {
-					TechTree{ Protoss_Gateway, {
-						TechTree{ Protoss_Cybernetics_Core, {
-							TechTree{ Protoss_Dragoon }, PROTOSS_ROBOTICS_FACILITY, PROTOSS_STARGATE, PROTOSS_CITADEL_OF_ADUN
-						} }
-						, TechTree{ Protoss_Zealot }
-						, TechTree{ Protoss_Shield_Battery }
-					} }
-					, TechTree{ Protoss_Forge, { TechTree{ Protoss_Photon_Cannon } } }
-					, TechTree{ Protoss_Probe }
-				} },
-				TechTree{ Protoss_Pylon },
-				TechTree{ Protoss_Assimilator }
-			}
-		};
-
-		// TERRAN TECH TREE
-		const TechTree TERRAN_STARPORT{
-			Terran_Starport, {
-				TechTree{ Terran_Science_Facility, { TechTree{ Terran_Physics_Lab }, TechTree{Terran_Covert_Ops} } },
-				TechTree{ Terran_Control_Tower, { TechTree{ Terran_Dropship }, TechTree{ Terran_Armory, { TechTree{ Terran_Valkyrie } } } } },
-				TechTree{ Terran_Wraith}
-			}
-		};
-
-		const TechTree TERRAN_ACADEMY{
-			Terran_Academy, { TechTree{ Terran_Firebat }, TechTree{ Terran_Medic }, TechTree{ Terran_Comsat_Station }}
-		};
-
-		const TechTree TERRAN_ARMORY{
-			Terran_Armory, { TechTree{ Terran_Goliath }, TechTree{ Terran_Starport, {
-				TechTree{ Terran_Science_Facility, { TechTree{ Terran_Physics_Lab }, TechTree{ Terran_Covert_Ops } } },
-				TechTree{ Terran_Control_Tower, { TechTree{ Terran_Dropship } } },
-				TechTree{ Terran_Wraith } } } }
-		};
-
-		const TechTree TERRAN_TREE{
-			BWAPI::UnitTypes::None, {
-				TechTree{ Terran_Command_Center, {
-					TechTree{ Terran_Barracks, {
-						TechTree{ Terran_Factory, {
-							TERRAN_STARPORT, TERRAN_ARMORY,
-							TechTree{ Terran_Vulture }
-						} }
-						, TechTree{ Terran_Bunker }
-						, TERRAN_ACADEMY
-						, TechTree{ Terran_Marine }
-					} }
-					, TechTree{ Terran_Engineering_Bay, { TechTree{ Terran_Missile_Turret } } }
-					, TechTree{ Terran_SCV }
-				} },
-				TechTree{ Terran_Supply_Depot },
-				TechTree{ Terran_Refinery }
-			}
-		};
-
-		// @TODO
-		// ZERG TECH TREE
-		const TechTree ZERG_TREE{
-			BWAPI::UnitTypes::None, {
-				TechTree{ Protoss_Nexus, {
-					TechTree{ Protoss_Gateway, {
-						TechTree{ Protoss_Cybernetics_Core, {
-							TechTree{ Protoss_Dragoon }, PROTOSS_ROBOTICS_FACILITY, PROTOSS_STARGATE, PROTOSS_CITADEL_OF_ADUN
-						} }
-						, TechTree{ Protoss_Zealot }
-						, TechTree{ Protoss_Shield_Battery }
-					} }
-					, TechTree{ Protoss_Forge, { TechTree{ Protoss_Photon_Cannon } } }
-					, TechTree{ Protoss_Probe }
-				} },
-				TechTree{ Protoss_Pylon },
-				TechTree{ Protoss_Assimilator }
-			}
-		};
+		std::vector<BWAPI::UnitType> getObtainedNodes(const TechTree & tree);
 	}
\ No newline at end of file
@@ -0,0 +1,122 @@
+/**
+	TechTreeData.cpp
+	Constant, flattened definitions of the race tech trees.
+	Nodes are listed in pre-order with the index of their parent, the slot number of each node is given in the comment.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "TechTreeData.h"
+
+using namespace ProBot;
+using namespace BWAPI::UnitTypes;
+
+// PROTOSS TECH TREE
+static const TechNodeDef PROTOSS_NODES[] = {
+	/*  0 */ { Enum::None, true, NULL_PARENT },
+	/*  1 */ { Enum::Protoss_Nexus, true, 0 },
+	/*  2 */ { Enum::Protoss_Gateway, true, 1 },
+	/*  3 */ { Enum::Protoss_Cybernetics_Core, true, 2 },
+	/*  4 */ { Enum::Protoss_Dragoon, true, 3 },
+	/*  5 */ { Enum::Protoss_Robotics_Facility, true, 3 },
+	/*  6 */ { Enum::Protoss_Robotics_Support_Bay, true, 5 },
+	/*  7 */ { Enum::Protoss_Reaver, true, 6 },
+	/*  8 */ { Enum::Protoss_Observatory, true, 5 },
+	/*  9 */ { Enum::Protoss_Observer, true, 8 },
+	/* 10 */ { Enum::Protoss_Shuttle, true, 5 },
+	/* 11 */ { Enum::Protoss_Stargate, false, 3 },
+	/* 12 */ { Enum::Protoss_Fleet_Beacon, true, 11 },
+	/* 13 */ { Enum::Protoss_Citadel_of_Adun, true, 12 },
+	/* 14 */ { Enum::Protoss_Templar_Archives, true, 13 },
+	/* 15 */ { Enum::Protoss_High_Templar, true, 14 },
+	/* 16 */ { Enum::Protoss_Dark_Templar, true, 14 },
+	/* 17 */ { Enum::Protoss_Archon, true, 14 },
+	/* 18 */ { Enum::Protoss_Dark_Archon, true, 14 },
+	/* 19 */ { Enum::Protoss_Arbiter_Tribunal, true, 14 },
+	/* 20 */ { Enum::Protoss_Arbiter, true, 19 },
+	/* 21 */ { Enum::Protoss_Carrier, true, 12 },
+	/* 22 */ { Enum::Protoss_Scout, true, 11 },
+	/* 23 */ { Enum::Protoss_Corsair, true, 11 },
+	/* 24 */ { Enum::Protoss_Citadel_of_Adun, false, 3 },
+	/* 25 */ { Enum::Protoss_Templar_Archives, true, 24 },
+	/* 26 */ { Enum::Protoss_High_Templar, true, 25 },
+	/* 27 */ { Enum::Protoss_Dark_Templar, true, 25 },
+	/* 28 */ { Enum::Protoss_Archon, true, 25 },
+	/* 29 */ { Enum::Protoss_Dark_Archon, true, 25 },
+	/* 30 */ { Enum::Protoss_Stargate, true, 25 },
+	/* 31 */ { Enum::Protoss_Fleet_Beacon, true, 30 },
+	/* 32 */ { Enum::Protoss_Carrier, true, 31 },
+	/* 33 */ { Enum::Protoss_Arbiter_Tribunal, true, 30 },
+	/* 34 */ { Enum::Protoss_Arbiter, true, 33 },
+	/* 35 */ { Enum::Protoss_Scout, true, 30 },
+	/* 36 */ { Enum::Protoss_Corsair, true, 30 },
+	/* 37 */ { Enum::Protoss_Zealot, true, 2 },
+	/* 38 */ { Enum::Protoss_Shield_Battery, true, 2 },
+	/* 39 */ { Enum::Protoss_Forge, true, 1 },
+	/* 40 */ { Enum::Protoss_Photon_Cannon, true, 39 },
+	/* 41 */ { Enum::Protoss_Probe, true, 1 },
+	/* 42 */ { Enum::Protoss_Pylon, true, 0 },
+	/* 43 */ { Enum::Protoss_Assimilator, true, 0 },
+};
+
+// TERRAN TECH TREE
+static const TechNodeDef TERRAN_NODES[] = {
+	/*  0 */ { Enum::None, true, NULL_PARENT },
+	/*  1 */ { Enum::Terran_Command_Center, true, 0 },
+	/*  2 */ { Enum::Terran_Barracks, true, 1 },
+	/*  3 */ { Enum::Terran_Factory, true, 2 },
+	/*  4 */ { Enum::Terran_Starport, true, 3 },
+	/*  5 */ { Enum::Terran_Science_Facility, true, 4 },
+	/*  6 */ { Enum::Terran_Physics_Lab, true, 5 },
+	/*  7 */ { Enum::Terran_Covert_Ops, true, 5 },
+	/*  8 */ { Enum::Terran_Control_Tower, true, 4 },
+	/*  9 */ { Enum::Terran_Dropship, true, 8 },
+	/* 10 */ { Enum::Terran_Armory, true, 8 },
+	/* 11 */ { Enum::Terran_Valkyrie, true, 10 },
+	/* 12 */ { Enum::Terran_Wraith, true, 4 },
+	/* 13 */ { Enum::Terran_Armory, true, 3 },
+	/* 14 */ { Enum::Terran_Goliath, true, 13 },
+	/* 15 */ { Enum::Terran_Starport, true, 13 },
+	/* 16 */ { Enum::Terran_Science_Facility, true, 15 },
+	/* 17 */ { Enum::Terran_Physics_Lab, true, 16 },
+	/* 18 */ { Enum::Terran_Covert_Ops, true, 16 },
+	/* 19 */ { Enum::Terran_Control_Tower, true, 15 },
+	/* 20 */ { Enum::Terran_Dropship, true, 19 },
+	/* 21 */ { Enum::Terran_Wraith, true, 15 },
+	/* 22 */ { Enum::Terran_Vulture, true, 3 },
+	/* 23 */ { Enum::Terran_Bunker, true, 2 },
+	/* 24 */ { Enum::Terran_Academy, true, 2 },
+	/* 25 */ { Enum::Terran_Firebat, true, 24 },
+	/* 26 */ { Enum::Terran_Medic, true, 24 },
+	/* 27 */ { Enum::Terran_Comsat_Station, true, 24 },
+	/* 28 */ { Enum::Terran_Marine, true, 2 },
+	/* 29 */ { Enum::Terran_Engineering_Bay, true, 1 },
+	/* 30 */ { Enum::Terran_Missile_Turret, true, 29 },
+	/* 31 */ { Enum::Terran_SCV, true, 1 },
+	/* 32 */ { Enum::Terran_Supply_Depot, true, 0 },
+	/* 33 */ { Enum::Terran_Refinery, true, 0 },
+};
+
+// @TODO
+// ZERG TECH TREE (uses the protoss tree until the zerg tree is written)
+
+const TechTreeDef ProBot::PROTOSS_TREE = { PROTOSS_NODES, sizeof(PROTOSS_NODES) / sizeof(PROTOSS_NODES[0]) };
+const TechTreeDef ProBot::TERRAN_TREE = { TERRAN_NODES, sizeof(TERRAN_NODES) / sizeof(TERRAN_NODES[0]) };
+const TechTreeDef ProBot::ZERG_TREE = { PROTOSS_NODES, sizeof(PROTOSS_NODES) / sizeof(PROTOSS_NODES[0]) };
+const TechTreeDef ProBot::EMPTY_TREE = { NULL, 0 };
+
+const TechTreeDef & ProBot::getTreeDef(BWAPI::Race race){
+	if (race == BWAPI::Races::Protoss){
+		return PROTOSS_TREE;
+	}
+	else if (race == BWAPI::Races::Terran){
+		return TERRAN_TREE;
+	}
+	else if (race == BWAPI::Races::Zerg){
+		return ZERG_TREE;
+	}
+	else {
+		return EMPTY_TREE;
+	}
+}
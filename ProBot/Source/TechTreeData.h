@@ -0,0 +1,46 @@
+/**
+	TechTreeData.h
+	Constant, flattened definitions of the race tech trees.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+#include <BWAPI.h>
+
+namespace ProBot{
+	// parent value of the root node of a tree definition
+	const short NULL_PARENT = -1;
+
+	/**
+		A single node of a tree definition. Plain data, so that the tables are built by the compiler rather than at load time.
+	*/
+	struct TechNodeDef {
+		BWAPI::UnitTypes::Enum::Enum _unitType;
+		bool _isUnique;
+		// index of the parent node; parents always come before their children (pre-order)
+		short _parent;
+	};
+
+	/**
+		A tech tree definition: its nodes in pre-order, with the root at index 0.
+	*/
+	struct TechTreeDef {
+		const TechNodeDef * _nodes;
+		int _size;
+	};
+
+	// RACE TECH TREES
+	extern const TechTreeDef PROTOSS_TREE;
+	extern const TechTreeDef TERRAN_TREE;
+	extern const TechTreeDef ZERG_TREE;
+	// definition with no nodes, used for unknown races
+	extern const TechTreeDef EMPTY_TREE;
+
+	/**
+		Returns the tree definition associated with a race, or EMPTY_TREE if the race has none.
+	*/
+	const TechTreeDef & getTreeDef(BWAPI::Race race);
+}
@@ -0,0 +1,445 @@
+/**
+	TechTreeStore.cpp
+	Compact, index-addressed storage for a tech tree.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "TechTreeStore.h"
+#include <mutex>
+
+using namespace ProBot;
+
+// the store of each race's tree definition, built once (see initBaseTreeStores)
+static std::once_flag baseTreeStoresInitialized;
+static TechTreeStore protossBaseStore;
+static TechTreeStore terranBaseStore;
+static TechTreeStore zergBaseStore;
+static const TechTreeStore emptyBaseStore;
+
+/**
+	Returns the bits of the slots from first up to (but not including) end.
+*/
+static tech_mask_t slotRangeMask(tech_slot_t first, tech_slot_t end){
+	tech_mask_t endMask = (end >= MAX_TECH_NODES) ? 0 : slotBit(end);
+	return endMask - slotBit(first);
+}
+
+TechTreeStore::TechTreeStore(){
+	_size = 0;
+	std::fill(_slotOfType, _slotOfType + NUM_UNIT_TYPES, NULL_SLOT);
+	_unitLeafMask = 0;
+	_obtainedMask = 0;
+	_removedMask = 0;
+}
+
+TechTreeStore::TechTreeStore(const TechTree & tree){
+	_size = 0;
+	std::fill(_slotOfType, _slotOfType + NUM_UNIT_TYPES, NULL_SLOT);
+	_obtainedMask = 0;
+	_removedMask = 0;
+	addNode(tree, NULL_SLOT);
+	buildMasks();
+}
+
+TechTreeStore::TechTreeStore(const TechTreeDef & tree){
+	_size = 0;
+	std::fill(_slotOfType, _slotOfType + NUM_UNIT_TYPES, NULL_SLOT);
+	_obtainedMask = 0;
+	_removedMask = 0;
+	// the definition is already in pre-order, so the nodes keep their indices as slots
+	for (int i = 0; i < tree._size; i++){
+		if (appendNode(tree._nodes[i]._unitType, tree._nodes[i]._isUnique, tree._nodes[i]._parent) == NULL_SLOT)
+			break;
+	}
+	buildMasks();
+}
+
+tech_slot_t TechTreeStore::appendNode(BWAPI::UnitType unitType, bool isUnique, tech_slot_t parent){
+	if (_size >= MAX_TECH_NODES) // tree definitions should never exceed the maximum size
+		return NULL_SLOT;
+
+	tech_slot_t slot = static_cast<tech_slot_t>(_size++);
+	TechNode & node = _nodes[slot];
+	node._unitType = unitType;
+	node._isUnique = isUnique;
+	node._parent = parent;
+	node._firstChild = NULL_SLOT;
+	node._nextSibling = NULL_SLOT;
+	node._nextOfType = NULL_SLOT;
+
+	// append to the end of the chain of slots with the same unit type, so that chains follow pre-order
+	tech_slot_t & typeHead = _slotOfType[unitType.getID()];
+	if (typeHead == NULL_SLOT){
+		typeHead = slot;
+	}
+	else {
+		tech_slot_t last = typeHead;
+		while (_nodes[last]._nextOfType != NULL_SLOT)
+			last = _nodes[last]._nextOfType;
+		_nodes[last]._nextOfType = slot;
+	}
+
+	// append to the end of the parent's children, so that siblings keep their order
+	if (parent != NULL_SLOT){
+		if (_nodes[parent]._firstChild == NULL_SLOT){
+			_nodes[parent]._firstChild = slot;
+		}
+		else {
+			tech_slot_t last = _nodes[parent]._firstChild;
+			while (_nodes[last]._nextSibling != NULL_SLOT)
+				last = _nodes[last]._nextSibling;
+			_nodes[last]._nextSibling = slot;
+		}
+	}
+	return slot;
+}
+
+tech_slot_t TechTreeStore::addNode(const TechTree & tree, tech_slot_t parent){
+	tech_slot_t slot = appendNode(tree._unitType, tree._isUnique, parent);
+	if (slot == NULL_SLOT)
+		return NULL_SLOT;
+	if (tree._obtained)
+		_obtainedMask |= slotBit(slot);
+	for (const TechTree & sub : tree._subs){
+		if (addNode(sub, slot) == NULL_SLOT)
+			break;
+	}
+	return slot;
+}
+
+void TechTreeStore::buildMasks(){
+	// a subtree ends where the subtree of its last descendant ends, so walk up from the back
+	for (tech_slot_t slot = 0; slot < _size; slot++)
+		_nodes[slot]._subtreeEnd = static_cast<tech_slot_t>(slot + 1);
+	for (tech_slot_t slot = static_cast<tech_slot_t>(_size - 1); slot > 0; slot--){
+		tech_slot_t parent = _nodes[slot]._parent;
+		if (parent != NULL_SLOT && _nodes[parent]._subtreeEnd < _nodes[slot]._subtreeEnd)
+			_nodes[parent]._subtreeEnd = _nodes[slot]._subtreeEnd;
+	}
+
+	_unitLeafMask = 0;
+	for (tech_slot_t slot = 0; slot < _size; slot++){
+		const TechNode & node = _nodes[slot];
+		// parents precede their children, so the parent's ancestors are already known
+		_ancestorMask[slot] = (node._parent == NULL_SLOT) ? 0 : (_ancestorMask[node._parent] | slotBit(node._parent));
+		_moveMask[slot] = slotBit(slot);
+		for (tech_slot_t child = node._firstChild; child != NULL_SLOT; child = _nodes[child]._nextSibling){
+			if (!_nodes[child]._unitType.isBuilding())
+				_moveMask[slot] |= slotBit(child);
+		}
+		_sameTypeMask[slot] = 0;
+		for (tech_slot_t other = _slotOfType[node._unitType.getID()]; other != NULL_SLOT; other = _nodes[other]._nextOfType){
+			if (other != slot)
+				_sameTypeMask[slot] |= slotBit(other);
+		}
+		if (node._firstChild == NULL_SLOT && !node._unitType.isBuilding())
+			_unitLeafMask |= slotBit(slot);
+	}
+}
+
+void TechTreeStore::unlinkNode(tech_slot_t slot){
+	tech_slot_t parent = _nodes[slot]._parent;
+	if (parent == NULL_SLOT)
+		return;
+	if (_nodes[parent]._firstChild == slot){
+		_nodes[parent]._firstChild = _nodes[slot]._nextSibling;
+		return;
+	}
+	// find the previous sibling and skip over the node
+	for (tech_slot_t child = _nodes[parent]._firstChild; child != NULL_SLOT; child = _nodes[child]._nextSibling){
+		if (_nodes[child]._nextSibling == slot){
+			_nodes[child]._nextSibling = _nodes[slot]._nextSibling;
+			return;
+		}
+	}
+}
+
+bool TechTreeStore::isEmpty() const{
+	return _size == 0;
+}
+
+int TechTreeStore::size() const{
+	return _size;
+}
+
+tech_slot_t TechTreeStore::getRoot() const{
+	return isEmpty() ? NULL_SLOT : 0;
+}
+
+TechNode & TechTreeStore::operator[](tech_slot_t slot){
+	return _nodes[slot];
+}
+
+const TechNode & TechTreeStore::operator[](tech_slot_t slot) const{
+	return _nodes[slot];
+}
+
+bool TechTreeStore::isObtained(tech_slot_t slot) const{
+	return (_obtainedMask & slotBit(slot)) != 0;
+}
+
+bool TechTreeStore::isRemoved(tech_slot_t slot) const{
+	return (_removedMask & slotBit(slot)) != 0;
+}
+
+bool TechTreeStore::isReachable(tech_slot_t slot) const{
+	return (_ancestorMask[slot] & ~_obtainedMask) == 0;
+}
+
+bool TechTreeStore::isParentObtained(BWAPI::UnitType nodeUnitType) const{
+	tech_slot_t parent = getImmediateParent(nodeUnitType);
+	return parent != NULL_SLOT && isObtained(parent);
+}
+
+tech_slot_t TechTreeStore::findNode(BWAPI::UnitType nodeUnitType, bool ignoreUnobtained) const{
+	if (!nodeUnitType.isValid())
+		return NULL_SLOT;
+	// look up the first slot of the unit type and follow the chain for non-unique nodes
+	for (tech_slot_t slot = _slotOfType[nodeUnitType.getID()]; slot != NULL_SLOT; slot = _nodes[slot]._nextOfType){
+		if (isRemoved(slot))
+			continue;
+		if (!ignoreUnobtained || isReachable(slot))
+			return slot;
+	}
+	return NULL_SLOT;
+}
+
+tech_slot_t TechTreeStore::getImmediateParent(BWAPI::UnitType nodeUnitType, bool ignoreUnobtained) const{
+	if (!nodeUnitType.isValid())
+		return NULL_SLOT;
+	for (tech_slot_t slot = _slotOfType[nodeUnitType.getID()]; slot != NULL_SLOT; slot = _nodes[slot]._nextOfType){
+		tech_slot_t parent = _nodes[slot]._parent;
+		if (isRemoved(slot) || parent == NULL_SLOT)
+			continue;
+		if (!ignoreUnobtained || (isObtained(parent) && isReachable(parent)))
+			return parent;
+	}
+	return NULL_SLOT;
+}
+
+bool TechTreeStore::setNodeObtained(BWAPI::UnitType nodeUnitType, bool obtained){
+	return setNodeObtained(findNode(nodeUnitType), obtained);
+}
+
+bool TechTreeStore::setNodeObtained(tech_slot_t slot, bool obtained){
+	if (slot == NULL_SLOT || slot >= _size)
+		return false;
+	if (obtained)
+		_obtainedMask |= slotBit(slot);
+	else
+		_obtainedMask &= ~slotBit(slot);
+	return true;
+}
+
+bool TechTreeStore::setBuildingNodeObtained(BWAPI::UnitType nodeBuildingUnitType, bool obtained){
+	tech_slot_t slot = NULL_SLOT;
+	if (obtained){
+		// only nodes whose prereqs are obtained can be obtained
+		slot = findNode(nodeBuildingUnitType, true);
+	}
+	else if (nodeBuildingUnitType.isValid()) {
+		// prefer the copy that is actually obtained, so that undoing a move undoes the same node
+		for (tech_slot_t s = _slotOfType[nodeBuildingUnitType.getID()]; s != NULL_SLOT; s = _nodes[s]._nextOfType){
+			if (!isRemoved(s) && (slot == NULL_SLOT || isObtained(s))){
+				slot = s;
+				if (isObtained(s))
+					break;
+			}
+		}
+	}
+	// make sure that the node was found
+	if (slot == NULL_SLOT)
+		return false;
+
+	if (!_nodes[slot]._isUnique){
+		// the obtained value is set first, so that the node itself isn't the copy that gets removed
+		setNodeObtained(slot, obtained);
+		removeNode(nodeBuildingUnitType, !obtained);
+	}
+
+	// the node and its non-building children
+	if (obtained)
+		_obtainedMask |= _moveMask[slot];
+	else
+		_obtainedMask &= ~_moveMask[slot];
+	return true;
+}
+
+bool TechTreeStore::setPrereqsObtained(BWAPI::UnitType nodeUnitType, bool obtained){
+	tech_slot_t slot = findNode(nodeUnitType);
+	if (slot == NULL_SLOT)
+		return false;
+	if (obtained)
+		_obtainedMask |= _ancestorMask[slot];
+	else
+		_obtainedMask &= ~_ancestorMask[slot];
+	return true;
+}
+
+bool TechTreeStore::removeNode(BWAPI::UnitType nodeUnitType, bool obtained){
+	if (!nodeUnitType.isValid())
+		return false;
+	for (tech_slot_t slot = _slotOfType[nodeUnitType.getID()]; slot != NULL_SLOT; slot = _nodes[slot]._nextOfType){
+		// the root node can't be removed
+		if (!isRemoved(slot) && _nodes[slot]._parent != NULL_SLOT && isObtained(slot) == obtained)
+			return removeNode(slot);
+	}
+	return false;
+}
+
+bool TechTreeStore::removeNode(tech_slot_t slot){
+	if (slot == NULL_SLOT || slot >= _size || isRemoved(slot) || _nodes[slot]._parent == NULL_SLOT)
+		return false;
+	unlinkNode(slot);
+	// the subtree of a node is the contiguous range of slots that follows it
+	tech_mask_t removed = slotRangeMask(slot, _nodes[slot]._subtreeEnd);
+	_removedMask |= removed;
+	// the removed nodes are no longer leaves, and a parent left without children becomes one
+	_unitLeafMask &= ~removed;
+	tech_slot_t parent = _nodes[slot]._parent;
+	if (_nodes[parent]._firstChild == NULL_SLOT && !_nodes[parent]._unitType.isBuilding())
+		_unitLeafMask |= slotBit(parent);
+	return true;
+}
+
+std::vector<BWAPI::UnitType> TechTreeStore::findPrereqNodes(BWAPI::UnitType nodeUnitType) const{
+	std::vector<BWAPI::UnitType> path;
+	tech_slot_t slot = findNode(nodeUnitType);
+	if (slot == NULL_SLOT)
+		return path;
+	// ancestors come before their descendants in pre-order, so the bits are already in order from the root
+	tech_mask_t ancestors = _ancestorMask[slot];
+	for (tech_slot_t ancestor = 0; ancestors != 0; ancestor++, ancestors >>= 1){
+		if (ancestors & 1)
+			path.push_back(_nodes[ancestor]._unitType);
+	}
+	return path;
+}
+
+std::vector<BWAPI::UnitType> TechTreeStore::getUnitPrereqs(BWAPI::UnitType nodeUnitType) const{
+	std::vector<BWAPI::UnitType> prereqs;
+	tech_mask_t prereqMask = getPrereqMask(nodeUnitType);
+	for (tech_slot_t prereq = 0; prereqMask != 0; prereq++, prereqMask >>= 1){
+		if (prereqMask & 1)
+			prereqs.push_back(_nodes[prereq]._unitType);
+	}
+	return prereqs;
+}
+
+tech_mask_t TechTreeStore::getPrereqMask(BWAPI::UnitType nodeUnitType) const{
+	tech_slot_t slot = findNode(nodeUnitType);
+	if (slot == NULL_SLOT)
+		return 0;
+	// get rid of the null node at the root
+	return _ancestorMask[slot] & ~slotBit(getRoot());
+}
+
+void TechTreeStore::findNextObtainableNodes(std::vector<tech_slot_t> & result) const{
+	// expanded[i] is true if node i is visited by a depth-first search that only descends through obtained nodes
+	bool expanded[MAX_TECH_NODES];
+	for (tech_slot_t slot = 0; slot < _size; slot++){
+		const TechNode & node = _nodes[slot];
+		expanded[slot] = false;
+		if (isRemoved(slot))
+			continue;
+		// parents always precede their children in pre-order, so the parent's flag is already known
+		bool visited = (node._parent == NULL_SLOT) || expanded[node._parent];
+		if (!visited)
+			continue;
+		if (!isObtained(slot))
+			result.push_back(slot);
+		else
+			expanded[slot] = true;
+	}
+}
+
+void TechTreeStore::findNonBuildingLeafNodes(std::vector<tech_slot_t> & result) const{
+	for (tech_slot_t slot = 0; slot < _size; slot++){
+		const TechNode & node = _nodes[slot];
+		if (!isRemoved(slot) && isObtained(slot) && node._firstChild == NULL_SLOT && !node._unitType.isBuilding())
+			result.push_back(slot);
+	}
+}
+
+std::vector<BWAPI::UnitType> TechTreeStore::getObtainedNodes() const{
+	std::vector<BWAPI::UnitType> obtainedNodes;
+	for (tech_slot_t slot = 0; slot < _size; slot++){
+		if (!isRemoved(slot) && isObtained(slot))
+			obtainedNodes.push_back(_nodes[slot]._unitType);
+	}
+	return obtainedNodes;
+}
+
+BWAPI::UnitType ProBot::getFirstDifference(const TechTreeStore & tree1, const TechTreeStore & tree2){
+	int size = std::min(tree1.size(), tree2.size());
+	for (tech_slot_t slot = 0; slot < size; slot++){
+		// if the two obtained values are different, then return the unit type (ignoring the null node at the base)
+		if (tree1.isObtained(slot) != tree2.isObtained(slot) && tree1[slot]._unitType != BWAPI::UnitTypes::None)
+			return tree1[slot]._unitType;
+	}
+	return BWAPI::UnitTypes::None;
+}
+
+bool TechTreeStore::hasSameLayout(const TechTreeStore & other) const{
+	if (_size != other._size)
+		return false;
+	for (tech_slot_t slot = 0; slot < _size; slot++){
+		if (_nodes[slot]._unitType != other._nodes[slot]._unitType || _nodes[slot]._parent != other._nodes[slot]._parent)
+			return false;
+	}
+	return true;
+}
+
+tech_mask_t TechTreeStore::getMoveMask(tech_slot_t slot) const{
+	return _moveMask[slot];
+}
+
+tech_mask_t TechTreeStore::getSameTypeMask(tech_slot_t slot) const{
+	return _sameTypeMask[slot];
+}
+
+tech_mask_t TechTreeStore::getUnitLeafMask() const{
+	return _unitLeafMask;
+}
+
+tech_mask_t TechTreeStore::getAncestorMask(tech_slot_t slot) const{
+	return _ancestorMask[slot];
+}
+
+tech_mask_t TechTreeStore::getObtainedMask() const{
+	return _obtainedMask & ~_removedMask;
+}
+
+tech_mask_t TechTreeStore::getRemovedMask() const{
+	return _removedMask;
+}
+
+namespace {
+	void buildBaseTreeStores(){
+		protossBaseStore = TechTreeStore(PROTOSS_TREE);
+		terranBaseStore = TechTreeStore(TERRAN_TREE);
+		zergBaseStore = TechTreeStore(ZERG_TREE);
+	}
+}
+
+void ProBot::initBaseTreeStores(){
+	std::call_once(baseTreeStoresInitialized, buildBaseTreeStores);
+}
+
+const TechTreeStore & ProBot::getBaseTreeStore(BWAPI::Race race){
+	initBaseTreeStores();
+	if (race == BWAPI::Races::Protoss){
+		return protossBaseStore;
+	}
+	else if (race == BWAPI::Races::Terran){
+		return terranBaseStore;
+	}
+	else if (race == BWAPI::Races::Zerg){
+		return zergBaseStore;
+	}
+	else {
+		return emptyBaseStore;
+	}
+}
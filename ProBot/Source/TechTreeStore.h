@@ -0,0 +1,238 @@
+/**
+	TechTreeStore.h
+	Compact, index-addressed storage for a tech tree.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+#include <BWAPI.h>
+#include "TechTree.h"
+#include "TechTreeData.h"
+
+namespace ProBot{
+	// index of a node within a TechTreeStore
+	typedef short tech_slot_t;
+	// set of nodes within a TechTreeStore, one bit per slot
+	typedef unsigned long long tech_mask_t;
+
+	// slot value used to represent a missing node / link
+	const tech_slot_t NULL_SLOT = -1;
+	// maximum number of nodes a single race tree may contain
+	const int MAX_TECH_NODES = 64;
+	// number of unit type IDs known to BWAPI, used to size the unit type lookup table
+	const int NUM_UNIT_TYPES = BWAPI::UnitTypes::Enum::MAX;
+
+	/**
+		Returns the mask with only the bit of the given slot set.
+	*/
+	inline tech_mask_t slotBit(tech_slot_t slot){ return 1ULL << slot; }
+
+	/**
+		A struct representing a single node in a flattened tech tree.
+		Nodes are linked by slot index rather than by nested vectors.
+		The obtained and removed state of the nodes is kept by the store, one bit per node.
+	*/
+	struct TechNode {
+		BWAPI::UnitType _unitType;
+		bool _isUnique;
+		tech_slot_t _parent;
+		tech_slot_t _firstChild;
+		tech_slot_t _nextSibling;
+		// next slot holding the same unit type (for non-unique nodes)
+		tech_slot_t _nextOfType;
+		// one past the last slot of this node's subtree (slots are stored in pre-order)
+		tech_slot_t _subtreeEnd;
+	};
+
+	/**
+		A tech tree stored as a flat node array in pre-order, with parent/first-child/next-sibling links
+		and a lookup table from unit type ID to the first slot holding that unit type.
+	*/
+	class TechTreeStore {
+		TechNode _nodes[MAX_TECH_NODES];
+		int _size;
+		tech_slot_t _slotOfType[NUM_UNIT_TYPES];
+		// bits set by obtaining each node (the node and its non-building children)
+		tech_mask_t _moveMask[MAX_TECH_NODES];
+		// bits of the other nodes sharing the unit type of each node
+		tech_mask_t _sameTypeMask[MAX_TECH_NODES];
+		// bits of the non-building leaf nodes, kept up to date as nodes are removed
+		tech_mask_t _unitLeafMask;
+		// bits of every ancestor of each node (its prereqs, including the root)
+		tech_mask_t _ancestorMask[MAX_TECH_NODES];
+		// bits of the obtained nodes, and of the removed nodes
+		tech_mask_t _obtainedMask;
+		tech_mask_t _removedMask;
+
+		/**
+			Appends a single node to the node array and links it as the last child of its parent.
+			@return the slot of the newly added node, or NULL_SLOT if the store is full
+		*/
+		tech_slot_t appendNode(BWAPI::UnitType unitType, bool isUnique, tech_slot_t parent);
+		/**
+			Appends the given tree (and its subs) to the node array in pre-order.
+			@return the slot of the newly added node
+		*/
+		tech_slot_t addNode(const TechTree & tree, tech_slot_t parent);
+		/**
+			Detaches a node from its parent's list of children.
+		*/
+		void unlinkNode(tech_slot_t slot);
+		/**
+			Precomputes the per-node masks once all nodes have been added.
+		*/
+		void buildMasks();
+
+	public:
+		/**
+			Constructs an empty store (equivalent to NULL_TREE).
+		*/
+		TechTreeStore();
+		/**
+			Flattens a tech tree into a store.
+		*/
+		explicit TechTreeStore(const TechTree & tree);
+		/**
+			Builds a store from a constant tree definition, without any allocation.
+		*/
+		explicit TechTreeStore(const TechTreeDef & tree);
+
+		bool isEmpty() const;
+		int size() const;
+		tech_slot_t getRoot() const;
+		TechNode & operator[](tech_slot_t slot);
+		const TechNode & operator[](tech_slot_t slot) const;
+
+		/**
+			Returns true if the given node is obtained / has been removed.
+		*/
+		bool isObtained(tech_slot_t slot) const;
+		bool isRemoved(tech_slot_t slot) const;
+		/**
+			Returns true if every ancestor of the given node is obtained.
+		*/
+		bool isReachable(tech_slot_t slot) const;
+		/**
+			Returns true if the parent of the node with the given unit type is obtained.
+		*/
+		bool isParentObtained(BWAPI::UnitType nodeUnitType) const;
+		/**
+			Returns the slot of a node with the given unit type.
+			@param nodeUnitType - the unit type to search for
+			@param ignoreUnobtained - only consider nodes whose ancestors are all obtained if set to true
+			@return the slot of the node, or NULL_SLOT if none exists
+		*/
+		tech_slot_t findNode(BWAPI::UnitType nodeUnitType, bool ignoreUnobtained = false) const;
+		/**
+			Returns the slot of the parent of a node with the given unit type.
+			@param nodeUnitType - the unit type whose parent we must search for
+			@param ignoreUnobtained - only consider obtained parents whose ancestors are all obtained if set to true
+			@return the slot of the parent, or NULL_SLOT if none exists
+		*/
+		tech_slot_t getImmediateParent(BWAPI::UnitType nodeUnitType, bool ignoreUnobtained = false) const;
+		/**
+			Finds the node with unit type and sets its obtained property.
+			@return true if successful in finding node and setting value, false otherwise
+		*/
+		bool setNodeObtained(BWAPI::UnitType nodeUnitType, bool obtained = true);
+		/**
+			Sets the obtained property of a specific node.
+			@return true if the slot refers to a valid node, false otherwise
+		*/
+		bool setNodeObtained(tech_slot_t slot, bool obtained = true);
+		/**
+			Finds the node with unit type and sets its and its non-building children's obtained property.
+			Any other nodes of a non-unique unit type that no longer apply are removed.
+			@return true if successful in finding node and setting value, false otherwise
+		*/
+		bool setBuildingNodeObtained(BWAPI::UnitType nodeBuildingUnitType, bool obtained = true);
+		/**
+			Finds the node with unit type and sets the obtained property of each of its prereqs.
+			@return true if successful in finding node and setting value, false otherwise
+		*/
+		bool setPrereqsObtained(BWAPI::UnitType nodeUnitType, bool obtained = true);
+		/**
+			Removes the first node of the given unit type with the given obtained value.
+			@return true if successful in removing node, false otherwise
+		*/
+		bool removeNode(BWAPI::UnitType nodeUnitType, bool obtained = true);
+		/**
+			Removes a specific node (and its subtree) from the tree.
+			@return true if successful in removing node, false otherwise
+		*/
+		bool removeNode(tech_slot_t slot);
+
+		/**
+			Returns the unit types that form a path from the root to the parent of the given unit type.
+		*/
+		std::vector<BWAPI::UnitType> findPrereqNodes(BWAPI::UnitType nodeUnitType) const;
+		/**
+			Returns pre-requisite nodes without the null node at the root of the tree.
+		*/
+		std::vector<BWAPI::UnitType> getUnitPrereqs(BWAPI::UnitType nodeUnitType) const;
+		/**
+			Returns the bits of the pre-requisite nodes of the given unit type (not including the root), or 0 if it isn't in the tree.
+		*/
+		tech_mask_t getPrereqMask(BWAPI::UnitType nodeUnitType) const;
+		/**
+			Appends nodes that are children of obtained nodes, but are not themselves obtained.
+		*/
+		void findNextObtainableNodes(std::vector<tech_slot_t> & result) const;
+		/**
+			Appends obtained leaf nodes that are not building units.
+		*/
+		void findNonBuildingLeafNodes(std::vector<tech_slot_t> & result) const;
+		/**
+			Returns all unit types with obtained property set to true.
+		*/
+		std::vector<BWAPI::UnitType> getObtainedNodes() const;
+
+		/**
+			Returns true if both stores hold the same nodes in the same slots (ignoring obtained / removed state).
+		*/
+		bool hasSameLayout(const TechTreeStore & other) const;
+		/**
+			Returns the bits set when the given node is obtained: the node itself and its non-building children.
+		*/
+		tech_mask_t getMoveMask(tech_slot_t slot) const;
+		/**
+			Returns the bits of all other nodes with the same unit type as the given node.
+		*/
+		tech_mask_t getSameTypeMask(tech_slot_t slot) const;
+		/**
+			Returns the bits of all non-building leaf nodes that haven't been removed.
+		*/
+		tech_mask_t getUnitLeafMask() const;
+		/**
+			Returns the bits of all ancestors of the given node, from the root down to its parent.
+		*/
+		tech_mask_t getAncestorMask(tech_slot_t slot) const;
+		/**
+			Returns the obtained property of every node that hasn't been removed, packed into a mask.
+		*/
+		tech_mask_t getObtainedMask() const;
+		/**
+			Returns the bits of all removed nodes.
+		*/
+		tech_mask_t getRemovedMask() const;
+	};
+
+	/**
+		Returns the first found unit type that is obtained in one store but not the other.
+		ASSUMPTION: both stores were built from the same base tree.
+	*/
+	BWAPI::UnitType getFirstDifference(const TechTreeStore & tree1, const TechTreeStore & tree2);
+
+	/**
+		Builds the store of each race's tree definition, so that setting up a tree is only a copy.
+		Only does work the first time it is called; it's safe to call from several threads at once.
+	*/
+	void initBaseTreeStores();
+	/**
+		Returns the store built from the race's tree definition (with nothing obtained), or an empty store if the race has none.
+	*/
+	const TechTreeStore & getBaseTreeStore(BWAPI::Race race);
+}
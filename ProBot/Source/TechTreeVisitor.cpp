@@ -0,0 +1,23 @@
+/**
+	TechTreeVisitor.cpp
+	Read-only traversal of a TechTree, without copying any part of the tree.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "TechTreeVisitor.h"
+
+using namespace ProBot;
+
+bool ProBot::traverseTree(const TechTree & tree, TechTreeVisitor & visitor){
+	if (visitor.isDone())
+		return false;
+	if (!visitor.visit(tree)) // the visitor doesn't want this subtree
+		return !visitor.isDone();
+	for (const TechTree & sub : tree._subs){
+		if (!traverseTree(sub, visitor))
+			return false;
+	}
+	return true;
+}
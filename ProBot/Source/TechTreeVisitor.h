@@ -0,0 +1,40 @@
+/**
+	TechTreeVisitor.h
+	Read-only traversal of a TechTree, without copying any part of the tree.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+#include "TechTree.h"
+
+namespace ProBot{
+	/**
+		Interface for visiting the nodes of a TechTree in pre-order.
+		Nodes are passed by const reference, so visitors that collect results should keep pointers into the tree.
+	*/
+	class TechTreeVisitor {
+	public:
+		virtual ~TechTreeVisitor(){}
+		/**
+			Called once for each node reached by the traversal.
+			@param node - the node being visited
+			@return true to go on to the children of the node, false to skip its subtree
+		*/
+		virtual bool visit(const TechTree & node) = 0;
+		/**
+			Returns true once the visitor doesn't need to see any more nodes, which ends the traversal.
+		*/
+		virtual bool isDone() const { return false; }
+	};
+
+	/**
+		Visits the given tree and its subs in pre-order.
+		@param tree - the tree to traverse
+		@param visitor - the visitor to call on each node
+		@return false if the visitor ended the traversal early, true otherwise
+	*/
+	bool traverseTree(const TechTree & tree, TechTreeVisitor & visitor);
+}
@@ -0,0 +1,37 @@
+/**
+	Timer.cpp
+	High resolution timer used to measure and limit time spent in searches.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "Timer.h"
+#include <windows.h>
+
+using namespace ProBot;
+
+// the performance counter frequency is fixed at boot, so it only needs to be read once
+static long long getTicksPerSecond(){
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	return frequency.QuadPart;
+}
+
+static const long long TICKS_PER_SECOND = getTicksPerSecond();
+
+Timer::Timer(){
+	start();
+}
+
+void Timer::start(){
+	LARGE_INTEGER ticks;
+	QueryPerformanceCounter(&ticks);
+	_startTicks = ticks.QuadPart;
+}
+
+long long Timer::getElapsedMicroseconds() const{
+	LARGE_INTEGER ticks;
+	QueryPerformanceCounter(&ticks);
+	return (ticks.QuadPart - _startTicks) * 1000000 / TICKS_PER_SECOND;
+}
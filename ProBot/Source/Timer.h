@@ -0,0 +1,30 @@
+/**
+	Timer.h
+	High resolution timer used to measure and limit time spent in searches.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+namespace ProBot{
+	/**
+		A stopwatch with microsecond resolution.
+	*/
+	class Timer {
+		long long _startTicks;
+
+	public:
+		Timer();
+
+		/**
+			Restarts the timer from zero.
+		*/
+		void start();
+		/**
+			Returns the number of microseconds since the timer was last started.
+		*/
+		long long getElapsedMicroseconds() const;
+	};
+}
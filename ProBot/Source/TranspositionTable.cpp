@@ -0,0 +1,146 @@
+/**
+	TranspositionTable.cpp
+	Fixed-size hash table of previously searched tech tree states, keyed by Zobrist hash.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "TranspositionTable.h"
+
+using namespace ProBot;
+
+namespace {
+	// number of players that have their own set of keys
+	const int NUM_KEY_PLAYERS = 2;
+
+	/**
+		Generates the next value of a splitmix64 sequence, so that the keys are the same every game.
+	*/
+	zobrist_key_t nextKey(zobrist_key_t & seed){
+		zobrist_key_t z = (seed += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+
+	/**
+		The table of random keys, filled in on construction.
+	*/
+	struct ZobristKeys {
+		zobrist_key_t _slotKeys[NUM_KEY_PLAYERS][MAX_TECH_NODES];
+		zobrist_key_t _playerKeys[NUM_KEY_PLAYERS];
+
+		ZobristKeys(){
+			zobrist_key_t seed = 0;
+			for (int player = 0; player < NUM_KEY_PLAYERS; player++){
+				for (int slot = 0; slot < MAX_TECH_NODES; slot++)
+					_slotKeys[player][slot] = nextKey(seed);
+				_playerKeys[player] = nextKey(seed);
+			}
+		}
+	};
+
+	const ZobristKeys ZOBRIST_KEYS;
+
+	// layout of the packed entry data
+	const int DATA_SCORE_SHIFT = 0;
+	const int DATA_DEPTH_SHIFT = 32;
+	const int DATA_BOUND_SHIFT = 40;
+	const int DATA_MOVE_SHIFT = 48;
+
+	unsigned long long packData(int score, int depth, TT_BOUND bound, tech_slot_t bestMove){
+		return (static_cast<unsigned long long>(static_cast<unsigned int>(score)) << DATA_SCORE_SHIFT)
+			| (static_cast<unsigned long long>(depth & 0xFF) << DATA_DEPTH_SHIFT)
+			| (static_cast<unsigned long long>(bound & 0xFF) << DATA_BOUND_SHIFT)
+			| (static_cast<unsigned long long>(static_cast<unsigned short>(bestMove)) << DATA_MOVE_SHIFT);
+	}
+
+	int dataDepth(unsigned long long data){
+		return static_cast<int>((data >> DATA_DEPTH_SHIFT) & 0xFF);
+	}
+
+	TTResult unpackData(unsigned long long data){
+		TTResult result;
+		result._score = static_cast<int>(static_cast<unsigned int>(data >> DATA_SCORE_SHIFT));
+		result._depth = dataDepth(data);
+		result._bound = static_cast<TT_BOUND>((data >> DATA_BOUND_SHIFT) & 0xFF);
+		result._bestMove = static_cast<tech_slot_t>(static_cast<unsigned short>(data >> DATA_MOVE_SHIFT));
+		return result;
+	}
+}
+
+zobrist_key_t Zobrist::getSlotKey(int player, tech_slot_t slot){
+	return ZOBRIST_KEYS._slotKeys[player][slot];
+}
+
+zobrist_key_t Zobrist::getPlayerKey(int player){
+	return ZOBRIST_KEYS._playerKeys[player];
+}
+
+zobrist_key_t Zobrist::hashMask(int player, tech_mask_t mask){
+	zobrist_key_t key = 0;
+	for (tech_slot_t slot = 0; mask != 0; slot++, mask >>= 1){
+		if (mask & 1)
+			key ^= ZOBRIST_KEYS._slotKeys[player][slot];
+	}
+	return key;
+}
+
+TranspositionTable::TranspositionTable(){
+	clear();
+}
+
+void TranspositionTable::clear(){
+	for (TTBucket & bucket : _buckets){
+		for (TTEntry & entry : bucket._entries){
+			entry._check = 0;
+			entry._data = packData(0, 0, TT_NONE, NULL_SLOT);
+		}
+	}
+	_probes.store(0);
+	_hits.store(0);
+}
+
+bool TranspositionTable::probe(zobrist_key_t key, TTResult & result){
+	_probes.fetch_add(1, std::memory_order_relaxed);
+	TTBucket & bucket = _buckets[key & (TT_NUM_BUCKETS - 1)];
+	for (TTEntry & entry : bucket._entries){
+		unsigned long long data = entry._data;
+		if ((entry._check ^ data) == key && unpackData(data)._bound != TT_NONE){
+			result = unpackData(data);
+			_hits.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+void TranspositionTable::store(zobrist_key_t key, int score, int depth, TT_BOUND bound, tech_slot_t bestMove){
+	TTBucket & bucket = _buckets[key & (TT_NUM_BUCKETS - 1)];
+	TTEntry * replace = &bucket._entries[0];
+	for (TTEntry & entry : bucket._entries){
+		// always overwrite an older result for the same state
+		if ((entry._check ^ entry._data) == key){
+			replace = &entry;
+			break;
+		}
+		if (dataDepth(entry._data) < dataDepth(replace->_data))
+			replace = &entry;
+	}
+	unsigned long long data = packData(score, depth, bound, bestMove);
+	replace->_check = key ^ data;
+	replace->_data = data;
+}
+
+double TranspositionTable::getHitRate() const{
+	return (_probes > 0) ? static_cast<double>(_hits.load()) / _probes.load() : 0.0;
+}
+
+unsigned int TranspositionTable::getProbes() const{
+	return _probes.load();
+}
+
+unsigned int TranspositionTable::getHits() const{
+	return _hits.load();
+}
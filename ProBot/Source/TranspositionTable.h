@@ -0,0 +1,106 @@
+/**
+	TranspositionTable.h
+	Fixed-size hash table of previously searched tech tree states, keyed by Zobrist hash.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+#include <atomic>
+#include "TechTreeStore.h"
+
+namespace ProBot{
+	typedef unsigned long long zobrist_key_t;
+
+	namespace Zobrist{
+		/**
+			Returns the random key of a node slot in the given player's tree.
+		*/
+		zobrist_key_t getSlotKey(int player, tech_slot_t slot);
+		/**
+			Returns the key that is mixed in when it is the given player's turn.
+		*/
+		zobrist_key_t getPlayerKey(int player);
+		/**
+			Returns the combined key of all slots set in a mask of the given player's tree.
+		*/
+		zobrist_key_t hashMask(int player, tech_mask_t mask);
+	}
+
+	// number of entries that share a cache line
+	const int TT_BUCKET_SIZE = 4;
+	// number of buckets in the table (must be a power of two)
+	const int TT_NUM_BUCKETS = 1 << 14;
+
+	// the relation between a stored score and the true score of a state
+	enum TT_BOUND {
+		TT_NONE,
+		TT_EXACT,
+		TT_LOWER,
+		TT_UPPER
+	};
+
+	/**
+		A struct representing a single stored search result.
+		The key is stored xor'd with the data, so that a partially written entry fails to match.
+	*/
+	struct TTEntry {
+		zobrist_key_t _check;
+		unsigned long long _data;
+	};
+
+	/**
+		A cache-line sized group of entries that a key can be stored in.
+	*/
+	struct __declspec(align(64)) TTBucket {
+		TTEntry _entries[TT_BUCKET_SIZE];
+	};
+
+	/**
+		The unpacked contents of an entry.
+	*/
+	struct TTResult {
+		int _score;
+		int _depth;
+		TT_BOUND _bound;
+		tech_slot_t _bestMove;
+	};
+
+	/**
+		Transposition table for the tech minimax search.
+		Threads may probe and store concurrently without locking: a torn entry fails its key check and reads as a miss.
+	*/
+	class TranspositionTable {
+		TTBucket _buckets[TT_NUM_BUCKETS];
+		// counted by every thread searching the table
+		std::atomic<unsigned int> _probes;
+		std::atomic<unsigned int> _hits;
+
+	public:
+		TranspositionTable();
+
+		/**
+			Empties the table and resets its statistics.
+		*/
+		void clear();
+		/**
+			Looks up a state in the table.
+			@param key - the Zobrist hash of the state
+			@param result - set to the stored result if the state is found
+			@return true if the state was found, false otherwise
+		*/
+		bool probe(zobrist_key_t key, TTResult & result);
+		/**
+			Stores a search result, replacing the entry for the same state or else the shallowest entry in the bucket.
+		*/
+		void store(zobrist_key_t key, int score, int depth, TT_BOUND bound, tech_slot_t bestMove);
+		/**
+			Returns the fraction of probes that found their state, or 0 if there have been no probes.
+		*/
+		double getHitRate() const;
+		unsigned int getProbes() const;
+		unsigned int getHits() const;
+	};
+}
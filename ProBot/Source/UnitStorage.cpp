@@ -12,7 +12,6 @@
 using namespace ProBot;
 
 UnitStorage::UnitStorage(){
-
 }
 
 void UnitStorage::draw()
@@ -81,6 +80,14 @@ BWAPI::Unitset UnitStorage::getUnitsOfType(BWAPI::UnitType unitType){
 	return unitset;
 }
 
+int UnitStorage::getCompletedCount(BWAPI::UnitType unitType) const{
+	return _unitCounts.getCompletedCount(unitType);
+}
+
+int UnitStorage::getProductionCount(BWAPI::UnitType unitType) const{
+	return _unitCounts.getProductionCount(unitType);
+}
+
 BWAPI::Unitset UnitStorage::getNUnitsOfType(BWAPI::UnitType unitType, int n, const BWAPI::UnitFilter & pred){
 	BWAPI::Unitset unitset;
 	for (auto & unit : getUnitsOfType(unitType)){
@@ -110,36 +117,62 @@ BWAPI::Unitset UnitStorage::getNUnitsOfCategory(int category, int n, const BWAPI
 	return unitset;
 }
 
-std::vector<refinery_worker_count_pair_t>& UnitStorage::getRefineryUnits(){
-	return _refineryUnits;
-}
-
 // ASSUMPTION: Unit was added correctly when spawned
 void UnitStorage::handleUnitDestroy(BWAPI::Unit unit){
-	std::array<bool, NUM_CATEGORIES> categories = getCategories(unit->getType());
-	for (int i = 0; i < NUM_CATEGORIES; i++){
-		if (categories[i])
-			_units[i].erase(unit);
-	}
+	// a unit destroyed before it completed (or whose production was cancelled) is no longer in production
+	removeFromQueue(unit);
+	BWAPI::UnitType countedType = _unitCounts.getCountedType(unit->getID());
+	eraseUnit(unit, (countedType != BWAPI::UnitTypes::None) ? countedType : unit->getType());
+	_unitCounts.remove(unit->getID());
 }
 
 void UnitStorage::handleUnitComplete(BWAPI::Unit unit){
 	if (isValidUnit(unit))
 	{
 		removeFromQueue(unit);
-		
-		std::array<bool, NUM_CATEGORIES> categories = getCategories(unit->getType());
-		for (int i = 0; i < NUM_CATEGORIES; i++)
-			if (categories[i])
-				_units[i].insert(unit);
-
-		if (unit->getType().isRefinery())
-			_refineryUnits.push_back(std::make_pair(unit, 0));
+		// setAll hands every unit over again, which keeps the type it was counted as
+		_unitCounts.addCompleted(unit->getID(), unit->getType());
+		storeUnit(unit, _unitCounts.getCountedType(unit->getID()));
 	}
 }
 
 void UnitStorage::handleUnitCreate(BWAPI::Unit unit){
+	if (!unit || isInQueue(unit))
+		return;
 	_queuedUnits.push_back(unit);
+	_unitCounts.addInProduction(unit->getID(), unit->getType());
+}
+
+void UnitStorage::handleUnitMorph(BWAPI::Unit unit){
+	if (!unit)
+		return;
+	if (_unitCounts.isCompleted(unit->getID()))
+		eraseUnit(unit, _unitCounts.getCountedType(unit->getID()));
+	_unitCounts.morph(unit->getID(), unit->getType(), unit->isCompleted());
+	// a unit that starts morphing (a Drone into a building) is back in production until it completes,
+	// and one whose morph was cancelled (back into a Drone) is completed again
+	if (_unitCounts.isInProduction(unit->getID())){
+		if (!isInQueue(unit))
+			_queuedUnits.push_back(unit);
+	}
+	else if (_unitCounts.isCompleted(unit->getID())){
+		removeFromQueue(unit);
+		storeUnit(unit, unit->getType());
+	}
+}
+
+void UnitStorage::storeUnit(BWAPI::Unit unit, BWAPI::UnitType unitType){
+	std::array<bool, NUM_CATEGORIES> categories = getCategories(unitType);
+	for (int i = 0; i < NUM_CATEGORIES; i++)
+		if (categories[i])
+			_units[i].insert(unit);
+}
+
+void UnitStorage::eraseUnit(BWAPI::Unit unit, BWAPI::UnitType unitType){
+	std::array<bool, NUM_CATEGORIES> categories = getCategories(unitType);
+	for (int i = 0; i < NUM_CATEGORIES; i++)
+		if (categories[i])
+			_units[i].erase(unit);
 }
 
 std::vector<BWAPI::Unit> UnitStorage::getQueuedUnits(){
@@ -153,12 +186,7 @@ bool UnitStorage::isInQueue(BWAPI::Unit unit){
 }
 
 bool UnitStorage::isInQueue(BWAPI::UnitType type){
-	removeInvalidQueueUnits();
-
-	for (auto & unit : _queuedUnits)
-		if (unit->getType() == type)
-			return true;
-	return false;
+	return getProductionCount(type) > 0;
 }
 
 void UnitStorage::removeFromQueue(BWAPI::Unit unit){
@@ -188,6 +216,7 @@ void UnitStorage::clearAll(){
 	for (auto & unitset : _units){
 		unitset.clear();
 	}
+	_unitCounts.clearCompleted();
 }
 
 void UnitStorage::setAll(){
@@ -12,11 +12,10 @@
 #include <BWAPI.h>
 #include <array>
 #include "Debug.h"
+#include "UnitTypeCounter.h"
 
 namespace ProBot
 {
-	typedef std::pair<BWAPI::Unit, int> refinery_worker_count_pair_t;
-
 	class UnitStorage
 	{
 	public:
@@ -39,10 +38,17 @@ namespace ProBot
 
 		BWAPI::Unitset& getUnits(int category);
 		BWAPI::Unitset getUnitsOfType(BWAPI::UnitType);
+		/**
+			Returns the number of own completed units of the given type, kept up to date by the unit event handlers.
+		*/
+		int getCompletedCount(BWAPI::UnitType) const;
+		/**
+			Returns the number of own units of the given type that have been created but not yet completed.
+		*/
+		int getProductionCount(BWAPI::UnitType) const;
 
 		std::array<bool, NUM_CATEGORIES> getCategories(BWAPI::UnitType);
 
-		std::vector<refinery_worker_count_pair_t>& getRefineryUnits();
 		std::vector<BWAPI::Unit> getQueuedUnits();
 
 		bool isInQueue(BWAPI::Unit);
@@ -56,13 +62,23 @@ namespace ProBot
 		void handleUnitDestroy(BWAPI::Unit);
 		void handleUnitComplete(BWAPI::Unit);
 		void handleUnitCreate(BWAPI::Unit);
+		/**
+			Moves a morphed unit's counts from the type it was counted as to its new type
+			(an incomplete unit, such as a warping Archon, is in production until it completes).
+		*/
+		void handleUnitMorph(BWAPI::Unit);
 		BWAPI::Unitset getNUnitsOfType(BWAPI::UnitType unitType, int n, const BWAPI::UnitFilter & pred = &BWAPI::UnitFilter::isValid);
 		BWAPI::Unitset getNUnitsOfCategory(int category, int n, const BWAPI::UnitFilter & pred = &BWAPI::UnitFilter::isValid);
 
 		bool isScout(BWAPI::UnitType);
 	private:
 		BWAPI::Unitset _units[NUM_CATEGORIES];
-		std::vector<refinery_worker_count_pair_t> _refineryUnits;
 		std::vector<BWAPI::Unit> _queuedUnits;
+
+		// number of units of each type in _units[ALL] and in _queuedUnits, by the type each unit was counted as
+		UnitTypeCounter _unitCounts;
+
+		void storeUnit(BWAPI::Unit, BWAPI::UnitType);
+		void eraseUnit(BWAPI::Unit, BWAPI::UnitType);
 	};
 }
\ No newline at end of file
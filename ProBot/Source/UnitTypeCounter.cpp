@@ -0,0 +1,110 @@
+/**
+	UnitTypeCounter.cpp
+	Number of units of each type, completed and in production, kept up to date from the unit events by unit ID.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "UnitTypeCounter.h"
+
+using namespace ProBot;
+
+namespace {
+	bool isCountableType(BWAPI::UnitType unitType){
+		return unitType.getID() >= 0 && unitType.getID() < BWAPI::UnitTypes::Enum::MAX;
+	}
+}
+
+UnitTypeCounter::UnitTypeCounter(){
+	clear();
+}
+
+void UnitTypeCounter::clear(){
+	_units.clear();
+	_completedCounts.fill(0);
+	_productionCounts.fill(0);
+}
+
+void UnitTypeCounter::clearCompleted(){
+	for (auto it = _units.begin(); it != _units.end();){
+		if (it->second._completed)
+			it = _units.erase(it);
+		else
+			++it;
+	}
+	_completedCounts.fill(0);
+}
+
+void UnitTypeCounter::count(int id, BWAPI::UnitType unitType, bool completed){
+	if (!isCountableType(unitType))
+		return;
+	CountedUnit unit;
+	unit._unitType = unitType;
+	unit._completed = completed;
+	_units[id] = unit;
+	if (completed)
+		_completedCounts[unitType.getID()]++;
+	else
+		_productionCounts[unitType.getID()]++;
+}
+
+void UnitTypeCounter::addInProduction(int id, BWAPI::UnitType unitType){
+	if (_units.count(id) == 0)
+		count(id, unitType, false);
+}
+
+void UnitTypeCounter::addCompleted(int id, BWAPI::UnitType unitType){
+	auto counted = _units.find(id);
+	if (counted != _units.end() && counted->second._completed)
+		return;
+	remove(id);
+	count(id, unitType, true);
+}
+
+void UnitTypeCounter::morph(int id, BWAPI::UnitType unitType, bool completed){
+	auto counted = _units.find(id);
+	if (counted == _units.end()){
+		if (completed)
+			count(id, unitType, true);
+		return;
+	}
+	if (counted->second._unitType == unitType && counted->second._completed == completed)
+		return;
+	remove(id);
+	count(id, unitType, completed);
+}
+
+void UnitTypeCounter::remove(int id){
+	auto counted = _units.find(id);
+	if (counted == _units.end())
+		return;
+	if (counted->second._completed)
+		_completedCounts[counted->second._unitType.getID()]--;
+	else
+		_productionCounts[counted->second._unitType.getID()]--;
+	_units.erase(counted);
+}
+
+BWAPI::UnitType UnitTypeCounter::getCountedType(int id) const{
+	auto counted = _units.find(id);
+	return (counted != _units.end()) ? counted->second._unitType : BWAPI::UnitTypes::None;
+}
+
+bool UnitTypeCounter::isCompleted(int id) const{
+	auto counted = _units.find(id);
+	return counted != _units.end() && counted->second._completed;
+}
+
+bool UnitTypeCounter::isInProduction(int id) const{
+	auto counted = _units.find(id);
+	return counted != _units.end() && !counted->second._completed;
+}
+
+int UnitTypeCounter::getCompletedCount(BWAPI::UnitType unitType) const{
+	return isCountableType(unitType) ? _completedCounts[unitType.getID()] : 0;
+}
+
+int UnitTypeCounter::getProductionCount(BWAPI::UnitType unitType) const{
+	return isCountableType(unitType) ? _productionCounts[unitType.getID()] : 0;
+}
@@ -0,0 +1,72 @@
+/**
+	UnitTypeCounter.h
+	Number of units of each type, completed and in production, kept up to date from the unit events by unit ID.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+#include <BWAPI.h>
+#include <array>
+#include <map>
+
+namespace ProBot{
+	/**
+		Counts units by type, storing the type each unit (by ID) was counted as. Units change type when they morph
+		(a High Templar into an Archon, a Drone into a building), so a later event moves or removes the count
+		of the type the unit was counted as, rather than of its current type.
+	*/
+	class UnitTypeCounter {
+		/**
+			The type a unit was counted as, and whether it was counted as completed or in production.
+		*/
+		struct CountedUnit {
+			BWAPI::UnitType _unitType;
+			bool _completed;
+		};
+
+		std::map<int, CountedUnit> _units;
+		// number of counted units of each type (indexed by type ID)
+		std::array<int, BWAPI::UnitTypes::Enum::MAX> _completedCounts;
+		std::array<int, BWAPI::UnitTypes::Enum::MAX> _productionCounts;
+
+		void count(int id, BWAPI::UnitType unitType, bool completed);
+
+	public:
+		UnitTypeCounter();
+		void clear();
+		/**
+			Stops counting the completed units, keeping the units in production.
+		*/
+		void clearCompleted();
+
+		/**
+			Counts a unit that has been created, unless it's already counted.
+		*/
+		void addInProduction(int id, BWAPI::UnitType unitType);
+		/**
+			Counts a unit as completed, moving it out of production if it was counted there.
+		*/
+		void addCompleted(int id, BWAPI::UnitType unitType);
+		/**
+			Moves a unit's count to its new type, and to completed or in production.
+			An uncounted unit is only counted if it's completed.
+		*/
+		void morph(int id, BWAPI::UnitType unitType, bool completed);
+		/**
+			Stops counting a unit that has been destroyed (or whose production was cancelled).
+		*/
+		void remove(int id);
+
+		/**
+			Returns the type the unit was counted as, or UnitTypes::None if it isn't counted.
+		*/
+		BWAPI::UnitType getCountedType(int id) const;
+		bool isCompleted(int id) const;
+		bool isInProduction(int id) const;
+		int getCompletedCount(BWAPI::UnitType unitType) const;
+		int getProductionCount(BWAPI::UnitType unitType) const;
+	};
+}
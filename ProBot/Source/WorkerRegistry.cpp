@@ -0,0 +1,281 @@
+/**
+	WorkerRegistry.cpp
+	Table of the mineral patch or refinery that each worker gathers from, with the number of workers on each.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#include "WorkerRegistry.h"
+#include <algorithm>
+
+using namespace ProBot;
+
+namespace {
+	// entry of the index tables (and bucket position) of a unit that isn't registered
+	const int NO_INDEX = -1;
+
+	// sorts mineral patches furthest first, so that the closest is at the back of the bucket
+	bool isFurther(const std::pair<int, int> & a, const std::pair<int, int> & b){
+		return a.second > b.second;
+	}
+}
+
+WorkerRegistry::WorkerRegistry()
+	: _numMineralWorkers(0), _numGasWorkers(0){
+}
+
+void WorkerRegistry::clear(){
+	_resources.clear();
+	_resourceIndex.clear();
+	_workerResource.clear();
+	_isWorker.clear();
+	for (auto & bucket : _mineralBuckets)
+		bucket.clear();
+	_refineryBucket.clear();
+	_numMineralWorkers = 0;
+	_numGasWorkers = 0;
+}
+
+void WorkerRegistry::growTables(int id){
+	if (id >= static_cast<int>(_resourceIndex.size())){
+		_resourceIndex.resize(id + 1, NO_INDEX);
+		_workerResource.resize(id + 1, NO_INDEX);
+		_isWorker.resize(id + 1, false);
+	}
+}
+
+std::vector<int> & WorkerRegistry::getBucket(const Resource & resource){
+	if (resource._isGas)
+		return _refineryBucket;
+	// patches past the cap share the last bucket
+	int workers = static_cast<int>(resource._workers.size());
+	return _mineralBuckets[(workers < MAX_MINERAL_WORKERS) ? workers : MAX_MINERAL_WORKERS];
+}
+
+void WorkerRegistry::addToBucket(int index){
+	Resource & resource = _resources[index];
+	// saturated refineries aren't in any bucket
+	if (resource._isGas && static_cast<int>(resource._workers.size()) >= GAS_SATURATION)
+		return;
+	std::vector<int> & bucket = getBucket(resource);
+	resource._bucketPosition = static_cast<int>(bucket.size());
+	bucket.push_back(index);
+}
+
+void WorkerRegistry::removeFromBucket(int index){
+	Resource & resource = _resources[index];
+	if (resource._bucketPosition == NO_INDEX)
+		return;
+	// swap the resource with the last of its bucket, so that it can be removed in constant time
+	std::vector<int> & bucket = getBucket(resource);
+	int last = bucket.back();
+	bucket[resource._bucketPosition] = last;
+	_resources[last]._bucketPosition = resource._bucketPosition;
+	bucket.pop_back();
+	resource._bucketPosition = NO_INDEX;
+}
+
+int WorkerRegistry::addResource(int id, int depot, int distance, bool isGas){
+	growTables(id);
+	// a resource that's added again (such as a refinery rebuilt on the same geyser) replaces the old one
+	if (_resourceIndex[id] != NO_INDEX)
+		removeResource(id);
+	Resource resource;
+	resource._id = id;
+	resource._depot = depot;
+	resource._distance = distance;
+	resource._isGas = isGas;
+	resource._active = true;
+	resource._bucketPosition = NO_INDEX;
+	_resources.push_back(resource);
+	int index = static_cast<int>(_resources.size()) - 1;
+	_resourceIndex[id] = index;
+	addToBucket(index);
+	return index;
+}
+
+void WorkerRegistry::addBase(int depot, std::vector<std::pair<int, int>> minerals){
+	std::sort(minerals.begin(), minerals.end(), isFurther);
+	for (auto & mineral : minerals)
+		addResource(mineral.first, depot, mineral.second, false);
+}
+
+void WorkerRegistry::addRefinery(int refinery, int depot, int distance){
+	addResource(refinery, depot, distance, true);
+}
+
+std::vector<int> WorkerRegistry::releaseResource(int index){
+	Resource & resource = _resources[index];
+	removeFromBucket(index);
+	std::vector<int> workers;
+	workers.swap(resource._workers);
+	for (int worker : workers)
+		_workerResource[worker] = NO_INDEX;
+	if (resource._isGas)
+		_numGasWorkers -= static_cast<int>(workers.size());
+	else
+		_numMineralWorkers -= static_cast<int>(workers.size());
+	resource._active = false;
+	_resourceIndex[resource._id] = NO_INDEX;
+	return workers;
+}
+
+std::vector<int> WorkerRegistry::removeBase(int depot){
+	std::vector<int> workers;
+	for (size_t i = 0; i < _resources.size(); i++){
+		if (!_resources[i]._active || _resources[i]._depot != depot)
+			continue;
+		std::vector<int> released = releaseResource(static_cast<int>(i));
+		workers.insert(workers.end(), released.begin(), released.end());
+	}
+	return workers;
+}
+
+std::vector<int> WorkerRegistry::removeResource(int id){
+	if (id < 0 || id >= static_cast<int>(_resourceIndex.size()) || _resourceIndex[id] == NO_INDEX)
+		return std::vector<int>();
+	return releaseResource(_resourceIndex[id]);
+}
+
+void WorkerRegistry::addWorker(int worker){
+	if (worker < 0)
+		return;
+	growTables(worker);
+	_isWorker[worker] = true;
+}
+
+void WorkerRegistry::removeWorker(int worker){
+	if (!isWorker(worker))
+		return;
+	unassign(worker);
+	_isWorker[worker] = false;
+}
+
+bool WorkerRegistry::isWorker(int worker) const{
+	return worker >= 0 && worker < static_cast<int>(_isWorker.size()) && _isWorker[worker];
+}
+
+void WorkerRegistry::unassign(int worker){
+	if (!isWorker(worker) || _workerResource[worker] == NO_INDEX)
+		return;
+	int index = _workerResource[worker];
+	Resource & resource = _resources[index];
+	removeFromBucket(index);
+	resource._workers.erase(std::find(resource._workers.begin(), resource._workers.end(), worker));
+	addToBucket(index);
+	if (resource._isGas)
+		_numGasWorkers--;
+	else
+		_numMineralWorkers--;
+	_workerResource[worker] = NO_INDEX;
+}
+
+void WorkerRegistry::assign(int worker, int index){
+	unassign(worker);
+	Resource & resource = _resources[index];
+	removeFromBucket(index);
+	resource._workers.push_back(worker);
+	addToBucket(index);
+	if (resource._isGas)
+		_numGasWorkers++;
+	else
+		_numMineralWorkers++;
+	_workerResource[worker] = index;
+}
+
+int WorkerRegistry::assignMinerals(int worker){
+	if (!isWorker(worker))
+		return NO_UNIT_ID;
+	// the least occupied patch, and the most recently freed (or at first the closest) of those
+	int index = NO_INDEX;
+	int workers = 0;
+	while (workers < MAX_MINERAL_WORKERS && _mineralBuckets[workers].empty())
+		workers++;
+	if (workers < MAX_MINERAL_WORKERS)
+		index = _mineralBuckets[workers].back();
+	else {
+		// every patch is at the cap, so the extra workers are spread over the patches of the last bucket
+		for (int candidate : _mineralBuckets[MAX_MINERAL_WORKERS]){
+			if (index == NO_INDEX || _resources[candidate]._workers.size() < _resources[index]._workers.size())
+				index = candidate;
+		}
+		if (index == NO_INDEX)
+			return NO_UNIT_ID;
+		workers = static_cast<int>(_resources[index]._workers.size());
+	}
+	// a worker already on a patch this occupied stays there
+	if (_workerResource[worker] != NO_INDEX && !_resources[_workerResource[worker]]._isGas
+		&& static_cast<int>(_resources[_workerResource[worker]]._workers.size()) <= workers + 1)
+		return _resources[_workerResource[worker]]._id;
+	assign(worker, index);
+	return _resources[index]._id;
+}
+
+int WorkerRegistry::assignGas(int worker){
+	int refinery = getRefineryNeedingWorkers();
+	if (!isWorker(worker) || refinery == NO_UNIT_ID)
+		return NO_UNIT_ID;
+	assign(worker, _resourceIndex[refinery]);
+	return refinery;
+}
+
+int WorkerRegistry::getRefineryNeedingWorkers() const{
+	return _refineryBucket.empty() ? NO_UNIT_ID : _resources[_refineryBucket.back()]._id;
+}
+
+int WorkerRegistry::takeMineralWorker(){
+	for (int workers = MAX_MINERAL_WORKERS; workers > 0; workers--){
+		if (_mineralBuckets[workers].empty())
+			continue;
+		int index = _mineralBuckets[workers].back();
+		// the last bucket also holds patches past the cap, so the busiest of those gives up its worker
+		if (workers == MAX_MINERAL_WORKERS){
+			for (int candidate : _mineralBuckets[workers]){
+				if (_resources[candidate]._workers.size() > _resources[index]._workers.size())
+					index = candidate;
+			}
+		}
+		int worker = _resources[index]._workers.back();
+		unassign(worker);
+		return worker;
+	}
+	return NO_UNIT_ID;
+}
+
+int WorkerRegistry::takeOversaturatedWorker(){
+	int least = 0;
+	while (least <= MAX_MINERAL_WORKERS && _mineralBuckets[least].empty())
+		least++;
+	for (int workers = MAX_MINERAL_WORKERS; workers >= least + 2; workers--){
+		if (!_mineralBuckets[workers].empty())
+			return takeMineralWorker();
+	}
+	return NO_UNIT_ID;
+}
+
+int WorkerRegistry::getResource(int worker) const{
+	if (!isWorker(worker) || _workerResource[worker] == NO_INDEX)
+		return NO_UNIT_ID;
+	return _resources[_workerResource[worker]]._id;
+}
+
+int WorkerRegistry::getNumberOfWorkers(int resource) const{
+	if (resource < 0 || resource >= static_cast<int>(_resourceIndex.size()) || _resourceIndex[resource] == NO_INDEX)
+		return 0;
+	return static_cast<int>(_resources[_resourceIndex[resource]]._workers.size());
+}
+
+int WorkerRegistry::getReturnDistance(int resource) const{
+	if (resource < 0 || resource >= static_cast<int>(_resourceIndex.size()) || _resourceIndex[resource] == NO_INDEX)
+		return -1;
+	return _resources[_resourceIndex[resource]]._distance;
+}
+
+int WorkerRegistry::getNumberOfMineralWorkers() const{
+	return _numMineralWorkers;
+}
+
+int WorkerRegistry::getNumberOfGasWorkers() const{
+	return _numGasWorkers;
+}
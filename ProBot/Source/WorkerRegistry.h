@@ -0,0 +1,135 @@
+/**
+	WorkerRegistry.h
+	Table of the mineral patch or refinery that each worker gathers from, with the number of workers on each.
+
+	@author Paul Wang
+	@version 9/8/16
+*/
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+namespace ProBot{
+	// workers per mineral patch past which no patch gets another until every patch has as many (two keep it fully mined)
+	const int MAX_MINERAL_WORKERS = 3;
+	// workers per refinery that keep it fully mined
+	const int GAS_SATURATION = 3;
+	// furthest (in pixels) that a mineral patch can be from a resource depot to be mined from it
+	const int BASE_RADIUS = 320;
+	// returned in place of a unit ID when there's no suitable worker or resource
+	const int NO_UNIT_ID = -1;
+
+	/**
+		Assigns workers to the mineral patches and refineries of each base, keyed by unit ID.
+		Mineral patches are kept in buckets by the number of workers on them, so that the least occupied patch
+		can be found (and a worker moved between patches) in constant time, without searching the map.
+	*/
+	class WorkerRegistry {
+		/**
+			A mineral patch or refinery, and the workers assigned to it.
+		*/
+		struct Resource {
+			int _id;
+			// resource depot that the resource is mined from, and the distance between them in pixels
+			int _depot;
+			int _distance;
+			bool _isGas;
+			// false once the resource has been removed (its slot isn't reused)
+			bool _active;
+			std::vector<int> _workers;
+			// index of the resource in the bucket for its number of workers, or -1 if it's in none
+			int _bucketPosition;
+		};
+
+		std::vector<Resource> _resources;
+		// indexed by unit ID: the index into _resources of the unit's resource / of the worker's resource, or -1
+		std::vector<int> _resourceIndex;
+		std::vector<int> _workerResource;
+		// true for each unit ID that is a registered worker
+		std::vector<bool> _isWorker;
+		// indexes of the active mineral patches with each number of workers (0 to MAX_MINERAL_WORKERS, the last also holding busier patches)
+		std::vector<int> _mineralBuckets[MAX_MINERAL_WORKERS + 1];
+		// indexes of the active refineries with fewer than GAS_SATURATION workers
+		std::vector<int> _refineryBucket;
+		int _numMineralWorkers;
+		int _numGasWorkers;
+
+		/**
+			Grows the tables indexed by unit ID to fit the given ID.
+		*/
+		void growTables(int id);
+		std::vector<int> & getBucket(const Resource & resource);
+		void addToBucket(int index);
+		void removeFromBucket(int index);
+		int addResource(int id, int depot, int distance, bool isGas);
+		void assign(int worker, int index);
+		/**
+			Returns the workers of a removed resource, which are then unassigned.
+		*/
+		std::vector<int> releaseResource(int index);
+
+	public:
+		WorkerRegistry();
+		void clear();
+
+		/**
+			Registers a new base and its mineral patches, given as pairs of unit ID and distance from the depot.
+			Closer patches get workers first.
+		*/
+		void addBase(int depot, std::vector<std::pair<int, int>> minerals);
+		void addRefinery(int refinery, int depot, int distance);
+		/**
+			Removes the resources of a base, or a single resource (mined out, or a destroyed refinery).
+			@return the workers that were assigned to them, which are then unassigned
+		*/
+		std::vector<int> removeBase(int depot);
+		std::vector<int> removeResource(int id);
+
+		void addWorker(int worker);
+		void removeWorker(int worker);
+		bool isWorker(int worker) const;
+		/**
+			Takes the worker off its resource, for example to build.
+		*/
+		void unassign(int worker);
+
+		/**
+			Assigns the worker to the least occupied mineral patch. Once every patch has MAX_MINERAL_WORKERS workers,
+			further workers still get a patch with at least that many.
+			@return the patch, or NO_UNIT_ID if there are no mineral patches
+		*/
+		int assignMinerals(int worker);
+		/**
+			Assigns the worker to a refinery that needs workers.
+			@return the refinery, or NO_UNIT_ID if every refinery has GAS_SATURATION workers
+		*/
+		int assignGas(int worker);
+		/**
+			Returns a refinery with fewer than GAS_SATURATION workers, or NO_UNIT_ID.
+		*/
+		int getRefineryNeedingWorkers() const;
+		/**
+			Unassigns and returns a worker from the most occupied mineral patch, or NO_UNIT_ID if no patch has workers.
+		*/
+		int takeMineralWorker();
+		/**
+			Unassigns and returns a worker from a patch with at least two more workers than the least occupied patch
+			(such as after a new base is added), or NO_UNIT_ID if the patches are balanced.
+		*/
+		int takeOversaturatedWorker();
+
+		/**
+			Returns the resource that the worker gathers from, or NO_UNIT_ID.
+		*/
+		int getResource(int worker) const;
+		int getNumberOfWorkers(int resource) const;
+		/**
+			Returns the distance in pixels from the resource to its depot, or -1 if it's not registered.
+		*/
+		int getReturnDistance(int resource) const;
+		int getNumberOfMineralWorkers() const;
+		int getNumberOfGasWorkers() const;
+	};
+}
@@ -1,7 +1,25 @@
 #include "stdafx.h"
 #include "CppUnitTest.h"
 #include "TechTree.h"
+#include "TechTreeStore.h"
+#include "TranspositionTable.h"
 #include "BuildMinimax.h"
+#include "CombatUtil.h"
+#include "BuildMCTS.h"
+#include "OpeningBook.h"
+#include "BuildSearchWorker.h"
+#include "BuildPlanner.h"
+#include "BuildQueue.h"
+#include "BuildScheduler.h"
+#include "IncomeForecast.h"
+#include "BuildOrderScript.h"
+#include "PlacementGrid.h"
+#include "WorkerRegistry.h"
+#include "UnitTypeCounter.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "BuildOrders.h"
 #include "TestUnit.h"
 
 using namespace Microsoft::VisualStudio::CppUnitTestFramework;
@@ -26,6 +44,18 @@ namespace ProBotTest
 	TechTree test12 = TechTree{ Protoss_Probe, false, {} };
 	TechTree test13 = TechTree{ Protoss_Nexus, true, { TechTree{ Protoss_Gateway, false }, TechTree{ Protoss_Gateway, false, { TechTree{Protoss_Zealot} } } } };
 
+	// sets up the search position used by the search tests: Protoss with a Gateway against Terran, with a Barracks if asked
+	static void initTrees(TechTreeStore & self, TechTreeStore & enemy, bool enemyBarracks = true){
+		self = TechTreeStore(PROTOSS_TREE);
+		enemy = TechTreeStore(TERRAN_TREE);
+		self.setPrereqsObtained(Protoss_Gateway);
+		self.setBuildingNodeObtained(Protoss_Gateway);
+		if (enemyBarracks){
+			enemy.setPrereqsObtained(Terran_Barracks);
+			enemy.setBuildingNodeObtained(Terran_Barracks);
+		}
+	}
+
 	TEST_CLASS(TechTreeTest)
 	{
 	public:
@@ -61,9 +91,10 @@ namespace ProBotTest
 		TEST_METHOD(TestPrereq){
 			//Assert::AreEqual(Protoss_Nexus.getName(), findPrereqNodes(Protoss_Probe, TERRAN_TREE).at(2).getName());
 			//Assert::AreEqual(0, static_cast<int>(getUnitPrereqs(Protoss_Probe, TERRAN_TREE).size()));
-			Assert::AreEqual(0, static_cast<int>(getUnitPrereqs(Protoss_Nexus, PROTOSS_TREE).size()));
-			Assert::AreEqual(1, static_cast<int>(getUnitPrereqs(Protoss_Probe, PROTOSS_TREE).size()));
-			Assert::AreEqual(Protoss_Gateway.getName(), getUnitPrereqs(Protoss_Zealot, PROTOSS_TREE).at(1).getName());
+			TechTree protossTree = getBaseTree(BWAPI::Races::Protoss);
+			Assert::AreEqual(0, static_cast<int>(getUnitPrereqs(Protoss_Nexus, protossTree).size()));
+			Assert::AreEqual(1, static_cast<int>(getUnitPrereqs(Protoss_Probe, protossTree).size()));
+			Assert::AreEqual(Protoss_Gateway.getName(), getUnitPrereqs(Protoss_Zealot, protossTree).at(1).getName());
 		}
 
 		TEST_METHOD(TestTree2){
@@ -92,5 +123,1243 @@ namespace ProBotTest
 		TEST_METHOD(TestObtained){
 			Assert::AreEqual(Protoss_Observatory.getName(), getObtainedNodes(test5a).at(0).getName());
 		}
+
+		TEST_METHOD(TestTraversalBuffers){
+			// results point into the tree instead of copying it, and the buffer is appended to
+			std::vector<const TechTree*> nodes;
+			findNextObtainableNodes(test6, nodes);
+			Assert::AreEqual(2, static_cast<int>(nodes.size()));
+			Assert::IsTrue(nodes.at(0) == &test6._subs.at(0));
+			findLeafNodes(test6, nodes);
+			Assert::AreEqual(4, static_cast<int>(nodes.size()));
+			Assert::AreEqual(Protoss_Photon_Cannon.getName(), nodes.at(3)->_unitType.getName());
+		}
+	};
+
+	TEST_CLASS(TechTreeStoreTest)
+	{
+	public:
+		TEST_METHOD(TestStoreFindNode){
+			TechTreeStore store(test11);
+			Assert::AreEqual(Protoss_Observer.getName(), store[store.findNode(Protoss_Observer)]._unitType.getName());
+			Assert::AreEqual(Protoss_Observatory.getName(), store[store.getImmediateParent(Protoss_Observer)]._unitType.getName());
+			Assert::AreEqual(static_cast<int>(NULL_SLOT), static_cast<int>(store.findNode(Protoss_Carrier)));
+		}
+		TEST_METHOD(TestStoreNextObtainableNodes){
+			TechTreeStore store(test2);
+			std::vector<tech_slot_t> nodes;
+			store.findNextObtainableNodes(nodes);
+			Assert::AreEqual(2, static_cast<int>(nodes.size()));
+			Assert::AreEqual(Protoss_Archon.getName(), store[nodes.at(0)]._unitType.getName());
+			Assert::AreEqual(Protoss_Zealot.getName(), store[nodes.at(1)]._unitType.getName());
+		}
+		TEST_METHOD(TestStorePrereq){
+			TechTreeStore store(PROTOSS_TREE);
+			Assert::AreEqual(0, static_cast<int>(store.getUnitPrereqs(Protoss_Nexus).size()));
+			Assert::AreEqual(1, static_cast<int>(store.getUnitPrereqs(Protoss_Probe).size()));
+			Assert::AreEqual(Protoss_Gateway.getName(), store.getUnitPrereqs(Protoss_Zealot).at(1).getName());
+		}
+		TEST_METHOD(TestStorePrereqMask){
+			TechTreeStore store(PROTOSS_TREE);
+			tech_mask_t prereqs = store.getPrereqMask(Protoss_Dragoon);
+			Assert::IsTrue((prereqs & slotBit(store.findNode(Protoss_Cybernetics_Core))) != 0);
+			Assert::IsTrue((prereqs & slotBit(store.getRoot())) == 0);
+			Assert::IsTrue((prereqs & slotBit(store.findNode(Protoss_Gateway))) != 0);
+			Assert::IsTrue(store.getPrereqMask(Protoss_Nexus) == 0);
+			// obtaining the prereqs sets exactly the ancestor bits
+			Assert::IsFalse(store.isParentObtained(Protoss_Dragoon));
+			store.setPrereqsObtained(Protoss_Dragoon);
+			Assert::IsTrue(store.isParentObtained(Protoss_Dragoon));
+			Assert::IsTrue(store.isReachable(store.findNode(Protoss_Dragoon)));
+			Assert::IsTrue((store.getObtainedMask() & store.getAncestorMask(store.findNode(Protoss_Dragoon))) == store.getAncestorMask(store.findNode(Protoss_Dragoon)));
+		}
+		TEST_METHOD(TestStoreFromDefinition){
+			// a store built from the constant definition matches one built from the expanded tree
+			TechTreeStore fromDef(TERRAN_TREE);
+			TechTreeStore fromTree(getBaseTree(BWAPI::Races::Terran));
+			Assert::IsTrue(fromDef.hasSameLayout(fromTree));
+			for (tech_slot_t slot = 0; slot < fromDef.size(); slot++){
+				Assert::AreEqual(static_cast<int>(fromTree[slot]._subtreeEnd), static_cast<int>(fromDef[slot]._subtreeEnd));
+				Assert::AreEqual(static_cast<int>(fromTree[slot]._nextSibling), static_cast<int>(fromDef[slot]._nextSibling));
+			}
+		}
+		TEST_METHOD(TestBaseTreeStores){
+			// the base stores are built once, and match a store built from the definition
+			TechTreeStore fromDef(TERRAN_TREE);
+			const TechTreeStore & base = getBaseTreeStore(BWAPI::Races::Terran);
+			Assert::IsTrue(&base == &getBaseTreeStore(BWAPI::Races::Terran));
+			Assert::IsTrue(base.hasSameLayout(fromDef));
+			Assert::IsTrue(base.getUnitLeafMask() == fromDef.getUnitLeafMask());
+			for (tech_slot_t slot = 0; slot < base.size(); slot++){
+				Assert::IsTrue(base.getMoveMask(slot) == fromDef.getMoveMask(slot));
+				Assert::IsTrue(base.getAncestorMask(slot) == fromDef.getAncestorMask(slot));
+			}
+			Assert::IsTrue(getBaseTreeStore(BWAPI::Races::Unknown).isEmpty());
+			Assert::IsTrue(&getBaseTree(BWAPI::Races::Terran) == &getBaseTree(BWAPI::Races::Terran));
+		}
+		TEST_METHOD(TestStoreBuildingObtained){
+			TechTreeStore store(PROTOSS_TREE);
+			store.setPrereqsObtained(Protoss_Cybernetics_Core);
+			Assert::IsTrue(store.setBuildingNodeObtained(Protoss_Cybernetics_Core));
+			Assert::IsTrue(store.isObtained(store.findNode(Protoss_Dragoon)));
+			// a non-unique node removes its other copy from the tree, and undoing the move restores the same node
+			Assert::IsTrue(store.setBuildingNodeObtained(Protoss_Stargate));
+			Assert::IsTrue(store.setBuildingNodeObtained(Protoss_Stargate, false));
+			Assert::IsFalse(store.isObtained(store.findNode(Protoss_Stargate)));
+		}
+		TEST_METHOD(TestStoreRemove){
+			// test13 is modified by TestRemoveDuplicate, so build the same tree here
+			TechTreeStore store(TechTree{ Protoss_Nexus, true, { TechTree{ Protoss_Gateway, false }, TechTree{ Protoss_Gateway, false, { TechTree{ Protoss_Zealot } } } } });
+			Assert::IsTrue(store.removeNode(Protoss_Gateway, false));
+			std::vector<tech_slot_t> nodes;
+			store.findNextObtainableNodes(nodes);
+			Assert::AreEqual(1, static_cast<int>(nodes.size()));
+			Assert::AreEqual(Protoss_Zealot.getName(), store[store[nodes.at(0)]._firstChild]._unitType.getName());
+		}
+	};
+
+	TEST_CLASS(BuildMinimaxTest)
+	{
+		// counts every move sequence up to the given depth, checking that each unmake restores the exact state
+		static int checkMakeUnmake(const TechTreeStore & tree, tech_mask_t & obtained, int depth){
+			if (depth <= 0)
+				return 1;
+			tech_slot_t moves[MAX_TECH_NODES];
+			int numMoves = BuildMinimax::generateMoves(tree, obtained, 0, moves);
+			int count = 1;
+			for (int i = 0; i < numMoves; i++){
+				tech_mask_t before = obtained;
+				tech_mask_t delta = BuildMinimax::makeMove(tree, obtained, moves[i]);
+				Assert::IsTrue((obtained & slotBit(moves[i])) != 0);
+				count += checkMakeUnmake(tree, obtained, depth - 1);
+				BuildMinimax::unmakeMove(obtained, delta);
+				Assert::IsTrue(before == obtained);
+			}
+			return count;
+		}
+
+		static int countMovesOfType(const TechTreeStore & tree, tech_mask_t obtained, BWAPI::UnitType unitType){
+			tech_slot_t moves[MAX_TECH_NODES];
+			int numMoves = BuildMinimax::generateMoves(tree, obtained, 0, moves);
+			int count = 0;
+			for (int i = 0; i < numMoves; i++){
+				if (tree[moves[i]]._unitType == unitType)
+					count++;
+			}
+			return count;
+		}
+
+		// evaluation of the non-building leaf nodes of the given trees, by the same formula as evaluateTree
+		static int evaluateBaseTree(const TechTree & first, const TechTree & second){
+			std::vector<const TechTree*> firstNodes, secondNodes;
+			findNonBuildingLeafNodes(first, firstNodes);
+			findNonBuildingLeafNodes(second, secondNodes);
+			int eval = 0;
+			for (const TechTree * firstNode : firstNodes){
+				eval += 1000;
+				for (const TechTree * secondNode : secondNodes){
+					eval += CombatUtil::lookupStaticUnitScore(firstNode->_unitType);
+					eval -= CombatUtil::lookupStaticUnitScore(secondNode->_unitType);
+					eval += CombatUtil::lookupStaticAdvantage(firstNode->_unitType, secondNode->_unitType);
+				}
+			}
+			return eval;
+		}
+
+	public:
+		TEST_METHOD(TestGenerateMoves){
+			std::vector<BWAPI::UnitType> moves = BuildMinimax::generateMoves(TechTreeStore(test2));
+			Assert::AreEqual(2, static_cast<int>(moves.size()));
+			Assert::AreEqual(Protoss_Archon.getName(), moves.at(0).getName());
+			Assert::AreEqual(Protoss_Zealot.getName(), moves.at(1).getName());
+		}
+		TEST_METHOD(TestMakeUnmake){
+			TechTreeStore store(PROTOSS_TREE);
+			store.setPrereqsObtained(Protoss_Cybernetics_Core);
+			store.setBuildingNodeObtained(Protoss_Cybernetics_Core);
+			tech_mask_t obtained = store.getObtainedMask();
+			Assert::IsTrue(checkMakeUnmake(store, obtained, 4) > 1);
+			Assert::IsTrue(store.getObtainedMask() == obtained);
+		}
+		TEST_METHOD(TestNonUniqueMoves){
+			TechTreeStore store(PROTOSS_TREE);
+			store.setPrereqsObtained(Protoss_Cybernetics_Core);
+			store.setBuildingNodeObtained(Protoss_Cybernetics_Core);
+			tech_mask_t obtained = store.getObtainedMask();
+			Assert::AreEqual(1, countMovesOfType(store, obtained, Protoss_Stargate));
+
+			// once a stargate is obtained, neither copy of it can be obtained again
+			BuildMinimax::makeMove(store, obtained, store.findNode(Protoss_Stargate));
+			Assert::AreEqual(0, countMovesOfType(store, obtained, Protoss_Stargate));
+			BuildMinimax::makeMove(store, obtained, store.findNode(Protoss_Fleet_Beacon));
+			// both citadels are now reachable, but only one move is generated for them
+			Assert::AreEqual(1, countMovesOfType(store, obtained, Protoss_Citadel_of_Adun));
+		}
+		TEST_METHOD(TestIncrementalEvaluation){
+			TechTreeStore trees[BuildMinimax::PLAYER_ID_SIZE] = { TechTreeStore(PROTOSS_TREE), TechTreeStore(TERRAN_TREE) };
+			BuildMinimax::SearchContext search(BuildMinimax::getTranspositionTable());
+			std::srand(42);
+			for (int game = 0; game < 20; game++){
+				BuildMinimax::initSearchState(search, trees[BuildMinimax::SELF], trees[BuildMinimax::ENEMY]);
+
+				// play random moves for random players, undoing the last one some of the time,
+				// and check the running evaluation against a full evaluation after every step
+				std::vector<std::pair<int, tech_mask_t> > played;
+				for (int step = 0; step < 40; step++){
+					int player = std::rand() % BuildMinimax::PLAYER_ID_SIZE;
+					tech_slot_t moves[MAX_TECH_NODES];
+					int numMoves = BuildMinimax::generateMoves(trees[player], search._searchState[player], 0, moves);
+					if (numMoves > 0 && (played.empty() || std::rand() % 4 != 0)){
+						played.push_back(std::make_pair(player, BuildMinimax::makeSearchMove(search, player, moves[std::rand() % numMoves])));
+					}
+					else if (!played.empty()){
+						BuildMinimax::unmakeSearchMove(search, played.back().first, played.back().second);
+						played.pop_back();
+					}
+					int fullEval = BuildMinimax::evaluateTree(trees[BuildMinimax::SELF], search._searchState[BuildMinimax::SELF],
+						trees[BuildMinimax::ENEMY], search._searchState[BuildMinimax::ENEMY]);
+					Assert::AreEqual(fullEval, BuildMinimax::evaluateGameState(search));
+				}
+			}
+		}
+		TEST_METHOD(TestEvaluateAfterRemove){
+			CombatUtil::initStaticTables();
+			TechTree self = TechTree{ Protoss_Nexus, true, { TechTree{ Protoss_Gateway, true, { TechTree{ Protoss_Zealot, true, {} } } },
+				TechTree{ Protoss_High_Templar, true, { TechTree{ Protoss_Archon, true, {} } } } } };
+			TechTree enemy = TechTree{ Terran_Command_Center, true, { TechTree{ Terran_Barracks, true, { TechTree{ Terran_Marine, true, {} } } } } };
+			TechTreeStore selfStore(self);
+			TechTreeStore enemyStore(enemy);
+			int before = BuildMinimax::evaluateTree(selfStore, enemyStore);
+			Assert::AreEqual(evaluateBaseTree(self, enemy), before);
+
+			// removing the Archon leaves the High Templar without children, so it becomes a leaf
+			Assert::IsTrue(removeNode(Protoss_Archon, self));
+			Assert::IsTrue(selfStore.removeNode(Protoss_Archon));
+			Assert::IsTrue((selfStore.getUnitLeafMask() & slotBit(selfStore.findNode(Protoss_High_Templar))) != 0);
+			int after = BuildMinimax::evaluateTree(selfStore, enemyStore);
+			Assert::AreEqual(evaluateBaseTree(self, enemy), after);
+			Assert::AreNotEqual(before, after);
+		}
+		TEST_METHOD(TestCoalescedTechUpdates){
+			BuildMinimax::setGameTree(BuildMinimax::SELF, TechTreeStore(PROTOSS_TREE));
+			BuildMinimax::setGameTree(BuildMinimax::ENEMY, TechTreeStore(TERRAN_TREE));
+			BuildMinimax::updateTargetTechIfChanged(0);
+			Assert::IsFalse(BuildMinimax::getGameTreesChanged());
+
+			// scouting several buildings at once only marks the trees as changed
+			size_t searches = BuildMinimax::getSearchLog().size();
+			BuildMinimax::addTechType(Terran_Barracks, BuildMinimax::ENEMY);
+			BuildMinimax::addTechType(Terran_Factory, BuildMinimax::ENEMY);
+			BuildMinimax::addTechType(Terran_Starport, BuildMinimax::ENEMY);
+			Assert::IsTrue(BuildMinimax::getGameTreesChanged());
+			Assert::AreEqual(searches, BuildMinimax::getSearchLog().size());
+			Assert::IsTrue(BuildMinimax::getGameTree(BuildMinimax::ENEMY).isObtained(BuildMinimax::getGameTree(BuildMinimax::ENEMY).findNode(Terran_Starport)));
+
+			// and the next update searches once for all of them
+			Assert::IsTrue(BuildMinimax::updateTargetTechIfChanged(24));
+			Assert::IsFalse(BuildMinimax::updateTargetTechIfChanged(25));
+			Assert::AreEqual(searches + 1, BuildMinimax::getSearchLog().size());
+			Assert::AreEqual(24, BuildMinimax::getLastSearchStats()._frame);
+		}
+		TEST_METHOD(TestSearchWorkerCoalescing){
+			TechTreeStore self, enemy;
+			initTrees(self, enemy, false);
+			BuildMinimax::publishTargetTech(BWAPI::UnitTypes::None);
+
+			// requests posted before the worker picks any of them up are coalesced into one search
+			BuildSearchWorker worker(1000);
+			for (int i = 0; i < 5; i++)
+				worker.post(self, enemy);
+			worker.start();
+			for (int wait = 0; wait < 200 && worker.getSearchesRun() == 0; wait++)
+				std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			worker.stop();
+
+			Assert::AreEqual(5, static_cast<int>(worker.getRequestsPosted()));
+			Assert::AreEqual(1, static_cast<int>(worker.getSearchesRun()));
+			Assert::IsTrue(BuildMinimax::getTargetTech() != BWAPI::UnitTypes::None);
+		}
+		TEST_METHOD(TestMoveOrderingNodeCount){
+			TechTreeStore self, enemy;
+			initTrees(self, enemy);
+
+			// search the same position with and without move ordering; the score must not change, and ordering must cut more
+			int scores[2];
+			unsigned int nodes[2];
+			for (int ordered = 0; ordered < 2; ordered++){
+				BuildMinimax::SearchContext search(BuildMinimax::getTranspositionTable());
+				search._moveOrdering = (ordered == 1);
+				BuildMinimax::clearSearchHistory(search);
+				BuildMinimax::initSearchState(search, self, enemy);
+				scores[ordered] = BuildMinimax::minimaxAlphaBeta(search, 6, BuildMinimax::SELF, INT_MIN, INT_MAX).second;
+				nodes[ordered] = search._stats._nodes;
+			}
+			Assert::AreEqual(scores[0], scores[1]);
+			Logger::WriteMessage(("Nodes searched at depth 6: " + std::to_string(nodes[0]) + " in tree order, "
+				+ std::to_string(nodes[1]) + " ordered").c_str());
+			Assert::IsTrue(nodes[1] < nodes[0]);
+		}
+		TEST_METHOD(TestSearchStats){
+			TechTreeStore self, enemy;
+			initTrees(self, enemy, false);
+
+			BuildMinimax::SearchContext search(BuildMinimax::getTranspositionTable());
+			BuildMinimax::clearSearchHistory(search);
+			BuildMinimax::initSearchState(search, self, enemy);
+			BuildMinimax::minimaxAlphaBeta(search, 5, BuildMinimax::SELF, INT_MIN, INT_MAX);
+			const BuildMinimax::SearchStats & stats = search._stats;
+
+			// every node is counted at exactly one ply, and leaves are only found at the last ply or where the game ends
+			unsigned int nodesByPly = 0;
+			for (int ply = 0; ply <= BuildMinimax::MAX_DEPTH; ply++)
+				nodesByPly += stats._nodesByPly[ply];
+			Assert::AreEqual(stats._nodes, nodesByPly);
+			Assert::AreEqual(1, static_cast<int>(stats._nodesByPly[0]));
+			Assert::AreEqual(0, static_cast<int>(stats._nodesByPly[6]));
+			Assert::IsTrue(stats._leaves >= stats._nodesByPly[5] && stats._leaves < stats._nodes);
+			Assert::IsTrue(stats.getCutoffs() > 0);
+			Assert::IsTrue(stats.getEffectiveBranchingFactor() > 1.0);
+			Assert::AreEqual(6 * static_cast<int>(sizeof(search._moveBuffer[0])), static_cast<int>(stats._peakScratchBytes));
+			Assert::AreEqual(0, search._ply);
+
+			// a full call also reports its depth and time
+			BuildMinimax::minimaxNextBuildingTimed(search, self, enemy, 1000, 4);
+			Assert::AreEqual(4, search._stats._depth);
+			Assert::IsTrue(search._stats._wallTime > 0);
+			Assert::IsTrue(search._stats.toJson().find("\"nodesByPly\":[") != std::string::npos);
+		}
+		TEST_METHOD(TestIndependentContexts){
+			TechTreeStore protoss, terran;
+			initTrees(protoss, terran, false);
+
+			// each context keeps its own trees and running evaluation while another one searches
+			// (the trees have different layouts, so the second context needs a table of its own)
+			static TranspositionTable secondTable;
+			BuildMinimax::SearchContext first(BuildMinimax::getTranspositionTable());
+			BuildMinimax::SearchContext second(secondTable);
+			BuildMinimax::initSearchState(first, protoss, terran);
+			int firstScore = BuildMinimax::minimaxAlphaBeta(first, 4, BuildMinimax::SELF, INT_MIN, INT_MAX).second;
+			int firstEval = BuildMinimax::evaluateGameState(first);
+
+			BuildMinimax::initSearchState(second, terran, protoss);
+			BuildMinimax::minimaxAlphaBeta(second, 4, BuildMinimax::SELF, INT_MIN, INT_MAX);
+
+			Assert::AreEqual(firstEval, BuildMinimax::evaluateGameState(first));
+			Assert::AreEqual(firstScore, BuildMinimax::minimaxAlphaBeta(first, 4, BuildMinimax::SELF, INT_MIN, INT_MAX).second);
+		}
+		TEST_METHOD(TestParallelMatchesSerial){
+			TechTreeStore self(PROTOSS_TREE);
+			TechTreeStore enemy(TERRAN_TREE);
+			BWAPI::UnitType selfTech[] = { Protoss_Nexus, Protoss_Gateway, Protoss_Cybernetics_Core, Protoss_Stargate };
+			BWAPI::UnitType enemyTech[] = { Terran_Command_Center, Terran_Barracks, Terran_Factory, Terran_Starport };
+
+			// as both sides tech up, the split search must keep choosing the same move as the serial one
+			for (int step = 0; step < 4; step++){
+				self.setPrereqsObtained(selfTech[step]);
+				self.setBuildingNodeObtained(selfTech[step]);
+				enemy.setPrereqsObtained(enemyTech[step]);
+				enemy.setBuildingNodeObtained(enemyTech[step]);
+
+				BuildMinimax::SearchContext search(BuildMinimax::getTranspositionTable());
+				BuildMinimax::clearSearchHistory(search);
+				BuildMinimax::initSearchState(search, self, enemy);
+				move_score_pair_t serial = BuildMinimax::minimaxAlphaBeta(search, 5, BuildMinimax::SELF, INT_MIN, INT_MAX);
+
+				BuildMinimax::clearSearchHistory(search);
+				BuildMinimax::initSearchState(search, self, enemy);
+				move_score_pair_t parallel = BuildMinimax::minimaxAlphaBetaParallel(search, 5, 4);
+
+				Assert::AreEqual(static_cast<int>(serial.first), static_cast<int>(parallel.first));
+				Assert::AreEqual(serial.second, parallel.second);
+			}
+		}
+		TEST_METHOD(TestParallelScaling){
+			TechTreeStore self, enemy;
+			initTrees(self, enemy);
+
+			// time the same fixed-depth search with 1 to N threads, starting from an empty table each time
+			int maxThreads = (std::thread::hardware_concurrency() > 1) ? static_cast<int>(std::thread::hardware_concurrency()) : 1;
+			move_score_pair_t serial;
+			long long serialTime = 0;
+			for (int numThreads = 1; numThreads <= maxThreads; numThreads++){
+				BuildMinimax::SearchContext search(BuildMinimax::getTranspositionTable());
+				BuildMinimax::clearSearchHistory(search);
+				BuildMinimax::initSearchState(search, self, enemy);
+				Timer timer;
+				timer.start();
+				move_score_pair_t result = BuildMinimax::minimaxAlphaBetaParallel(search, 8, numThreads);
+				long long elapsed = timer.getElapsedMicroseconds();
+
+				if (numThreads == 1){
+					serial = result;
+					serialTime = elapsed;
+				}
+				Assert::AreEqual(static_cast<int>(serial.first), static_cast<int>(result.first));
+				Logger::WriteMessage(("Depth 8 with " + std::to_string(numThreads) + " threads: " + std::to_string(elapsed) + "us, "
+					+ std::to_string(search._stats._nodes) + " nodes, speedup "
+					+ std::to_string(static_cast<double>(serialTime) / (elapsed > 0 ? elapsed : 1))).c_str());
+			}
+		}
+	};
+
+	TEST_CLASS(BuildMCTSTest)
+	{
+		// returns the minimax score of SELF making the given move, searched to the given depth below it
+		static int scoreMove(BuildMinimax::SearchContext & search, tech_slot_t move, int depth){
+			tech_mask_t delta = BuildMinimax::makeSearchMove(search, BuildMinimax::SELF, move);
+			int score = BuildMinimax::minimaxAlphaBeta(search, depth, BuildMinimax::ENEMY, INT_MIN, INT_MAX).second;
+			BuildMinimax::unmakeSearchMove(search, BuildMinimax::SELF, delta);
+			return score;
+		}
+
+	public:
+		TEST_METHOD(TestPoolAndVisits){
+			TechTreeStore self, enemy;
+			initTrees(self, enemy);
+			BuildMinimax::SearchContext search(BuildMinimax::getTranspositionTable());
+			BuildMinimax::initSearchState(search, self, enemy);
+			// a pool too small for the whole search only stops the tree from growing
+			BuildMCTS::MCTSTree tree(64);
+			tech_slot_t move = BuildMCTS::mctsSearch(search, tree, 0, 2000, 1);
+			Assert::AreNotEqual(static_cast<int>(NULL_SLOT), static_cast<int>(move));
+			Assert::AreEqual(2000, static_cast<int>(tree._stats._iterations));
+			Assert::IsTrue(tree._stats._poolFull);
+			Assert::IsTrue(tree._stats._treeNodes <= 64);
+			int totalVisits = 0;
+			for (int i = 0; i < tree._stats._numRootMoves; i++)
+				totalVisits += tree._stats._rootVisits[i];
+			Assert::AreEqual(2000, totalVisits);
+			// every move made by a playout has been unmade
+			Assert::IsTrue(search._searchState[BuildMinimax::SELF] == self.getObtainedMask());
+			Assert::IsTrue(search._searchState[BuildMinimax::ENEMY] == enemy.getObtainedMask());
+		}
+		TEST_METHOD(TestConvergesToMinimax){
+			TechTreeStore self, enemy;
+			initTrees(self, enemy);
+			BuildMinimax::SearchContext search(BuildMinimax::getTranspositionTable());
+			BuildMinimax::clearSearchHistory(search);
+			BuildMinimax::initSearchState(search, self, enemy);
+			move_score_pair_t best = BuildMinimax::minimaxAlphaBeta(search, 2, BuildMinimax::SELF, INT_MIN, INT_MAX);
+
+			// with a horizon of two plies every playout is exact, so the most visited move must be as good as minimax's
+			static BuildMCTS::MCTSTree tree;
+			for (int numThreads = 1; numThreads <= 2; numThreads++){
+				BuildMinimax::initSearchState(search, self, enemy);
+				tech_slot_t move = BuildMCTS::mctsSearch(search, tree, 0, 20000, numThreads, 2);
+				Assert::AreEqual(best.second, scoreMove(search, move, 1));
+			}
+		}
+		TEST_METHOD(TestQualityPerMillisecond){
+			TechTreeStore self, enemy;
+			initTrees(self, enemy);
+			static BuildMCTS::MCTSTree tree;
+			BuildMinimax::SearchContext search(BuildMinimax::getTranspositionTable());
+			BuildMinimax::SearchContext reference(BuildMinimax::getTranspositionTable());
+
+			// score the move each backend chooses in the same time by a deeper search than either reaches
+			long long budgets[] = { 1000, 5000, 20000 };
+			for (long long budget : budgets){
+				BuildMinimax::clearSearchHistory(search);
+				BWAPI::UnitType minimaxMove = BuildMinimax::minimaxNextBuildingTimed(search, self, enemy, budget);
+				int minimaxDepth = search._stats._depth;
+				BWAPI::UnitType mctsMove = BuildMCTS::mctsNextBuilding(search, tree, self, enemy, budget);
+				Assert::IsTrue(mctsMove != BWAPI::UnitTypes::None);
+
+				BuildMinimax::clearSearchHistory(reference);
+				BuildMinimax::initSearchState(reference, self, enemy);
+				int minimaxScore = scoreMove(reference, self.findNode(minimaxMove, true), 5);
+				int mctsScore = scoreMove(reference, self.findNode(mctsMove, true), 5);
+				Logger::WriteMessage((std::to_string(budget) + "us: minimax depth " + std::to_string(minimaxDepth) + " scores " + std::to_string(minimaxScore)
+					+ ", MCTS " + std::to_string(tree._stats._iterations) + " playouts (" + std::to_string(tree._stats._treeNodes)
+					+ " nodes) scores " + std::to_string(mctsScore)).c_str());
+			}
+		}
+	};
+
+	TEST_CLASS(OpeningBookTest)
+	{
+	public:
+		TEST_METHOD(TestBookMatchesSearch){
+			OpeningBook::GeneratedBook book;
+			Assert::IsTrue(OpeningBook::generateBook(BWAPI::Races::Protoss, BWAPI::Races::Terran, 3, 3, book));
+			Assert::IsTrue(book._entries.size() > 1);
+			for (size_t i = 1; i < book._entries.size(); i++){
+				const OpeningBook::BookEntry & previous = book._entries[i - 1];
+				const OpeningBook::BookEntry & entry = book._entries[i];
+				Assert::IsTrue(previous._selfState < entry._selfState
+					|| (previous._selfState == entry._selfState && previous._enemyState < entry._enemyState));
+			}
+
+			// a state reached the way the game reaches it is in the book, with a move as good as the search's
+			TechTreeStore self(PROTOSS_TREE);
+			TechTreeStore enemy(TERRAN_TREE);
+			BWAPI::UnitType selfTech[] = { Protoss_Nexus, Protoss_Gateway };
+			BWAPI::UnitType enemyTech[] = { Terran_Command_Center, Terran_Barracks };
+			for (int i = 0; i < 2; i++){
+				self.setPrereqsObtained(selfTech[i]);
+				self.setBuildingNodeObtained(selfTech[i]);
+				enemy.setPrereqsObtained(enemyTech[i]);
+				enemy.setBuildingNodeObtained(enemyTech[i]);
+			}
+			OpeningBook::OpeningBookDef def = book.getDef();
+			tech_slot_t move = OpeningBook::lookupMove(def, self, enemy);
+			Assert::AreNotEqual(static_cast<int>(NULL_SLOT), static_cast<int>(move));
+
+			BuildMinimax::SearchContext search(BuildMinimax::getTranspositionTable());
+			BuildMinimax::initSearchState(search, self, enemy);
+			int bestScore = BuildMinimax::minimaxAlphaBeta(search, 3, BuildMinimax::SELF, INT_MIN, INT_MAX).second;
+			tech_mask_t delta = BuildMinimax::makeSearchMove(search, BuildMinimax::SELF, move);
+			Assert::AreEqual(bestScore, BuildMinimax::minimaxAlphaBeta(search, 2, BuildMinimax::ENEMY, INT_MIN, INT_MAX).second);
+			BuildMinimax::unmakeSearchMove(search, BuildMinimax::SELF, delta);
+
+			// states the book wasn't searched for are misses
+			enemy.removeNode(Terran_Factory, false);
+			Assert::AreEqual(static_cast<int>(NULL_SLOT), static_cast<int>(OpeningBook::lookupMove(def, self, enemy)));
+			Assert::AreEqual(static_cast<int>(NULL_SLOT), static_cast<int>(OpeningBook::lookupMove(def, enemy, self)));
+		}
+		TEST_METHOD(TestCompiledBookHit){
+			Assert::AreEqual(3, OpeningBook::NUM_OPENING_BOOKS);
+
+			// a gateway opening against a barracks opening is in the compiled Protoss versus Terran book
+			TechTreeStore self(PROTOSS_TREE);
+			TechTreeStore enemy(TERRAN_TREE);
+			BWAPI::UnitType selfTech[] = { Protoss_Nexus, Protoss_Gateway };
+			BWAPI::UnitType enemyTech[] = { Terran_Command_Center, Terran_Barracks };
+			for (int i = 0; i < 2; i++){
+				self.setPrereqsObtained(selfTech[i]);
+				self.setBuildingNodeObtained(selfTech[i]);
+				enemy.setPrereqsObtained(enemyTech[i]);
+				enemy.setBuildingNodeObtained(enemyTech[i]);
+			}
+			int depth = 0;
+			tech_slot_t move = OpeningBook::lookupMove(self, enemy, OpeningBook::DEFAULT_BOOK_DEPTH, depth);
+			Assert::AreNotEqual(static_cast<int>(NULL_SLOT), static_cast<int>(move));
+			Assert::AreEqual(OpeningBook::DEFAULT_BOOK_DEPTH, depth);
+
+			// the book move is as good as a search to the book's depth
+			BuildMinimax::SearchContext search(BuildMinimax::getTranspositionTable());
+			BuildMinimax::clearSearchHistory(search);
+			BuildMinimax::initSearchState(search, self, enemy);
+			int bestScore = BuildMinimax::minimaxAlphaBeta(search, depth, BuildMinimax::SELF, INT_MIN, INT_MAX).second;
+			tech_mask_t delta = BuildMinimax::makeSearchMove(search, BuildMinimax::SELF, move);
+			Assert::AreEqual(bestScore, BuildMinimax::minimaxAlphaBeta(search, depth - 1, BuildMinimax::ENEMY, INT_MIN, INT_MAX).second);
+			BuildMinimax::unmakeSearchMove(search, BuildMinimax::SELF, delta);
+
+			// and the timed search returns it without searching
+			BWAPI::UnitType unitType = BuildMinimax::minimaxNextBuildingTimed(search, self, enemy, BuildMinimax::DEFAULT_SEARCH_BUDGET);
+			Assert::IsTrue(search._stats._bookHit);
+			Assert::IsTrue(unitType == self[move]._unitType);
+		}
+	};
+
+	/**
+		Regenerates ProBot/Source/OpeningBookData.cpp from BWAPI's unit data. It overwrites a source file, so it only runs
+		once GENERATE_OPENING_BOOKS is set to true; rebuild the dll afterwards to compile the new books in.
+	*/
+	const bool GENERATE_OPENING_BOOKS = false;
+
+	TEST_CLASS(OpeningBookGenerator)
+	{
+	public:
+		TEST_METHOD(GenerateOpeningBookData){
+			if (!GENERATE_OPENING_BOOKS)
+				return;
+			// the data file is found relative to this one, whichever directory the tests run from
+			std::string testFile = __FILE__;
+			std::string path = testFile.substr(0, testFile.find_last_of("\\/") + 1) + "../../ProBot/Source/OpeningBookData.cpp";
+			Assert::IsTrue(OpeningBook::generateBookSource(path));
+			Logger::WriteMessage(("Wrote opening books to " + path).c_str());
+		}
+	};
+
+	TEST_CLASS(TranspositionTableTest)
+	{
+	public:
+		TEST_METHOD(TestZobristIncremental){
+			tech_mask_t first = slotBit(1) | slotBit(4);
+			tech_mask_t second = slotBit(7);
+			zobrist_key_t key = Zobrist::hashMask(BuildMinimax::SELF, first);
+			Assert::IsTrue((key ^ Zobrist::hashMask(BuildMinimax::SELF, second)) == Zobrist::hashMask(BuildMinimax::SELF, first | second));
+			Assert::IsTrue(Zobrist::hashMask(BuildMinimax::SELF, first) != Zobrist::hashMask(BuildMinimax::ENEMY, first));
+		}
+		TEST_METHOD(TestStoreProbe){
+			// the table is too large for the stack
+			static TranspositionTable table;
+			table.clear();
+			TTResult result;
+			Assert::IsFalse(table.probe(12345, result));
+			table.store(12345, -250, 3, TT_LOWER, 7);
+			Assert::IsTrue(table.probe(12345, result));
+			Assert::AreEqual(-250, result._score);
+			Assert::AreEqual(3, result._depth);
+			Assert::IsTrue(result._bound == TT_LOWER);
+			Assert::AreEqual(7, static_cast<int>(result._bestMove));
+			// a newer result for the same state replaces the old one
+			table.store(12345, 100, 2, TT_EXACT, NULL_SLOT);
+			Assert::IsTrue(table.probe(12345, result));
+			Assert::AreEqual(100, result._score);
+			Assert::AreEqual(static_cast<int>(NULL_SLOT), static_cast<int>(result._bestMove));
+			Assert::AreEqual(2, static_cast<int>(table.getHits()));
+			Assert::AreEqual(3, static_cast<int>(table.getProbes()));
+		}
+	};
+
+	TEST_CLASS(BuildQueueTest)
+	{
+	public:
+		TEST_METHOD(TestPackedItems){
+			Assert::IsTrue(sizeof(BuildItem) <= 16);
+			BuildItem unit{ Protoss_Zealot, 3, true };
+			Assert::AreEqual(static_cast<int>(Build::ItemTypes::UNIT), unit.getType());
+			Assert::IsTrue(unit.getUnit() == Protoss_Zealot);
+			Assert::IsTrue(unit.getTech() == BWAPI::TechTypes::None);
+			Assert::AreEqual(3, unit.getMultiplicity());
+			Assert::IsTrue(unit.isPersist());
+			BuildItem flag{ Flag::SCOUT_ENEMY };
+			Assert::IsTrue(flag.isFlag());
+			Assert::IsTrue(flag.getFlag() == Flag::SCOUT_ENEMY);
+			Assert::IsTrue(flag.getUnit() == BWAPI::UnitTypes::None);
+
+			// items with the same requirements share one list
+			std::vector<req_value_pair_t> requirements;
+			requirements.push_back(std::make_pair(static_cast<int>(Build::ItemRequirements::SUPPLY), 20));
+			BuildItem first{ Protoss_Gateway, 1, false, requirements };
+			BuildItem second{ Flag::INVADE, requirements };
+			Assert::IsTrue(&first.getRequirements() == &second.getRequirements());
+			Assert::AreEqual(20, first.getRequirements()[0].second);
+			Assert::IsTrue(unit.getRequirements().empty());
+		}
+		TEST_METHOD(TestPushPopFront){
+			BuildQueue queue(BuildOrders::DT_RUSH);
+			Assert::AreEqual(static_cast<int>(BuildOrders::DT_RUSH.size()), queue.size());
+			Assert::IsTrue(queue.front().getUnit() == Protoss_Probe);
+
+			// pushing in front of the first item wraps around to the end of the buffer
+			queue.popFront();
+			queue.pushFront(BuildItem{ Protoss_Pylon });
+			queue.pushFront(BuildItem{ Protoss_Pylon });
+			Assert::IsTrue(queue.at(0).getUnit() == Protoss_Pylon);
+			Assert::IsTrue(queue.at(2).getUnit() == BuildOrders::DT_RUSH[1].getUnit());
+			Assert::AreEqual(static_cast<int>(BuildOrders::DT_RUSH.size()) + 1, queue.size());
+
+			// growing the buffer keeps the order of the items
+			for (int i = 0; i < 200; i++)
+				queue.pushFront(BuildItem{ Protoss_Probe, i + 1 });
+			Assert::AreEqual(200, queue.front().getMultiplicity());
+			Assert::IsTrue(queue.at(200).getUnit() == Protoss_Pylon);
+			std::vector<BuildItem> items = queue.toVector();
+			Assert::IsTrue(items.back().getUnit() == BuildOrders::DT_RUSH.back().getUnit());
+			while (!queue.isEmpty())
+				queue.popFront();
+			queue.popFront();
+			Assert::AreEqual(0, queue.size());
+		}
+		TEST_METHOD(TestErase){
+			BuildQueue queue;
+			for (int i = 0; i < 5; i++)
+				queue.pushBack(BuildItem{ Protoss_Probe, i + 1 });
+			queue.erase(2);
+			queue.erase(0);
+			queue.erase(7);
+			Assert::AreEqual(3, queue.size());
+			Assert::AreEqual(2, queue.at(0).getMultiplicity());
+			Assert::AreEqual(4, queue.at(1).getMultiplicity());
+			Assert::AreEqual(5, queue.at(2).getMultiplicity());
+		}
+	};
+
+	TEST_CLASS(BuildPlannerTest)
+	{
+	public:
+		TEST_METHOD(TestSimulatorIncome){
+			BuildSimulator::SimState state;
+			BuildSimulator::initStartingState(state);
+			Assert::AreEqual(4 * BuildSimulator::MINERALS_PER_WORKER_FRAME, BuildSimulator::getMineralIncome(state));
+			Assert::AreEqual(0, BuildSimulator::getGasIncome(state));
+			BuildSimulator::advanceTo(state, 100);
+			Assert::AreEqual(50 * BuildSimulator::RESOURCE_SCALE + 100 * 4 * BuildSimulator::MINERALS_PER_WORKER_FRAME, state._minerals);
+		}
+		TEST_METHOD(TestSimulatorProducer){
+			BuildSimulator::SimState state;
+			BuildSimulator::initStartingState(state);
+			int gateway = BuildSimulator::getSimType(Protoss_Gateway);
+			int zealot = BuildSimulator::getSimType(Protoss_Zealot);
+			BuildSimulator::addCompleted(state, BuildSimulator::getSimType(Protoss_Pylon));
+			BuildSimulator::addCompleted(state, gateway);
+			state._minerals = 1000 * BuildSimulator::RESOURCE_SCALE;
+			// a gateway can't warp in anything without a cybernetics core for dragoons
+			Assert::AreEqual(BuildSimulator::NEVER, BuildSimulator::getEarliestStart(state, BuildSimulator::getSimType(Protoss_Dragoon)));
+			// the second zealot waits for the only gateway to finish the first
+			Assert::IsTrue(BuildSimulator::startItem(state, zealot));
+			Assert::AreEqual(0, BuildSimulator::getEarliestStart(state, BuildSimulator::getSimType(Protoss_Probe)));
+			Assert::AreEqual(BuildSimulator::getTypeData(zealot)._buildTime, BuildSimulator::getEarliestStart(state, zealot));
+			Assert::AreEqual(BuildSimulator::getTypeData(zealot)._buildTime, BuildSimulator::finishAll(state));
+			Assert::AreEqual(1, static_cast<int>(state._completed[zealot]));
+		}
+		TEST_METHOD(TestPlannerReachesGoal){
+			BuildSimulator::SimState state;
+			BuildSimulator::initStartingState(state);
+			BuildPlanner::BuildGoal goal;
+			Assert::IsTrue(goal.add(Protoss_Templar_Archives));
+			Assert::IsTrue(goal.add(Protoss_Dragoon, 4));
+			Assert::IsFalse(goal.add(Terran_Marine));
+			BuildPlanner::BuildPlan plan = BuildPlanner::planBuildOrder(state, goal, BuildPlanner::DEFAULT_PLAN_BUDGET);
+			Assert::AreNotEqual(BuildSimulator::NEVER, plan._makespan);
+			Assert::IsTrue(plan._nodes > 0);
+			// replaying the build order reaches the goal on the same frame
+			Assert::AreEqual(plan._makespan, BuildPlanner::simulateBuildOrder(state, goal, plan._buildOrder));
+			Logger::WriteMessage(("Planned makespan " + std::to_string(plan._makespan) + " after " + std::to_string(plan._nodes) + " states").c_str());
+		}
+	};
+
+	TEST_CLASS(BuildSchedulerTest)
+	{
+		BuildScheduler::Candidate makeCandidate(BWAPI::UnitType unitType, int count = 1){
+			BuildScheduler::Candidate candidate;
+			candidate._mineralCost = unitType.mineralPrice();
+			candidate._gasCost = unitType.gasPrice();
+			candidate._supplyCost = unitType.supplyRequired();
+			candidate._producer = unitType.whatBuilds().first.getID();
+			candidate._count = count;
+			candidate._ready = true;
+			candidate._ordered = false;
+			return candidate;
+		}
+		BuildScheduler::Resources makeResources(int minerals, int gas, int mineralWorkers, int gasWorkers){
+			BuildScheduler::Resources resources;
+			resources._minerals = minerals;
+			resources._gas = gas;
+			resources._supply = 200;
+			resources._mineralRate = mineralWorkers * BuildSimulator::MINERALS_PER_WORKER_FRAME;
+			resources._gasRate = gasWorkers * BuildSimulator::GAS_PER_WORKER_FRAME;
+			return resources;
+		}
+
+	public:
+		TEST_METHOD(TestParallelProducers){
+			// three zealots on two idle gateways start two at once, and the probe after them still starts
+			std::vector<BuildScheduler::Candidate> candidates;
+			candidates.push_back(makeCandidate(Protoss_Zealot, 3));
+			candidates.push_back(makeCandidate(Protoss_Probe));
+			std::map<int, int> idleProducers;
+			idleProducers[Protoss_Gateway.getID()] = 2;
+			idleProducers[Protoss_Nexus.getID()] = 1;
+			BuildScheduler::Resources resources = makeResources(1000, 0, 8, 0);
+			std::vector<int> counts = BuildScheduler::scheduleItems(candidates, resources, idleProducers);
+			Assert::AreEqual(2, counts[0]);
+			Assert::AreEqual(1, counts[1]);
+			Assert::AreEqual(0, idleProducers[Protoss_Gateway.getID()]);
+		}
+		TEST_METHOD(TestHeadReservation){
+			// the head is waiting on gas, so only minerals that it won't need by then go to later items
+			BuildScheduler::Candidate head = makeCandidate(Protoss_Zealot);
+			head._mineralCost = 125;
+			head._gasCost = 50;
+			std::vector<BuildScheduler::Candidate> candidates;
+			candidates.push_back(head);
+			candidates.push_back(makeCandidate(Protoss_Probe, 4));
+			std::map<int, int> idleProducers;
+			idleProducers[Protoss_Gateway.getID()] = 1;
+			idleProducers[Protoss_Nexus.getID()] = 4;
+			BuildScheduler::Resources resources = makeResources(200, 0, 0, 3);
+			int frame = BuildScheduler::getAffordableFrame(head._mineralCost, head._gasCost, resources);
+			Assert::IsTrue(frame > 0);
+			std::vector<int> counts = BuildScheduler::scheduleItems(candidates, resources, idleProducers);
+			Assert::AreEqual(0, counts[0]);
+			// with no mineral income, the head keeps 125 of the 200 minerals
+			int probes = (200 - 125) / Protoss_Probe.mineralPrice();
+			Assert::AreEqual(probes, counts[1]);
+
+			// spending what was left doesn't move the head's affordable frame
+			resources._minerals -= probes * Protoss_Probe.mineralPrice();
+			Assert::AreEqual(frame, BuildScheduler::getAffordableFrame(head._mineralCost, head._gasCost, resources));
+
+			// a resource with no income can't be waited for, so it's never affordable
+			Assert::AreEqual(BuildSimulator::NEVER, BuildScheduler::getAffordableFrame(0, 50, makeResources(0, 0, 8, 0)));
+		}
+		TEST_METHOD(TestOrderedItems){
+			// a flag isn't passed while an item before it waits, and nothing passes a flag that isn't ready
+			BuildScheduler::Candidate flag;
+			flag._mineralCost = 0;
+			flag._gasCost = 0;
+			flag._supplyCost = 0;
+			flag._producer = BuildScheduler::NO_PRODUCER;
+			flag._count = 1;
+			flag._ready = true;
+			flag._ordered = true;
+			BuildScheduler::Candidate blocked = makeCandidate(Protoss_Gateway);
+			blocked._ready = false;
+			std::vector<BuildScheduler::Candidate> candidates;
+			candidates.push_back(blocked);
+			candidates.push_back(flag);
+			candidates.push_back(makeCandidate(Protoss_Probe));
+			std::map<int, int> idleProducers;
+			idleProducers[Protoss_Nexus.getID()] = 1;
+			BuildScheduler::Resources resources = makeResources(1000, 0, 8, 0);
+			std::vector<int> counts = BuildScheduler::scheduleItems(candidates, resources, idleProducers);
+			Assert::AreEqual(0, counts[1]);
+			Assert::AreEqual(0, counts[2]);
+
+			candidates[0]._ready = true;
+			idleProducers[Protoss_Probe.getID()] = 1;
+			counts = BuildScheduler::scheduleItems(candidates, resources, idleProducers);
+			Assert::AreEqual(1, counts[0]);
+			Assert::AreEqual(1, counts[1]);
+			Assert::AreEqual(1, counts[2]);
+
+			candidates[1]._ready = false;
+			idleProducers[Protoss_Probe.getID()] = 1;
+			idleProducers[Protoss_Nexus.getID()] = 1;
+			counts = BuildScheduler::scheduleItems(candidates, resources, idleProducers);
+			Assert::AreEqual(1, counts[0]);
+			Assert::AreEqual(0, counts[2]);
+		}
+	};
+
+	TEST_CLASS(IncomeForecastTest)
+	{
+	public:
+		TEST_METHOD(TestFitsObservedIncome){
+			IncomeForecast forecast;
+			Assert::AreEqual(BuildSimulator::MINERALS_PER_WORKER_FRAME, forecast.getRatePerWorker(IncomeForecast::MINERALS));
+			// ten workers that each gather 40 thousandths of a mineral a frame, observed every 6 frames
+			int gathered = 0;
+			for (int frame = 0; frame <= 24 * 120; frame += 6){
+				forecast.observe(frame, gathered / BuildSimulator::RESOURCE_SCALE, 0, 10, 0);
+				gathered += 10 * 40 * 6;
+			}
+			int rate = forecast.getRatePerWorker(IncomeForecast::MINERALS);
+			Assert::IsTrue(rate >= 38 && rate <= 42);
+			Assert::AreEqual(10 * rate, forecast.getRate(IncomeForecast::MINERALS));
+			// gas has no workers, so it's never afforded, while minerals are afforded once enough is gathered
+			Assert::AreEqual(0, forecast.getRate(IncomeForecast::GAS));
+			Assert::AreEqual(BuildSimulator::NEVER, forecast.getFramesToAfford(0, 0, 0, 25));
+			int frames = forecast.getFramesToAfford(50, 0, 150, 0);
+			Assert::IsTrue(frames > 0);
+			Assert::IsTrue(50 + static_cast<long long>(forecast.getRate(IncomeForecast::MINERALS)) * frames / BuildSimulator::RESOURCE_SCALE >= 150);
+			Assert::IsTrue(50 + static_cast<long long>(forecast.getRate(IncomeForecast::MINERALS)) * (frames - 1) / BuildSimulator::RESOURCE_SCALE < 150);
+			Assert::AreEqual(0, forecast.getFramesToAfford(150, 0, 150, 0));
+		}
+	};
+
+	TEST_CLASS(BuildOrderScriptTest)
+	{
+		void assertSameItems(const std::vector<BuildItem> & expected, const std::vector<BuildItem> & actual){
+			Assert::AreEqual(expected.size(), actual.size());
+			for (size_t i = 0; i < expected.size(); i++){
+				Assert::AreEqual(expected[i].isFlag(), actual[i].isFlag());
+				Assert::AreEqual(expected[i].getType(), actual[i].getType());
+				Assert::IsTrue(expected[i].getUnit() == actual[i].getUnit());
+				Assert::IsTrue(expected[i].getTech() == actual[i].getTech());
+				Assert::IsTrue(expected[i].getUpgrade() == actual[i].getUpgrade());
+				Assert::IsTrue(expected[i].getFlag() == actual[i].getFlag());
+				Assert::AreEqual(expected[i].getMultiplicity(), actual[i].getMultiplicity());
+				Assert::AreEqual(expected[i].getLevel(), actual[i].getLevel());
+				Assert::AreEqual(expected[i].isPersist(), actual[i].isPersist());
+				Assert::AreEqual(expected[i].isOrdered(), actual[i].isOrdered());
+				Assert::IsTrue(expected[i].getRequirements() == actual[i].getRequirements());
+			}
+		}
+		void writeFile(const std::string & path, const std::string & content){
+			std::ofstream file(path.c_str(), std::ios::binary);
+			file << content;
+		}
+
+	public:
+		TEST_METHOD(TestRoundTrip){
+			std::vector<req_value_pair_t> requirements;
+			requirements.push_back(std::make_pair(static_cast<int>(Build::ItemRequirements::SUPPLY), 40));
+			requirements.push_back(std::make_pair(Build::MY_UNIT_COUNT_ID + Protoss_Gateway.getID(), 2));
+			requirements.push_back(std::make_pair(Build::ENEMY_UNIT_COUNT_ID + Terran_Marine.getID(), 1));
+			BuildItem ordered{ Protoss_Stargate, 2, true, requirements };
+			ordered.setOrdered(true);
+			std::vector<BuildItem> custom = make_vector<BuildItem>()
+				<< ordered
+				<< BuildItem{ BWAPI::TechTypes::Psionic_Storm }
+				<< BuildItem{ Leg_Enhancements, 2 }
+				<< BuildItem{ Flag::INVADE, requirements };
+
+			const std::string path = "build_order_script_test.txt";
+			std::string script = BuildOrderScript::formatBuildOrder("DT_RUSH", BuildOrders::DT_RUSH)
+				+ BuildOrderScript::formatBuildOrder("CUSTOM", custom) + BuildOrderScript::formatBuildOrder("DEBUG_EMPTY", BuildOrders::DEBUG_EMPTY);
+			writeFile(path, script);
+			std::string error;
+			BuildOrderScript::BuildOrderLibrary library;
+			Assert::IsTrue(library.load(path, error));
+			Assert::IsTrue(library.isMapped());
+			Assert::AreEqual(3, library.size());
+			BuildOrderScript::LoadedBuildOrder loaded;
+			Assert::IsTrue(library.findBuildOrder("DT_RUSH", loaded));
+			assertSameItems(BuildOrders::DT_RUSH, loaded.toVector());
+			Assert::IsTrue(library.findBuildOrder("CUSTOM", loaded));
+			assertSameItems(custom, loaded.toVector());
+			Assert::IsTrue(library.findBuildOrder("DEBUG_EMPTY", loaded));
+			Assert::AreEqual(0, loaded._size);
+			Assert::IsFalse(library.findBuildOrder("BASIC_DRAGOON", loaded));
+
+			// the cache is reused while the script is unchanged, and recompiled once it changes
+			unsigned long long hash = library.getContentHash();
+			Assert::IsTrue(library.load(path, error));
+			Assert::IsTrue(hash == library.getContentHash());
+			writeFile(path, script + BuildOrderScript::formatBuildOrder("BASIC_DRAGOON", BuildOrders::BASIC_DRAGOON));
+			Assert::IsTrue(library.load(path, error));
+			Assert::IsTrue(hash != library.getContentHash());
+			Assert::IsTrue(library.findBuildOrder("BASIC_DRAGOON", loaded));
+			assertSameItems(BuildOrders::BASIC_DRAGOON, loaded.toVector());
+
+			library.clear();
+			std::remove(path.c_str());
+			std::remove((path + BuildOrderScript::CACHE_SUFFIX).c_str());
+		}
+		TEST_METHOD(TestShippedScript){
+			// the script shipped with the bot holds the same build orders as the BuildOrders constants
+			std::string testFile = __FILE__;
+			std::string shippedPath = testFile.substr(0, testFile.find_last_of("\\/") + 1) + "../../ProBot/" + BuildOrderScript::DEFAULT_SCRIPT_PATH;
+			std::ifstream shipped(shippedPath.c_str(), std::ios::binary);
+			Assert::IsTrue(shipped.is_open());
+			std::stringstream content;
+			content << shipped.rdbuf();
+			// load a copy, so that no cache is written next to the shipped script
+			const std::string path = "build_order_script_shipped.txt";
+			writeFile(path, content.str());
+			std::string error;
+			BuildOrderScript::BuildOrderLibrary library;
+			Assert::IsTrue(library.load(path, error));
+
+			std::pair<std::string, const std::vector<BuildItem> *> constants[] = {
+				std::make_pair(std::string("DEBUG_EMPTY"), &BuildOrders::DEBUG_EMPTY),
+				std::make_pair(std::string("DEBUG_ALL_IN"), &BuildOrders::DEBUG_ALL_IN),
+				std::make_pair(std::string("DT_RUSH"), &BuildOrders::DT_RUSH),
+				std::make_pair(std::string("A99GATEWAYS"), &BuildOrders::A99GATEWAYS),
+				std::make_pair(std::string("BASIC_DRAGOON"), &BuildOrders::BASIC_DRAGOON)
+			};
+			Assert::AreEqual(static_cast<int>(sizeof(constants) / sizeof(constants[0])), library.size());
+			for (auto & constant : constants){
+				BuildOrderScript::LoadedBuildOrder loaded;
+				Assert::IsTrue(library.findBuildOrder(constant.first, loaded));
+				assertSameItems(*constant.second, loaded.toVector());
+			}
+
+			library.clear();
+			std::remove(path.c_str());
+			std::remove((path + BuildOrderScript::CACHE_SUFFIX).c_str());
+		}
+		TEST_METHOD(TestScriptErrors){
+			std::vector<char> cache;
+			std::string error;
+			Assert::IsTrue(BuildOrderScript::compileScript("# comment only\n\n[EMPTY]\n", cache, error));
+			Assert::IsFalse(BuildOrderScript::compileScript("Protoss_Probe\n", cache, error));
+			Assert::IsTrue(error.find("line 1") == 0);
+			Assert::IsFalse(BuildOrderScript::compileScript("[A]\nProtoss_Probe x4\nProtoss_Prob\n", cache, error));
+			Assert::IsTrue(error.find("line 3") == 0);
+			Assert::IsFalse(BuildOrderScript::compileScript("[A]\nProtoss_Probe lvl2\n", cache, error));
+			Assert::IsFalse(BuildOrderScript::compileScript("[A]\nProtoss_Probe have:Psionic_Storm>=1\n", cache, error));
+			Assert::IsFalse(BuildOrderScript::compileScript("[A]\n[A]\n", cache, error));
+			Assert::IsTrue(error.find("line 2") == 0);
+		}
+	};
+
+	TEST_CLASS(PlacementGridTest)
+	{
+	public:
+		// a map of the given size with every tile buildable
+		PlacementGrid makeGrid(int width, int height){
+			PlacementGrid grid;
+			grid.reset(width, height);
+			for (int y = 0; y < height; y++){
+				for (int x = 0; x < width; x++)
+					grid.setBuildable(x, y, true);
+			}
+			return grid;
+		}
+
+		TEST_METHOD(TestPowerField){
+			PlacementGrid grid = makeGrid(64, 64);
+			BWAPI::TilePosition pylon(30, 30);
+			// a gateway is powered when the tile at its centre is in the field
+			BWAPI::TilePosition powered(pylon.x - Protoss_Gateway.tileWidth() / 2, pylon.y - Protoss_Gateway.tileHeight() / 2);
+			BWAPI::TilePosition unpowered(pylon.x + POWER_FIELD_WIDTH, pylon.y);
+			Assert::IsFalse(grid.hasPower(Protoss_Gateway, powered));
+			Assert::IsTrue(grid.canPlace(Protoss_Pylon, pylon));
+			grid.addPylon(1, pylon);
+			Assert::IsTrue(grid.hasPower(Protoss_Gateway, powered));
+			Assert::IsTrue(grid.canPlace(Protoss_Gateway, powered));
+			Assert::IsFalse(grid.hasPower(Protoss_Gateway, unpowered));
+			Assert::IsFalse(grid.canPlace(Protoss_Gateway, unpowered));
+			// overlapping fields are counted, so removing one pylon leaves the other's power
+			grid.addPylon(2, pylon);
+			grid.removePylon(1);
+			Assert::IsTrue(grid.hasPower(Protoss_Gateway, powered));
+			grid.removePylon(2);
+			Assert::IsFalse(grid.hasPower(Protoss_Gateway, powered));
+			// a pylon that was never added (or already removed) takes no power away
+			grid.addPylon(3, pylon);
+			grid.removePylon(2);
+			grid.removePylon(4);
+			Assert::IsTrue(grid.hasPower(Protoss_Gateway, powered));
+		}
+		TEST_METHOD(TestReservations){
+			PlacementGrid grid = makeGrid(64, 64);
+			BWAPI::TilePosition site(20, 20);
+			BWAPI::TilePosition touching(site.x + Protoss_Pylon.tileWidth(), site.y);
+			BWAPI::TilePosition clear(site.x + Protoss_Pylon.tileWidth() + BUILDING_MARGIN, site.y);
+			grid.reserve(Protoss_Pylon, site, 100);
+			Assert::AreEqual(1, grid.getNumberOfReservations());
+			Assert::IsFalse(grid.canPlace(Protoss_Pylon, site));
+			Assert::IsFalse(grid.canPlace(Protoss_Pylon, touching));
+			Assert::IsTrue(grid.canPlace(Protoss_Pylon, clear));
+			grid.expireReservations(99);
+			Assert::AreEqual(1, grid.getNumberOfReservations());
+			grid.expireReservations(100);
+			Assert::AreEqual(0, grid.getNumberOfReservations());
+			Assert::IsTrue(grid.canPlace(Protoss_Pylon, site));
+
+			// placing the building releases its reservation, and the building then blocks the site
+			grid.reserve(Protoss_Pylon, site, 100);
+			grid.addBuilding(1, Protoss_Pylon, site);
+			Assert::AreEqual(0, grid.getNumberOfReservations());
+			Assert::IsFalse(grid.canPlace(Protoss_Pylon, site));
+			// seeing the building again doesn't add it twice
+			grid.addBuilding(1, Protoss_Pylon, site);
+			grid.removeBuilding(1);
+			Assert::IsTrue(grid.canPlace(Protoss_Pylon, site));
+			// removing a building that was never added (such as one placed out of sight) leaves the grid as it was
+			grid.removeBuilding(1);
+			grid.removeBuilding(2);
+			Assert::IsTrue(grid.canPlace(Protoss_Pylon, site));
+		}
+		TEST_METHOD(TestResources){
+			PlacementGrid grid = makeGrid(64, 64);
+			BWAPI::TilePosition geyser(20, 20);
+			BWAPI::TilePosition mineral(40, 40);
+			grid.addResource(1, Resource_Vespene_Geyser, geyser);
+			grid.addResource(2, Resource_Mineral_Field, mineral);
+			Assert::IsTrue(grid.canPlace(Protoss_Assimilator, geyser));
+			Assert::IsFalse(grid.canPlace(Protoss_Assimilator, mineral));
+			Assert::IsTrue(grid.findSite(Protoss_Assimilator, BWAPI::TilePosition(0, 0)) == geyser);
+			// buildings are kept clear of resources
+			BWAPI::TilePosition nearGeyser(geyser.x + Resource_Vespene_Geyser.tileWidth() + 1, geyser.y);
+			Assert::IsFalse(grid.canPlace(Protoss_Pylon, nearGeyser));
+			BWAPI::TilePosition nearMineral(mineral.x, mineral.y - Protoss_Pylon.tileHeight() - 1);
+			Assert::IsFalse(grid.canPlace(Protoss_Pylon, nearMineral));
+			grid.removeResource(2);
+			Assert::IsTrue(grid.canPlace(Protoss_Pylon, nearMineral));
+			grid.removeResource(2);
+			Assert::IsTrue(grid.canPlace(Protoss_Pylon, nearMineral));
+
+			grid.addBuilding(1, Protoss_Assimilator, geyser);
+			Assert::IsFalse(grid.canPlace(Protoss_Assimilator, geyser));
+			Assert::IsTrue(grid.findSite(Protoss_Assimilator, geyser) == BWAPI::TilePositions::Invalid);
+			grid.removeBuilding(1);
+			Assert::IsTrue(grid.canPlace(Protoss_Assimilator, geyser));
+		}
+		TEST_METHOD(TestFindSite){
+			PlacementGrid grid = makeGrid(64, 64);
+			BWAPI::TilePosition near(30, 30);
+			BWAPI::TilePosition centred(near.x - Protoss_Pylon.tileWidth() / 2, near.y - Protoss_Pylon.tileHeight() / 2);
+			Assert::IsTrue(grid.findSite(Protoss_Pylon, near) == centred);
+
+			// with the centred site taken, the closest free site is just past the building and its margin
+			grid.addBuilding(1, Protoss_Pylon, centred);
+			BWAPI::TilePosition site = grid.findSite(Protoss_Pylon, near);
+			Assert::IsTrue(site != BWAPI::TilePositions::Invalid);
+			Assert::IsTrue(grid.canPlace(Protoss_Pylon, site));
+			int distance = std::max(std::abs(site.x - centred.x), std::abs(site.y - centred.y));
+			Assert::AreEqual(std::min(Protoss_Pylon.tileWidth(), Protoss_Pylon.tileHeight()) + BUILDING_MARGIN, distance);
+
+			// nothing can be placed on an unbuildable map
+			grid.reset(64, 64);
+			Assert::IsTrue(grid.findSite(Protoss_Pylon, near) == BWAPI::TilePositions::Invalid);
+		}
+	};
+
+	TEST_CLASS(WorkerRegistryTest)
+	{
+	public:
+		// a base with depot ID 100 and mineral patches 1 to 4, where patch 1 is the closest
+		void addBase(WorkerRegistry & registry){
+			std::vector<std::pair<int, int>> minerals;
+			for (int patch = 4; patch >= 1; patch--)
+				minerals.push_back(std::make_pair(patch, 100 + patch * 10));
+			registry.addBase(100, minerals);
+			for (int worker = 10; worker < 20; worker++)
+				registry.addWorker(worker);
+		}
+
+		TEST_METHOD(TestMineralAssignment){
+			WorkerRegistry registry;
+			addBase(registry);
+			Assert::AreEqual(110, registry.getReturnDistance(1));
+			// every patch gets a worker before any gets a second, starting with the closest
+			Assert::AreEqual(1, registry.assignMinerals(10));
+			for (int worker = 11; worker < 14; worker++)
+				registry.assignMinerals(worker);
+			for (int patch = 1; patch <= 4; patch++)
+				Assert::AreEqual(1, registry.getNumberOfWorkers(patch));
+			for (int worker = 14; worker < 20; worker++)
+				Assert::AreNotEqual(NO_UNIT_ID, registry.assignMinerals(worker));
+			Assert::AreEqual(10, registry.getNumberOfMineralWorkers());
+			// a worker that's already on a patch no busier than the alternatives stays there
+			Assert::AreEqual(registry.getResource(10), registry.assignMinerals(10));
+
+			// a patch that loses a worker is the next to get one
+			registry.removeWorker(10);
+			Assert::AreEqual(9, registry.getNumberOfMineralWorkers());
+			Assert::AreEqual(NO_UNIT_ID, registry.getResource(10));
+			registry.addWorker(20);
+			Assert::AreEqual(1, registry.assignMinerals(20));
+
+			// workers of a mined out patch are unassigned
+			std::vector<int> released = registry.removeResource(1);
+			Assert::AreEqual(3, static_cast<int>(released.size()));
+			for (int worker : released)
+				Assert::AreEqual(NO_UNIT_ID, registry.getResource(worker));
+			Assert::AreEqual(10 - static_cast<int>(released.size()), registry.getNumberOfMineralWorkers());
+		}
+		TEST_METHOD(TestSaturatedMinerals){
+			WorkerRegistry registry;
+			std::vector<std::pair<int, int>> minerals;
+			for (int patch = 1; patch <= 8; patch++)
+				minerals.push_back(std::make_pair(patch, 100 + patch * 10));
+			registry.addBase(100, minerals);
+			for (int worker = 10; worker < 34; worker++){
+				registry.addWorker(worker);
+				registry.assignMinerals(worker);
+			}
+			for (int patch = 1; patch <= 8; patch++)
+				Assert::AreEqual(MAX_MINERAL_WORKERS, registry.getNumberOfWorkers(patch));
+
+			// the 25th worker still gets a patch, and the workers past the cap are spread over the patches
+			registry.addWorker(34);
+			int extraPatch = registry.assignMinerals(34);
+			Assert::AreNotEqual(NO_UNIT_ID, extraPatch);
+			Assert::AreEqual(MAX_MINERAL_WORKERS + 1, registry.getNumberOfWorkers(extraPatch));
+			for (int worker = 35; worker < 42; worker++){
+				registry.addWorker(worker);
+				Assert::AreNotEqual(NO_UNIT_ID, registry.assignMinerals(worker));
+			}
+			Assert::AreEqual(32, registry.getNumberOfMineralWorkers());
+			for (int patch = 1; patch <= 8; patch++)
+				Assert::AreEqual(MAX_MINERAL_WORKERS + 1, registry.getNumberOfWorkers(patch));
+
+			// the busiest patch gives up a worker first
+			registry.addWorker(42);
+			extraPatch = registry.assignMinerals(42);
+			int worker = registry.takeMineralWorker();
+			Assert::AreEqual(NO_UNIT_ID, registry.getResource(worker));
+			Assert::AreEqual(MAX_MINERAL_WORKERS + 1, registry.getNumberOfWorkers(extraPatch));
+		}
+		TEST_METHOD(TestGasAndNewBase){
+			WorkerRegistry registry;
+			addBase(registry);
+			for (int worker = 10; worker < 20; worker++)
+				registry.assignMinerals(worker);
+			registry.addRefinery(50, 100, 200);
+			Assert::AreEqual(50, registry.getRefineryNeedingWorkers());
+			// the refinery is filled from the most occupied patches
+			for (int i = 0; i < GAS_SATURATION; i++){
+				int worker = registry.takeMineralWorker();
+				Assert::AreNotEqual(NO_UNIT_ID, worker);
+				Assert::AreEqual(50, registry.assignGas(worker));
+			}
+			Assert::AreEqual(NO_UNIT_ID, registry.getRefineryNeedingWorkers());
+			Assert::AreEqual(GAS_SATURATION, registry.getNumberOfGasWorkers());
+			Assert::AreEqual(10 - GAS_SATURATION, registry.getNumberOfMineralWorkers());
+			for (int patch = 1; patch <= 4; patch++)
+				Assert::IsTrue(registry.getNumberOfWorkers(patch) <= 2);
+
+			// a new base takes workers from patches with two more than its own
+			Assert::AreEqual(NO_UNIT_ID, registry.takeOversaturatedWorker());
+			std::vector<std::pair<int, int>> minerals;
+			minerals.push_back(std::make_pair(5, 100));
+			minerals.push_back(std::make_pair(6, 100));
+			registry.addBase(200, minerals);
+			int moved = 0;
+			for (int worker = registry.takeOversaturatedWorker(); worker != NO_UNIT_ID; worker = registry.takeOversaturatedWorker()){
+				Assert::AreNotEqual(NO_UNIT_ID, registry.assignMinerals(worker));
+				moved++;
+			}
+			Assert::IsTrue(moved > 0);
+			Assert::AreEqual(10 - GAS_SATURATION, registry.getNumberOfMineralWorkers());
+
+			// losing the first base unassigns the workers of its patches and its refinery
+			std::vector<int> released = registry.removeBase(100);
+			Assert::AreEqual(10 - moved, static_cast<int>(released.size()));
+			Assert::AreEqual(0, registry.getNumberOfGasWorkers());
+			Assert::AreEqual(moved, registry.getNumberOfMineralWorkers());
+			Assert::AreEqual(NO_UNIT_ID, registry.getRefineryNeedingWorkers());
+		}
+	};
+
+	TEST_CLASS(UnitTypeCounterTest)
+	{
+	public:
+		TEST_METHOD(TestMorph){
+			// two High Templar merge into an Archon: one morphs, the other is destroyed
+			UnitTypeCounter counts;
+			counts.addInProduction(1, Protoss_High_Templar);
+			counts.addInProduction(2, Protoss_High_Templar);
+			Assert::AreEqual(2, counts.getProductionCount(Protoss_High_Templar));
+			counts.addCompleted(1, Protoss_High_Templar);
+			counts.addCompleted(2, Protoss_High_Templar);
+			Assert::AreEqual(0, counts.getProductionCount(Protoss_High_Templar));
+			Assert::AreEqual(2, counts.getCompletedCount(Protoss_High_Templar));
+
+			counts.morph(1, Protoss_Archon, false);
+			counts.remove(2);
+			Assert::AreEqual(0, counts.getCompletedCount(Protoss_High_Templar));
+			Assert::AreEqual(1, counts.getProductionCount(Protoss_Archon));
+			Assert::AreEqual(0, counts.getCompletedCount(Protoss_Archon));
+			counts.addCompleted(1, Protoss_Archon);
+			Assert::AreEqual(0, counts.getProductionCount(Protoss_Archon));
+			Assert::AreEqual(1, counts.getCompletedCount(Protoss_Archon));
+
+			// completing again (as setAll does) doesn't count the unit twice, and a destroyed Archon isn't a High Templar
+			counts.addCompleted(1, Protoss_Archon);
+			Assert::AreEqual(1, counts.getCompletedCount(Protoss_Archon));
+			counts.remove(1);
+			Assert::AreEqual(0, counts.getCompletedCount(Protoss_Archon));
+			Assert::AreEqual(0, counts.getCompletedCount(Protoss_High_Templar));
+		}
+		TEST_METHOD(TestCancel){
+			// a Drone starts morphing into a building, then the morph is cancelled
+			UnitTypeCounter counts;
+			counts.addCompleted(1, Zerg_Drone);
+			counts.morph(1, Zerg_Hatchery, false);
+			Assert::AreEqual(0, counts.getCompletedCount(Zerg_Drone));
+			Assert::AreEqual(1, counts.getProductionCount(Zerg_Hatchery));
+			Assert::IsTrue(counts.isInProduction(1));
+			counts.morph(1, Zerg_Drone, true);
+			Assert::AreEqual(1, counts.getCompletedCount(Zerg_Drone));
+			Assert::AreEqual(0, counts.getProductionCount(Zerg_Hatchery));
+
+			// a unit whose training is cancelled is destroyed before it completes
+			counts.addInProduction(2, Protoss_Zealot);
+			counts.remove(2);
+			Assert::AreEqual(0, counts.getProductionCount(Protoss_Zealot));
+			Assert::AreEqual(0, counts.getCompletedCount(Protoss_Zealot));
+		}
+		TEST_METHOD(TestDestroyInProduction){
+			UnitTypeCounter counts;
+			counts.addInProduction(1, Protoss_Gateway);
+			counts.addInProduction(2, Protoss_Gateway);
+			// creating the same unit again doesn't count it twice
+			counts.addInProduction(1, Protoss_Gateway);
+			Assert::AreEqual(2, counts.getProductionCount(Protoss_Gateway));
+			counts.remove(1);
+			Assert::AreEqual(1, counts.getProductionCount(Protoss_Gateway));
+			Assert::AreEqual(0, counts.getCompletedCount(Protoss_Gateway));
+			Assert::IsTrue(counts.getCountedType(1) == BWAPI::UnitTypes::None);
+			counts.addCompleted(2, Protoss_Gateway);
+			Assert::AreEqual(0, counts.getProductionCount(Protoss_Gateway));
+			Assert::AreEqual(1, counts.getCompletedCount(Protoss_Gateway));
+
+			// clearing the completed units keeps the ones in production
+			counts.addInProduction(3, Protoss_Gateway);
+			counts.clearCompleted();
+			Assert::AreEqual(0, counts.getCompletedCount(Protoss_Gateway));
+			Assert::AreEqual(1, counts.getProductionCount(Protoss_Gateway));
+		}
 	};
-}
\ No newline at end of file
+}
@@ -10,6 +10,16 @@ namespace ProBotTest
 	TEST_CLASS(CombatUtilTest)
 	{
 	public:
+		TEST_METHOD(TestStaticTables)
+		{
+			ProBot::CombatUtil::initStaticTables();
+			const BWAPI::UnitType types[] = { Protoss_Zealot, Protoss_Dragoon, Protoss_Observer, Terran_Marine, Terran_Wraith, Zerg_Lurker };
+			for (BWAPI::UnitType first : types){
+				Assert::AreEqual(ProBot::CombatUtil::getStaticUnitScore(first), ProBot::CombatUtil::lookupStaticUnitScore(first));
+				for (BWAPI::UnitType second : types)
+					Assert::AreEqual(ProBot::CombatUtil::evaluateStaticAdvantage(first, second), ProBot::CombatUtil::lookupStaticAdvantage(first, second));
+			}
+		}
 		/*
 		TEST_METHOD(TestEvaluation)
 		{